@@ -12,6 +12,16 @@
 //Macro for the distance that subsequent landing points should be separated by in meters.
 #define LP_SEPARATION (10.0)
 
+// Macros for ranking landing point candidates in LP_Manager.hpp
+#define LP_CANDIDATE_POOL_SIZE 16 // Maximum number of landing point candidates stored
+#define LP_CANDIDATE_MAX_AGE 10 // frames, candidates not reported for this many frames are dropped
+#define LP_SCORE_WEIGHT_AIRCRAFT_DIST 1.0 // score per meter from the aircraft
+#define LP_SCORE_WEIGHT_PLP_DIST 0.5 // score per meter from the planned landing point
+#define LP_SCORE_WEIGHT_HDG 0.2 // score per degree of heading misalignment
+#define LP_SCORE_WEIGHT_PERSISTENCE 10.0 // score per frame the landing point has been reported in
+#define LP_STANDBY_COUNT 3 // Number of best ranked candidates with reposition commands ready to send
+#define LP_STANDBY_POSITION_TOLERANCE 1E-7 // degrees, a requested landing point closer than this to a candidate uses its standby commands
+
 //Macros for the time in the states.
 #define LZE_SCAN_TIME "00:02:00:000"
 #define LP_APPROACH_TIME "00:02:00:000"
@@ -23,12 +33,18 @@
 #define ORBIT_TIMER 120.0 //sec, timer for orbiting
 #define LP_ACCEPT_TIMER 120.0 //sec, timer to accept new LPs
 #define UPD_TIMER 20.0 //sec, timer to wait for updated valid LPs
+#define MISSION_INIT_PERCEPTION_TIMEOUT "00:00:05:000" // Time to wait for the perception status before reporting it as not operational
+#define MISSION_INIT_AIRCRAFT_STATE_TIMEOUT "00:00:05:000" // Time to wait for the aircraft state before abandoning the mission start
 
 // Those settings will be commanded to the FCC
 #define DEFAULT_ORBIT_RADIUS 30.0 //m, this is to send to FCC to do orbit
 #define DEFAULT_ORBIT_VELOCITY 2.0 //knots, this is to send to the FCC  to do orbit
 #define DEFAULT_HOVER_ALTITUDE_AGL 15.0 //ft, required to send to the FCC when hovering
 #define DEFAULT_ORBIT_YAW_BEHAVIOUR Mav_Command_Orbit_Yaw_Behaviour_E::ORBIT_YAW_BEHAVIOUR_HOLD_FRONT_TANGENT_TO_CIRCLE
+#define LZ_SCAN_PATTERN Scan_Pattern_E::EXPANDING_ORBIT // Pattern flown around the PLP while scanning the LZ
+#define LZ_SCAN_SWATH_WIDTH 20.0 //m, spacing between the orbits or tracks of the LZ scan
+#define LZ_SCAN_MAX_RADIUS 90.0 //m, furthest distance from the PLP covered by the LZ scan
+#define LZ_SCAN_MAX_VELOCITY 10.0 //knots, fastest velocity the LZ scan is flown at to fit in the orbit timer
 // This is Mavlink type to be sent to FCC when conducting orbit
 #define LP_HOR_ACCEPT_TOLERANCE_DISTANCE 5.0 //meters, hor acceptance criteria to do repo
 #define DEFAULT_LAND_CRITERIA_TIME 3.0 //sec, timer to meet landing criteria
@@ -40,7 +56,16 @@
 #define DEFAULT_ACCEPTANCE_RADIUS_VERT 10.0  // Meters
 #define MAX_REPO_VEL 5.0 //knots -- This matches the FCC value
 #define MIN_REPO_VEL  1.0 //knots
-#define REPO_TRANSIT_TIME 10.0f
+#define REPO_ACCELERATION 0.5 // m/s^2, acceleration and deceleration planned for repositions
+#define REPO_VEL_UPDATE_THRESHOLD 0.5 // knots, difference from the planned velocity before the reposition velocity is updated
+#define STABILIZE_STREAMING false // Evaluate the hover criteria on every streamed aircraft state sample instead of polling
+#define STABILIZE_POLLING_RATE "00:00:00:100" // Polling rate of the aircraft state, or the largest gap allowed between streamed samples
+#define AIRCRAFT_STATE_STREAM_PERIOD "00:00:00:020" // Period between aircraft state samples while streaming
+#define TOUCHDOWN_WINDOW_SIZE 10 // samples, heights used to fit the vertical speed when predicting the touchdown
+#define TOUCHDOWN_MIN_DESCENT_RATE 0.5 // ft/s, slower descents are left to the landing height check
+#define TOUCHDOWN_MAX_RESIDUAL 0.5 // ft, RMS error of the vertical speed fit for the prediction to be trusted
+#define TOUCHDOWN_CONVERGENCE_TOLERANCE 0.25 // sec, agreement between consecutive touchdown predictions
+#define TOUCHDOWN_MAX_HORIZON 5.0 // sec, touchdowns predicted further ahead than this are not scheduled
 
 #define KTS_TO_MPS 0.514444 // Convert knots to m/s
 #define MPS_TO_KTS 1/KTS_TO_MPS // Convert m/s to knots
@@ -64,11 +89,57 @@
 // Shared memory
 #define DEFAULT_SHARED_MEMORY_NAME "asraSharedMem"
 
+// FCC emulator
+#define FCC_EMULATOR_STEP "00:00:00:010" // Integration step of the FCC emulator, 100 Hz
+#define FCC_EMULATOR_DEFAULT_VELOCITY 5.0f // m/s, horizontal velocity flown until a change of speed is commanded
+#define FCC_EMULATOR_ACCELERATION 1.0f // m/s^2, horizontal acceleration limit of the emulated aircraft
+#define FCC_EMULATOR_CLIMB_RATE 2.0f // m/s, climb rate limit of the emulated aircraft
+#define FCC_EMULATOR_DESCENT_RATE 1.0f // m/s, descent rate limit of the emulated aircraft, also used to land
+#define FCC_EMULATOR_ORBIT_GAIN 0.5f // 1/s, velocity towards the orbit radius per meter off of it
+#define FCC_EMULATOR_POSITION_TOLERANCE 0.5f // m, distance from a reposition that the emulated aircraft stops at
+#define FCC_EMULATOR_SETTLED_VELOCITY 0.05f // m/s, velocity below which the emulated aircraft is stopped
+#define FCC_EMULATOR_HEADING_VELOCITY 0.5f // m/s, velocity above which the emulated aircraft turns to its track
+
+// Perception load generator
+#define PERCEPTION_LOAD_MIN_PERIOD "00:00:00:001" // Shortest period between batches of generated landing points, higher rates send several per batch
+#define PERCEPTION_LOAD_DRAIN_TIME "00:00:01:000" // Time waited after the last generated landing point before the ones not received are counted as dropped
+
+// Metrics
+#define METRICS_MAX_COUNTERS 1024 // Counters available to each thread, enough for every port of every model type
+#define PORT_METRICS 9464 // Local port the metrics are served on in the Prometheus text format
+#define METRICS_ACCEPT_RETRY_MS 100 // Wait before accepting again after a failed accept, such as when file descriptors run out
+
+// Loop watchdog
+#define LOOP_WATCHDOG_BEATS 4096 // Runner iterations remembered between heartbeats, more iterations than this in one heartbeat are not all counted
+#define LOOP_WATCHDOG_RATE_HZ 5 // Heartbeats sent per second, limited to 1 to 10
+#define LOOP_WATCHDOG_THRESHOLD_MS 50 // Lateness or stall of the runner loop above which the GCS is alerted
+#define LOOP_WATCHDOG_MAX_QUEUES 8 // Queue depths carried by each heartbeat
+
+// Step arena
+#define STEP_ARENA_BYTES 16384 // Memory of each thread for the containers built and discarded within a step of a model
+
+// Startup
+#define DEPENDENCY_RETRY_MIN_MS 50 // Wait after the first failed attempt to connect to a dependency, doubled after each further attempt
+#define DEPENDENCY_RETRY_MAX_MS 2000 // Longest wait between attempts to connect to a dependency
+#define DEPENDENCY_POLL_PERIOD "00:00:00:100" // Period a model waiting for a dependency checks whether it has connected
+
+// Shutdown
+#define IO_THREAD_SHUTDOWN_MS 500 // Longest wait for an input thread to stop before it is reported, and detached if it can be
+#define RUDP_WAKE_TIMEOUT_MS 50 // Retransmission timeout of the packet waking an RUDP receive, sent to the local port
+
+// Network impairment
+#define NETWORK_IMPAIRMENT_REORDER_HOLD_MS 5 // Extra delay of a reordered packet, so that the packets sent after it overtake it
+#define NETWORK_IMPAIRMENT_PARETO_SHAPE 3.0 // Shape of the Pareto distributed jitter, lower values give a heavier tail
+
+// Aircraft state sources
+#define FCC_ENGAGED_BITS ((1 << 0) | (1 << 1)) // Safety status bits that are both set while the FCC is engaged and the Supervisor has control
+
 #define WPT_PREVIEW_LENGTH 3
 
 // Mavlink defines
 #define MAVLINK_CORE_HEADER_LEN 9
 #define MAVLINK_MSG_ID_STATUSTEXT_LEN 54
+#define MAVLINK_MSG_STATUSTEXT_TEXT_LEN 50 // Length of the text in each STATUSTEXT chunk, longer texts are split into chunks
 #define MAVLINK_MSG_ID_STATUSTEXT 253
 #define MAVLINK_STX 253
 #define MY_MAV_SYS_ID 1
@@ -92,11 +163,15 @@
 #define IPV4_GCS LOCALHOST
 #define IPV4_QGC_BROADCAST BROADCAST_AIRCRAFT
 #define IPV4_MAVNRC LOCALHOST
+#define IPV4_HEARTBEAT LOCALHOST
 
 #define PORT_BOSS 13333
 #define PORT_FCC 4060
 #define PORT_GCS 14550
 #define PORT_MAVNRC 24000
 #define PORT_QGC_BROADCAST 12346
+#define PORT_SUPERVISOR 23001
+#define PORT_HEARTBEAT 23002
+#define PORT_STATE_FEED 23003 // Port the aircraft state of a fleet vehicle is received on, offset by the port offset of the vehicle
 
 #endif /* CONSTANTS_HPP */
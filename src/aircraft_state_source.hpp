@@ -0,0 +1,135 @@
+/**
+ * 	\file		aircraft_state_source.hpp
+ *	\brief		Definition of the sources of the aircraft state read by the input models.
+ *	\details	This header file defines where the input models of a vehicle read the state of its aircraft
+				from, so that each vehicle of a fleet can be given the state of its own aircraft instead of
+				every vehicle reading the one shared memory of the process.
+ */
+
+#ifndef AIRCRAFT_STATE_SOURCE_HPP
+#define AIRCRAFT_STATE_SOURCE_HPP
+
+// Messages structures
+#include "message_structures/message_aircraft_state_t.hpp"
+
+// Utility functions
+#include "shared_memory.hpp"
+
+// Constants
+#include "Constants.hpp"
+
+// System Libraries
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/**
+ * 	\class		Aircraft_State_Source
+ *	\brief		Definition of a source of the aircraft state.
+ *	\details	The input models of a vehicle share a single source, which they must check is connected
+				before reading it.
+ */
+class Aircraft_State_Source {
+public:
+	virtual ~Aircraft_State_Source() = default;
+
+	/// @return	true once the source has an aircraft state that can be read.
+	[[nodiscard]] virtual bool connected() const = 0;
+
+	/// @return	Latest state of the aircraft, only valid once connected.
+	[[nodiscard]] virtual message_aircraft_state_t aircraft_state() const = 0;
+
+	/// @return	Latest safety status bits of the aircraft, only valid once connected.
+	[[nodiscard]] virtual uint32_t safety_status() const = 0;
+};
+
+/**
+ * 	\class		Shared_Memory_State_Source
+ *	\brief		Definition of the source reading the shared memory of the aircraft.
+ *	\details	There is a single shared memory per process, so there is a single source reading it, which
+				is the source used by default.
+ */
+class Shared_Memory_State_Source : public Aircraft_State_Source {
+public:
+	/// @return	Source reading the shared memory of the process, connecting to it in the background on the first call.
+	static std::shared_ptr<Aircraft_State_Source> instance() {
+		static std::shared_ptr<Aircraft_State_Source> source(new Shared_Memory_State_Source());
+		return source;
+	}
+
+	[[nodiscard]] bool connected() const override {
+		return Shared_Memory::instance().connected();
+	}
+
+	[[nodiscard]] message_aircraft_state_t aircraft_state() const override {
+		const SMS * shared = Shared_Memory::instance().model().sharedMemoryStruct;
+		return message_aircraft_state_t(
+				shared->hg1700.time,
+				shared->hg1700.lat,
+				shared->hg1700.lng,
+				shared->hg1700.mixedhgt,
+				shared->hg1700.alt,
+				shared->hg1700.hdg,
+				sqrt(pow(shared->hg1700.ve, 2) + pow(shared->hg1700.vn, 2))
+		);
+	}
+
+	[[nodiscard]] uint32_t safety_status() const override {
+		return Shared_Memory::instance().model().sharedMemoryStruct->hmu_safety.safety_status;
+	}
+
+private:
+	Shared_Memory_State_Source() {
+		Shared_Memory::instance();
+	}
+};
+
+/**
+ * 	\class		Stored_State_Source
+ *	\brief		Definition of a source holding the aircraft state given to it.
+ *	\details	The state is set by the owner of the source, such as a feed receiving the state of one
+				aircraft of a fleet or a test, and can be set from another thread than the models reading it.
+				The source connects when the state is first set.
+ */
+class Stored_State_Source : public Aircraft_State_Source {
+public:
+	/**
+	 * \brief 	Function set is used to replace the state held by the source.
+	 * \param	i_aircraft_state	message_aircraft_state_t latest state of the aircraft.
+	 * \param	i_safety_status		uint32_t latest safety status bits, with the FCC engaged by default.
+	 */
+	void set(const message_aircraft_state_t& i_aircraft_state, uint32_t i_safety_status = FCC_ENGAGED_BITS) {
+		std::lock_guard<std::mutex> lock(state_mutex);
+		stored_state = i_aircraft_state;
+		stored_safety_status = i_safety_status;
+		stored = true;
+	}
+
+	[[nodiscard]] bool connected() const override {
+		std::lock_guard<std::mutex> lock(state_mutex);
+		return stored;
+	}
+
+	[[nodiscard]] message_aircraft_state_t aircraft_state() const override {
+		std::lock_guard<std::mutex> lock(state_mutex);
+		return stored_state;
+	}
+
+	[[nodiscard]] uint32_t safety_status() const override {
+		std::lock_guard<std::mutex> lock(state_mutex);
+		return stored_safety_status;
+	}
+
+private:
+	/// Mutex protecting the state while it is set from another thread.
+	mutable std::mutex state_mutex;
+	/// Latest state of the aircraft.
+	message_aircraft_state_t stored_state;
+	/// Latest safety status bits of the aircraft.
+	uint32_t stored_safety_status = 0;
+	/// Whether the state has been set.
+	bool stored = false;
+};
+
+#endif // AIRCRAFT_STATE_SOURCE_HPP
@@ -0,0 +1,84 @@
+/**
+ * 	\file		allocation_counter.hpp
+ *	\brief		Definition of the heap allocation counter of the Supervisor.
+ *	\details	This header file defines a count of the heap allocations made by each thread, used to report
+				the allocations made by each step of the models. Counting replaces the global operator new,
+				so it is only built when SUPERVISOR_COUNT_ALLOCATIONS is defined.
+ */
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+// System Libraries
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/**
+ * 	\class		Allocation_Counter
+ *	\brief		Definition of the heap allocation counter of the Supervisor.
+ *	\details	This class counts the calls to the global operator new made by the calling thread. The count
+				is only read by the thread that made the allocations, so it is a plain thread local variable.
+				When counting is not built the count is always 0 and enabled is false, so the callers can
+				leave out their bookkeeping entirely.
+ */
+class Allocation_Counter {
+public:
+#ifdef SUPERVISOR_COUNT_ALLOCATIONS
+	/// Whether the allocations are counted.
+	static constexpr bool enabled = true;
+#else
+	/// Whether the allocations are counted.
+	static constexpr bool enabled = false;
+#endif
+
+	/// @return	Number of heap allocations made by the calling thread.
+	static uint64_t allocations() {
+		return count;
+	}
+
+	/// Function add is used to count an allocation made by the calling thread.
+	static void add() {
+		count++;
+	}
+
+private:
+	/// Number of heap allocations made by each thread.
+	inline static thread_local uint64_t count = 0;
+};
+
+#ifdef SUPERVISOR_COUNT_ALLOCATIONS
+/**
+ *	The replacement allocation functions must only be defined once in a program. Every executable of the
+ *	Supervisor is built from a single translation unit, which is the only one to include this header.
+ */
+void * operator new(std::size_t size) {
+	Allocation_Counter::add();
+	if (void * pointer = std::malloc(size != 0 ? size : 1)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void * pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void * pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void * pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void * pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+#endif // SUPERVISOR_COUNT_ALLOCATIONS
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -19,9 +19,12 @@
 #include "../message_structures/message_fcc_command_t.hpp"
 #include "../message_structures/message_boss_mission_update_t.hpp"
 #include "../message_structures/message_update_gcs_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Utility functions
 #include "../enum_string_conversion.hpp"
+#include "../velocity_profile.hpp"
+#include "../Constants.hpp"
 #include <mavNRC/geo.h>
 
 // Cadmium Simulator Headers
@@ -31,14 +34,20 @@
 // System Libraries
 #include <limits> // Used to set the time advance to infinity
 #include <cassert>
+#include <cmath>
 #include <string>
+#include <vector>
 
 /**
  *	\class		Command_Reposition
  *	\brief		Definition of the Command Reposition atomic model.
  *	\details	This class defines the Command Reposition coupled model for use in the Cadmium DEVS
 				simulation software. The model represents the behaviour of the Supervisor when
-				repositioning to a landing point.
+				repositioning to a landing point. The reposition velocity follows a trapezoidal profile
+				planned when the reposition starts, and the velocity is only updated while stabilizing when
+				the aircraft state shows the planned velocity has moved away from the commanded velocity.
+				Standby commands are kept for the best ranked landing point candidates so that switching
+				to one of them is sent in a single step, without waiting for a new aircraft state.
  *	\image		html atomic_models/command_reposition.png
  */
 template<typename TIME>
@@ -55,7 +64,9 @@ public:
 		(GET_STATE)
 		(COMMAND_VEL)
 		(COMMAND_HOVER)
+		(COMMAND_STANDBY)
 		(STABILIZING)
+		(UPDATE_VEL)
 		(LP_CRITERIA_MET)
 		(LANDING)
 		(CANCEL_HOVER)
@@ -72,6 +83,7 @@ public:
 	struct defs {
 		struct i_aircraft_state : public cadmium::in_port<message_aircraft_state_t> {};
 		struct i_hover_criteria_met : public cadmium::in_port<bool> {};
+		struct i_lp_ranking : public cadmium::in_port<message_landing_point_t> {};
 		struct i_pilot_handover : public cadmium::in_port<message_landing_point_t> {};
 		struct i_pilot_takeover : public cadmium::in_port<bool> {};
 		struct i_request_reposition : public cadmium::in_port<message_landing_point_t> {};
@@ -83,7 +95,7 @@ public:
 		struct o_request_aircraft_state : public cadmium::out_port<bool> {};
 		struct o_set_mission_monitor_status : public cadmium::out_port<uint8_t> {};
 		struct o_stabilize : public cadmium::out_port<message_hover_criteria_t> {};
-		struct o_update_boss : public cadmium::out_port<message_boss_mission_update_t> {};
+		struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 		struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
 	};
 
@@ -93,6 +105,7 @@ public:
 	 * 	Definition of the input ports for the model.
 	 * 	\param 	i_aircraft_state 		Port for receiving the current state of the aircraft.
 	 * 	\param 	i_hover_criteria_met 	Port for receiving updates on whether the previously commanded hover was achieved.
+	 * 	\param 	i_lp_ranking 			Port for receiving the landing point candidates from best to worst.
 	 * 	\param 	i_pilot_handover 		Port for receiving signal indicating control should be handed over to the pilot.
 	 * 	\param 	i_pilot_takeover 		Port for receiving signal indicating that the pilot has taken control from the supervisor.
 	 * 	\param 	i_request_reposition 	Port for receiving requests to reposition to landing points.
@@ -101,6 +114,7 @@ public:
 	using input_ports = std::tuple<
 		typename defs::i_aircraft_state,
 		typename defs::i_hover_criteria_met,
+		typename defs::i_lp_ranking,
 		typename defs::i_pilot_handover,
 		typename defs::i_pilot_takeover,
 		typename defs::i_request_reposition,
@@ -148,6 +162,9 @@ public:
 		state.current_state = States::IDLE;
 		aircraft_state = message_aircraft_state_t();
 		landing_point = message_landing_point_t();
+		commands = reposition_commands_t();
+		aircraft_state_valid = false;
+		use_standby = false;
         velocity = 0;
         mission_number = 0;
 	}
@@ -161,6 +178,9 @@ public:
 		state.current_state = initial_state;
 		aircraft_state = message_aircraft_state_t();
 		landing_point = message_landing_point_t();
+		commands = reposition_commands_t();
+		aircraft_state_valid = false;
+		use_standby = false;
         velocity = 0;
         mission_number = 0;
 	}
@@ -175,13 +195,15 @@ public:
 				state.current_state = States::COMMAND_HOVER;
 				break;
 			case States::COMMAND_HOVER:
+			case States::COMMAND_STANDBY:
+			case States::UPDATE_VEL:
 				state.current_state = States::STABILIZING;
 				break;
 			case States::LP_CRITERIA_MET:
 				state.current_state = States::LANDING;
 				break;
 			case States::CANCEL_HOVER:
-				state.current_state = States::REQUEST_STATE;
+				state.current_state = use_standby ? States::COMMAND_STANDBY : States::REQUEST_STATE;
 				break;
 			default:
 				break;
@@ -210,61 +232,66 @@ public:
             return;
 		}
 
+        if (state.current_state == States::IDLE || state.current_state == States::PILOT_CONTROL) {
+            return;
+        }
+
+        // Keep the standby commands for the best candidates up to date with the ranking and the aircraft state.
+        bool received_lp_ranking = !cadmium::get_messages<typename defs::i_lp_ranking>(mbs).empty();
+        bool received_aircraft_state = !cadmium::get_messages<typename defs::i_aircraft_state>(mbs).empty();
+        if (received_aircraft_state) {
+            aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(mbs).back();
+            aircraft_state_valid = true;
+        }
+        if (received_lp_ranking) {
+            set_standby(cadmium::get_messages<typename defs::i_lp_ranking>(mbs));
+        } else if (received_aircraft_state) {
+            refresh_standby();
+        }
+
         switch (state.current_state) {
-            case States::WAIT_REQUEST_REPOSITION: {
+            case States::WAIT_REQUEST_REPOSITION:
+            case States::COMMAND_VEL:
+            case States::COMMAND_HOVER:
+            case States::COMMAND_STANDBY: {
 				bool received_request_reposition = !cadmium::get_messages<typename defs::i_request_reposition>(mbs).empty();
 
 				if (received_request_reposition) {
-					std::vector<message_landing_point_t> new_landing_points = cadmium::get_messages<typename defs::i_request_reposition>(mbs);
+					const std::vector<message_landing_point_t>& new_landing_points = cadmium::get_messages<typename defs::i_request_reposition>(mbs);
 					// Set the landing point to reposition over to the newest input (found at the back of the vector of input LPs)
 					landing_point = new_landing_points.back();
-					state.current_state = States::REQUEST_STATE;
+					state.current_state = take_standby(landing_point) ? States::COMMAND_STANDBY : States::REQUEST_STATE;
 				}
 				break;
 			}
             case States::GET_STATE: {
-				bool received_aircraft_state = !cadmium::get_messages<typename defs::i_aircraft_state>(mbs).empty();
-
 				if (received_aircraft_state) {
-					std::vector<message_aircraft_state_t> new_aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(mbs);
-					aircraft_state = new_aircraft_state[0];
+					commands = plan_commands(landing_point);
+					velocity = commands.velocity;
 					state.current_state = States::COMMAND_VEL;
 				}
 				break;
 			}
-            case States::COMMAND_VEL: {
-				bool received_request_reposition = !cadmium::get_messages<typename defs::i_request_reposition>(mbs).empty();
-
-				if (received_request_reposition) {
-					std::vector<message_landing_point_t> new_landing_points = cadmium::get_messages<typename defs::i_request_reposition>(mbs);
-					// Set the landing point to reposition over to the newest input (found at the back of the vector of input LPs)
-					landing_point = new_landing_points.back();
-					state.current_state = States::REQUEST_STATE;
-				}
-				break;
-			}
-            case States::COMMAND_HOVER: {
-				bool received_request_reposition = !cadmium::get_messages<typename defs::i_request_reposition>(mbs).empty();
-
-				if (received_request_reposition) {
-					std::vector<message_landing_point_t> new_landing_points = cadmium::get_messages<typename defs::i_request_reposition>(mbs);
-					// Set the landing point to reposition over to the newest input (found at the back of the vector of input LPs)
-					landing_point = new_landing_points.back();
-					state.current_state = States::REQUEST_STATE;
-				}
-				break;
-			}
-            case States::STABILIZING: {
+            case States::STABILIZING:
+            case States::UPDATE_VEL: {
 				bool received_hover_criteria_met = !cadmium::get_messages<typename defs::i_hover_criteria_met>(mbs).empty();
 				bool received_request_reposition = !cadmium::get_messages<typename defs::i_request_reposition>(mbs).empty();
 
 				if (received_request_reposition) {
-					std::vector<message_landing_point_t> new_landing_points = cadmium::get_messages<typename defs::i_request_reposition>(mbs);
+					const std::vector<message_landing_point_t>& new_landing_points = cadmium::get_messages<typename defs::i_request_reposition>(mbs);
 					// Set the landing point to reposition over to the newest input (found at the back of the vector of input LPs)
 					landing_point = new_landing_points.back();
+					use_standby = take_standby(landing_point);
 					state.current_state = States::CANCEL_HOVER;
 				} else if (received_hover_criteria_met) {
 					state.current_state = States::LP_CRITERIA_MET;
+				} else if (received_aircraft_state) {
+					// Track the progress of the reposition and only command the planned velocity once it has drifted from the last command.
+					float planned_velocity = commands.profile.velocity(distance_to(landing_point));
+					if (std::fabs(planned_velocity - velocity) > REPO_VEL_UPDATE_THRESHOLD * KTS_TO_MPS) {
+						velocity = planned_velocity;
+						state.current_state = States::UPDATE_VEL;
+					}
 				}
 				break;
 			}
@@ -272,9 +299,10 @@ public:
 				bool received_request_reposition = !cadmium::get_messages<typename defs::i_request_reposition>(mbs).empty();
 
 				if (received_request_reposition) {
-					std::vector<message_landing_point_t> new_landing_points = cadmium::get_messages<typename defs::i_request_reposition>(mbs);
+					const std::vector<message_landing_point_t>& new_landing_points = cadmium::get_messages<typename defs::i_request_reposition>(mbs);
 					// Set the landing point to reposition over to the newest input (found at the back of the vector of input LPs)
 					landing_point = new_landing_points.back();
+					use_standby = take_standby(landing_point);
 					state.current_state = States::CANCEL_HOVER;
 				}
 				break;
@@ -297,61 +325,32 @@ public:
 			case States::REQUEST_STATE:
 				cadmium::get_messages<typename defs::o_request_aircraft_state>(bags).emplace_back(true);
 				break;
-			case States::COMMAND_VEL: {
-				float distance, altitude;
-				get_distance_to_point_global_wgs84(aircraft_state.lat, aircraft_state.lon,
-												   aircraft_state.alt_MSL * FT_TO_METERS, landing_point.lat,
-												   landing_point.lon, landing_point.alt * METERS_TO_FT, &distance,
-												   &altitude);
-				velocity = distance / REPO_TRANSIT_TIME;
-
-				if (velocity > MAX_REPO_VEL * KTS_TO_MPS) {
-					velocity = MAX_REPO_VEL * KTS_TO_MPS;
-				} else if (velocity < MIN_REPO_VEL * KTS_TO_MPS) {
-					velocity = MIN_REPO_VEL * KTS_TO_MPS;
-				}
-
+			case States::COMMAND_VEL:
+				cadmium::get_messages<typename defs::o_fcc_command_velocity>(bags).push_back(commands.fcc_command_velocity);
+				break;
+			case States::UPDATE_VEL: {
 				message_fcc_command_t mfc = message_fcc_command_t();
 				mfc.change_velocity(velocity, aircraft_state.gps_time);
 				cadmium::get_messages<typename defs::o_fcc_command_velocity>(bags).push_back(mfc);
 				break;
 			}
+			case States::COMMAND_STANDBY:
+				// The standby commands are ready, so the velocity is sent together with the hover.
+				cadmium::get_messages<typename defs::o_fcc_command_velocity>(bags).push_back(commands.fcc_command_velocity);
+				[[fallthrough]];
 			case States::COMMAND_HOVER: {
 				cadmium::get_messages<typename defs::o_set_mission_monitor_status>(bags)
 						.emplace_back(0);
 
 				// Send a hover criteria message
-				cadmium::get_messages<typename defs::o_stabilize>(bags).emplace_back(
-								landing_point.lat,
-								landing_point.lon,
-								landing_point.alt,
-								landing_point.hdg,
-								DEFAULT_LAND_CRITERIA_HOR_DIST,
-								DEFAULT_LAND_CRITERIA_VERT_DIST,
-								DEFAULT_LAND_CRITERIA_VEL,
-								DEFAULT_LAND_CRITERIA_HDG,
-								DEFAULT_LAND_CRITERIA_TIME,
-								-1,
-								0,
-								0
-						);
+				cadmium::get_messages<typename defs::o_stabilize>(bags).push_back(commands.hover_criteria);
 
 				// Update the boss displays landing point location
-				cadmium::get_messages<typename defs::o_update_boss>(bags).emplace_back(
-								landing_point.id,
-								landing_point.lat,
-								landing_point.lon,
-								mission_number,
-								landing_point.missionItemNo,
-								landing_point.alt * FT_TO_METERS,
-								landing_point.hdg,
-								velocity * MPS_TO_KTS,
-								"LP REP"
-						);
+				cadmium::get_messages<typename defs::o_update_boss>(bags).push_back(commands.boss_update);
 
 				// Update the ground control computer
 				cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-								"Repositioning to LP!",
+								GCS_Text_E::REPOSITIONING_TO_LP,
 								Mav_Severities_E::MAV_SEVERITY_ALERT
 						);
 				break;
@@ -385,6 +384,8 @@ public:
 			case States::REQUEST_STATE:
 			case States::COMMAND_VEL:
 			case States::COMMAND_HOVER:
+			case States::COMMAND_STANDBY:
+			case States::UPDATE_VEL:
 			case States::LP_CRITERIA_MET:
 			case States::CANCEL_HOVER:
 				next_internal = TIME(TA_ZERO);
@@ -405,22 +406,153 @@ public:
 	}
 
 private:
+	/**
+	 *	\struct	reposition_commands_t
+	 * 	\brief 	Definition of the commands sent to reposition to a landing point.
+	 * 	\param 	landing_point			Landing point being repositioned to.
+	 *	\param	profile					Velocity profile planned from the aircraft state.
+	 *	\param	velocity				Planned velocity at the current position of the aircraft in m/s.
+	 *	\param	fcc_command_velocity	Command for the FCC to change to the planned velocity.
+	 *	\param	hover_criteria			Criteria for hovering over the landing point.
+	 *	\param	boss_update				Update for the BOSS display of the landing point.
+	 */
+	struct reposition_commands_t {
+		message_landing_point_t landing_point;
+		Velocity_Profile profile;
+		float velocity;
+		message_fcc_command_t fcc_command_velocity;
+		message_hover_criteria_t hover_criteria;
+		shared_message_t<message_boss_mission_update_t> boss_update;
+	};
+
 	/// Variable for storing the current landing points being repositioned to.
 	message_landing_point_t landing_point;
 	/// Variable for storing aircraft state when scheduling Reposition velocities.
 	message_aircraft_state_t aircraft_state;
-	/// Variable for storing the reposition velocity.
-    mutable float velocity;
+	/// Variable for storing whether an aircraft state has been received since the mission started.
+	bool aircraft_state_valid;
+	/// Variable for storing the commands for the current reposition.
+	reposition_commands_t commands;
+	/// Variable for storing the commands ready to reposition to the best ranked landing point candidates.
+	std::vector<reposition_commands_t> standby;
+	/// Variable for storing whether the standby commands are sent after the hover is cancelled.
+	bool use_standby;
+	/// Variable for storing the last reposition velocity commanded in m/s.
+    float velocity;
     /// Variable for storing the number of the mission for updating BOSS.
     int mission_number;
 
     /// Function for resetting private variables.
     void reset_state() {
         aircraft_state = message_aircraft_state_t();
+        aircraft_state_valid = false;
         landing_point = message_landing_point_t();
+        commands = reposition_commands_t();
+        standby.clear();
+        use_standby = false;
         velocity = 0;
         mission_number = 0;
     }
+
+	/// Function for calculating the horizontal distance in meters from the aircraft to a landing point.
+	float distance_to(const message_landing_point_t& lp) const {
+		float distance, altitude;
+		// Both the aircraft and landing point altitudes are given in ft.
+		get_distance_to_point_global_wgs84(aircraft_state.lat, aircraft_state.lon,
+										   aircraft_state.alt_MSL * FT_TO_METERS, lp.lat,
+										   lp.lon, lp.alt * FT_TO_METERS, &distance,
+										   &altitude);
+		return distance;
+	}
+
+	/// Function for planning the commands to reposition to a landing point from the current aircraft state.
+	reposition_commands_t plan_commands(const message_landing_point_t& lp) const {
+		reposition_commands_t planned;
+		float distance = distance_to(lp);
+		planned.landing_point = lp;
+		planned.profile = Velocity_Profile(
+				distance,
+				aircraft_state.vel_Kts * KTS_TO_MPS,
+				MIN_REPO_VEL * KTS_TO_MPS,
+				MAX_REPO_VEL * KTS_TO_MPS,
+				REPO_ACCELERATION
+		);
+		planned.velocity = planned.profile.velocity(distance);
+		planned.fcc_command_velocity = message_fcc_command_t();
+		planned.fcc_command_velocity.change_velocity(planned.velocity, aircraft_state.gps_time);
+		set_landing_point_commands(planned);
+		return planned;
+	}
+
+	/// Function for filling in the hover criteria and BOSS update of a set of commands from its landing point.
+	void set_landing_point_commands(reposition_commands_t& planned) const {
+		const message_landing_point_t& lp = planned.landing_point;
+		planned.hover_criteria = message_hover_criteria_t(
+				lp.lat,
+				lp.lon,
+				lp.alt,
+				lp.hdg,
+				DEFAULT_LAND_CRITERIA_HOR_DIST,
+				DEFAULT_LAND_CRITERIA_VERT_DIST,
+				DEFAULT_LAND_CRITERIA_VEL,
+				DEFAULT_LAND_CRITERIA_HDG,
+				DEFAULT_LAND_CRITERIA_TIME,
+				-1,
+				0,
+				0
+		);
+		planned.boss_update = message_boss_mission_update_t(
+				lp.id,
+				lp.lat,
+				lp.lon,
+				mission_number,
+				lp.missionItemNo,
+				lp.alt * FT_TO_METERS,
+				lp.hdg,
+				planned.profile.peak() * MPS_TO_KTS,
+				"LP REP"
+		);
+	}
+
+	/// Function for replacing the standby commands with commands for the best ranked landing point candidates.
+	void set_standby(const std::vector<message_landing_point_t>& ranking) {
+		standby.clear();
+		for (size_t i = 0; i < ranking.size() && i < LP_STANDBY_COUNT; i++) {
+			standby.push_back(plan_commands(ranking[i]));
+		}
+	}
+
+	/// Function for planning the standby commands again from the latest aircraft state.
+	void refresh_standby() {
+		for (reposition_commands_t& standby_commands : standby) {
+			standby_commands = plan_commands(standby_commands.landing_point);
+		}
+	}
+
+	/**
+	 *	\brief 		Function take_standby is used to switch to the standby commands for a landing point.
+	 *	\details	The landing point matches a candidate if it is at the same position. The velocity commands
+	 * 				are kept, and the hover criteria and BOSS update are filled in from the requested landing
+	 * 				point since its altitude and numbering are set when it is chosen.
+	 * 	\param		lp	message_landing_point_t landing point requested.
+	 * 	\return		true if standby commands were found for the landing point, false otherwise.
+	 */
+	bool take_standby(const message_landing_point_t& lp) {
+		if (!aircraft_state_valid) {
+			return false;
+		}
+		for (const reposition_commands_t& standby_commands : standby) {
+			if (std::fabs(standby_commands.landing_point.lat - lp.lat) < LP_STANDBY_POSITION_TOLERANCE &&
+				std::fabs(standby_commands.landing_point.lon - lp.lon) < LP_STANDBY_POSITION_TOLERANCE) {
+				commands = standby_commands;
+				commands.landing_point = lp;
+				set_landing_point_commands(commands);
+				velocity = commands.velocity;
+				return true;
+			}
+		}
+		return false;
+	}
 };
 
 #endif // COMMAND_REPOSITION_HPP
@@ -13,10 +13,15 @@
 #define HANDLE_WAYPOINT_HPP
 
 // Messages structures
+#include "../message_structures/message_boss_mission_update_t.hpp"
 #include "../message_structures/message_fcc_command_t.hpp"
+#include "../message_structures/message_waypoint_update_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Utility functions
 #include "../enum_string_conversion.hpp"
+#include "../step_arena.hpp"
+#include "../waypoint_queue.hpp"
 #include "../Constants.hpp"
 
 // Cadmium Simulator Headers
@@ -24,15 +29,22 @@
 #include <cadmium/modeling/message_bag.hpp>
 
 // System Libraries
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <memory_resource>
 #include <string>
+#include <utility>
+#include <vector>
 
 /**
  * 	\class 		Handle_Waypoint
  *	\brief		Definition of the Handle Waypoint atomic model.
  *	\details	This class defines the Handle Waypoint atomic model for use in the Cadmium DEVS
 				simulation software. The model represents the behaviour of the Supervisor when
-				a waypoint is met while on-route.
+				a waypoint is met while on-route. The model holds the active route in a waypoint
+				queue, sends the active waypoint to the FCC whenever it changes and updates the
+				BOSS waypoint preview whenever the front of the route changes.
  *	\image		html atomic_models/handle_waypoint.png
  */
 template<typename TIME>
@@ -59,8 +71,10 @@ public:
 		struct i_pilot_takeover : public cadmium::out_port<bool> {};
 		struct i_start_mission : public cadmium::out_port<int> {};
 		struct i_waypoint : public cadmium::out_port<message_fcc_command_t> {};
+		struct i_waypoint_update : public cadmium::out_port<message_waypoint_update_t> {};
 
 		struct o_fcc_waypoint_update : public cadmium::out_port<message_fcc_command_t> {};
+		struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 	};
 
 	/**
@@ -69,22 +83,26 @@ public:
 	 * 	Definition of the input ports for the model.
 	 * 	\param	i_pilot_takeover	Port for receiving signal indicating that the pilot has taken control from the supervisor.
 	 * 	\param	i_start_mission		Port for receiving signal indicating the mission has started.
-	 * 	\param	i_waypoint			Port for receiving new waypoints during the on-route phase.
+	 * 	\param	i_waypoint			Port for receiving new waypoints during the on-route phase, each becomes the active waypoint.
+	 * 	\param	i_waypoint_update	Port for receiving indexed additions, replacements and skips of the waypoints in the route.
 	 */
 	using input_ports = std::tuple<
 		typename defs::i_pilot_takeover,
 		typename defs::i_start_mission,
-		typename defs::i_waypoint
+		typename defs::i_waypoint,
+		typename defs::i_waypoint_update
 	>;
 
 	/**
 	 *	\anchor	Handle_Waypoint_output_ports
 	 * 	\par 	Output Ports
 	 * 	Definition of the output ports for the model.
-	 * 	\param	o_fcc_waypoint_update	Port for sending waypoint commands to the FCC.
+	 * 	\param	o_fcc_waypoint_update	Port for sending the active waypoint of the route to the FCC.
+	 * 	\param	o_update_boss			Port for sending the active waypoint and the waypoint preview to BOSS.
 	 */
 	using output_ports = std::tuple<
-		typename defs::o_fcc_waypoint_update
+		typename defs::o_fcc_waypoint_update,
+		typename defs::o_update_boss
 	>;
 
 	/**
@@ -101,6 +119,7 @@ public:
 	 * \brief 	Default constructor for the model.
 	 */
 	Handle_Waypoint() {
+		mission_number = 0;
 		state.current_state = States::IDLE;
 	}
 
@@ -110,6 +129,7 @@ public:
 	 * \param	initial_state	States initial state of the model.
 	 */
 	explicit Handle_Waypoint(States initial_state) {
+		mission_number = 0;
 		state.current_state = initial_state;
 	}
 
@@ -132,18 +152,33 @@ public:
 			return;
 		}
 
+		// A new mission is accepted in any state, including after a pilot takeover ended the previous one.
+		bool received_start_mission = !cadmium::get_messages<typename defs::i_start_mission>(mbs).empty();
+		if (received_start_mission) {
+			reset_state();
+			mission_number = cadmium::get_messages<typename defs::i_start_mission>(mbs).back();
+			state.current_state = States::WAIT_FOR_WAYPOINT;
+			return;
+		}
+
 		switch (state.current_state) {
-			case States::IDLE: {
-				bool received_start_mission = !cadmium::get_messages<typename defs::i_start_mission>(mbs).empty();
-				if (received_start_mission) {
-					state.current_state = States::WAIT_FOR_WAYPOINT;
+			case States::WAIT_FOR_WAYPOINT:
+			case States::UPDATE_FCC: {
+				bool route_changed = false;
+				for (const auto& waypoint : cadmium::get_messages<typename defs::i_waypoint>(mbs)) {
+					// A waypoint without an index replaces the active waypoint, as sent by the mission manager one at a time.
+					size_t index = route.size();
+					route.set(index, waypoint);
+					if (index > 0) {
+						route.reached(index - 1);
+					}
+					route_changed = true;
 				}
-			}
-				break;
-			case States::WAIT_FOR_WAYPOINT: {
-				bool received_waypoint = !cadmium::get_messages<typename defs::i_waypoint>(mbs).empty();
-				if (received_waypoint) {
-					next_waypoint = cadmium::get_messages<typename defs::i_waypoint>(mbs);
+				for (const auto& update : cadmium::get_messages<typename defs::i_waypoint_update>(mbs)) {
+					route_changed |= update_route(update);
+				}
+
+				if (route_changed && update_next_waypoints()) {
 					state.current_state = States::UPDATE_FCC;
 				}
 				break;
@@ -164,10 +199,13 @@ public:
 		typename cadmium::make_message_bags<output_ports>::type bags;
 
 		if (state.current_state == States::UPDATE_FCC) {
-            for (message_fcc_command_t & waypoint : next_waypoint) {
-                waypoint.set_supervisor_status(Control_Mode_E::MAV_COMMAND);
-            }
-			cadmium::get_messages<typename defs::o_fcc_waypoint_update>(bags) = next_waypoint;
+			// Each FCC command is applied as a reposition, so only the active waypoint is sent.
+			if (active_changed) {
+				message_fcc_command_t waypoint = active_waypoint;
+				waypoint.set_supervisor_status(Control_Mode_E::MAV_COMMAND);
+				cadmium::get_messages<typename defs::o_fcc_waypoint_update>(bags).push_back(waypoint);
+			}
+			cadmium::get_messages<typename defs::o_update_boss>(bags).push_back(boss_update());
 		}
 
 		return bags;
@@ -202,8 +240,111 @@ public:
 	}
 
 private:
-    /// Variable for storing the next waypoints for forwarding as FCC commands.
-    mutable std::vector<message_fcc_command_t> next_waypoint;
+	/// Variable for storing the active waypoint for forwarding as an FCC command.
+	message_fcc_command_t active_waypoint;
+	/// Variable for storing whether the active waypoint changed since it was last sent to the FCC.
+	bool active_changed{};
+	/// Variable for storing the preview of the waypoints after the active waypoint for BOSS.
+	std::vector<message_fcc_command_t> preview_waypoints;
+	/// Variable for storing the index and revision of the active and preview waypoints last sent to the FCC and BOSS.
+	std::vector<std::pair<size_t, unsigned long>> sent_waypoints;
+	/// Variable for storing the waypoints of the active route.
+	Waypoint_Queue route;
+	/// Index of the active waypoint in the route.
+	size_t active_index{};
+	/// Variable for storing the number of the mission for updating BOSS.
+	int mission_number;
+
+	/// Function for resetting the mission state, the containers keep their capacity for the next mission.
+	void reset_state() {
+		mission_number = 0;
+		active_changed = false;
+		preview_waypoints.clear();
+		sent_waypoints.clear();
+		route.clear();
+		active_index = 0;
+	}
+
+	/// @brief 	Function update_route is used to apply an indexed update from the mission manager to the route.
+	/// @param 	update	message_waypoint_update_t update to apply.
+	/// @return	true if the route changed, false otherwise.
+	bool update_route(const message_waypoint_update_t& update) {
+		if (update.index < 0) {
+			return false;
+		}
+		switch (static_cast<Waypoint_Update_E>(update.action)) {
+			case Waypoint_Update_E::SET:
+				return route.set(update.index, update.waypoint);
+			case Waypoint_Update_E::SKIP:
+				return route.skip(update.index);
+			case Waypoint_Update_E::REACHED:
+				return route.reached(update.index);
+			default:
+				return false;
+		}
+	}
+
+	/**
+	 *	\brief 		Function update_next_waypoints is used to read the front of the route after it changes.
+	 *	\details	BOSS is only updated when the active waypoint or one of the waypoints previewed
+	 * 				with it has changed, so waypoints added far ahead do not resend the preview. The FCC
+	 * 				is only sent the active waypoint, and only when it has changed.
+	 * 	\return		true if the FCC or BOSS need to be updated, false otherwise.
+	 */
+	bool update_next_waypoints() {
+		// The entries are only needed for this step, so they are taken from the step arena.
+		std::pmr::vector<Waypoint_Queue::entry_t> entries = route.next(WPT_PREVIEW_LENGTH + 1, Step_Arena::resource());
+
+		bool same_window = std::equal(entries.begin(), entries.end(), sent_waypoints.begin(), sent_waypoints.end(),
+			[](const Waypoint_Queue::entry_t& entry, const std::pair<size_t, unsigned long>& sent) {
+				return entry.index == sent.first && entry.revision == sent.second;
+			});
+		if (same_window) {
+			return false;
+		}
+		active_changed = !entries.empty() && (sent_waypoints.empty()
+			|| entries.front().index != sent_waypoints.front().first
+			|| entries.front().revision != sent_waypoints.front().second);
+		sent_waypoints.clear();
+		for (const auto& entry : entries) {
+			sent_waypoints.emplace_back(entry.index, entry.revision);
+		}
+
+		preview_waypoints.clear();
+		for (size_t i = 1; i < entries.size(); i++) {
+			preview_waypoints.push_back(entries[i].waypoint);
+		}
+		if (entries.empty()) {
+			active_index = 0;
+			return false;
+		}
+		active_waypoint = entries.front().waypoint;
+		active_index = entries.front().index;
+		return true;
+	}
+
+	/// @return	message_boss_mission_update_t with the active waypoint and the preview of the following waypoints.
+	[[nodiscard]] message_boss_mission_update_t boss_update() const {
+		const message_fcc_command_t& active = active_waypoint;
+		message_boss_mission_update_t update(
+				mission_number,
+				static_cast<int>(active_index),
+				active.latitude / (1E7),
+				active.longitude / (1E7),
+				active.altitude_msl,
+				std::isnan(active.param4) ? 0.0f : active.param4,
+				active.param1,
+				DEFAULT_ACCEPTANCE_RADIUS_HORZ,
+				DEFAULT_ACCEPTANCE_RADIUS_VERT,
+				"WAYPOINT"
+		);
+		update.previewLength = static_cast<int>(preview_waypoints.size());
+		for (size_t i = 0; i < preview_waypoints.size(); i++) {
+			update.latNext[i] = preview_waypoints[i].latitude / (1E7);
+			update.lonNext[i] = preview_waypoints[i].longitude / (1E7);
+		}
+		return update;
+	}
 };
 
 #endif // HANDLE_WAYPOINT_HPP
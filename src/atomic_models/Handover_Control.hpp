@@ -117,7 +117,7 @@ public:
 	 */
 	Handover_Control() {
 		state.current_state = States::IDLE;
-		hover_location = message_landing_point_t();
+		reset_state();
 	}
 
 	/**
@@ -127,7 +127,7 @@ public:
 	 */
 	explicit Handover_Control(States initial_state) {
 		state.current_state = initial_state;
-		hover_location = message_landing_point_t();
+		reset_state();
 	}
 
 	/// Internal transitions of the model
@@ -158,6 +158,7 @@ public:
 
         bool received_start_mission = !cadmium::get_messages<typename defs::i_start_mission>(mbs).empty();
         if (received_start_mission) {
+            reset_state();
             state.current_state = States::WAIT_PILOT_HANDOVER;
             return;
         }
@@ -268,6 +269,10 @@ private:
 	/// Variable for storing the location at which the helicopter should hover at.
 	message_landing_point_t hover_location;
 
+	/// Function for resetting private variables.
+	void reset_state() {
+		hover_location = message_landing_point_t();
+	}
 };
 
 #endif // HANDOVER_CTRL_HPP
@@ -19,12 +19,17 @@
 #include "../message_structures/message_boss_mission_update_t.hpp"
 #include "../message_structures/message_update_gcs_t.hpp"
 #include "../message_structures/message_fcc_command_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Utility functions
 #include "../enum_string_conversion.hpp"
 #include "../time_conversion.hpp"
+#include "../timer_wheel.hpp"
+#include "../cold_storage.hpp"
 #include <mavNRC/geo.h>
 #include "../Constants.hpp"
+#include "../lp_candidate_pool.hpp"
+#include "../scan_pattern.hpp"
 
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
@@ -32,8 +37,11 @@
 
 // System Libraries
 #include <limits> // Used to set the time advance to infinity
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <string>
+#include <vector>
 
 /**
  * 	\class		LP_Manager
@@ -85,10 +93,11 @@ public:
 		struct o_fcc_command_orbit : public cadmium::out_port<message_fcc_command_t> {};
 		struct o_lp_expired : public cadmium::out_port<message_landing_point_t> {};
 		struct o_lp_new : public cadmium::out_port<message_landing_point_t> {};
+		struct o_lp_ranking : public cadmium::out_port<message_landing_point_t> {};
 		struct o_pilot_handover : public cadmium::out_port<message_landing_point_t> {};
 		struct o_request_aircraft_state : public cadmium::out_port<bool> {};
 		struct o_set_mission_monitor_status : public cadmium::out_port<uint8_t> {};
-		struct o_update_boss : public cadmium::out_port<message_boss_mission_update_t> {};
+		struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 		struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
 	};
 
@@ -118,9 +127,10 @@ public:
 	 *	\anchor	LP_Manager_output_ports
 	 * 	\par 	Output Ports
 	 * 	Defintion of the output ports for the model.
-	 * 	\param	o_fcc_command_orbit				Port for sending orbit commands to the FCC.
+	 * 	\param	o_fcc_command_orbit				Port for sending the LZ scan commands and their velocity to the FCC.
 	 * 	\param	o_lp_expired					Port for sending notifcation that the LP accept timer has expired.
 	 * 	\param	o_lp_new						Port for sending new valid landing points.
+	 * 	\param	o_lp_ranking					Port for sending the landing point candidates from best to worst when a new landing point is chosen.
 	 * 	\param	o_pilot_handover				Port for requesting that control be handed over to the pilot.
 	 * 	\param	o_request_aircraft_state 		Port for requesting the current aircraft state.
 	 * 	\param	o_set_mission_monitor_status 	Port for telling the mission monitor to stop monitoring mission progress.
@@ -131,6 +141,7 @@ public:
 		typename defs::o_fcc_command_orbit,
 		typename defs::o_lp_expired,
 		typename defs::o_lp_new,
+		typename defs::o_lp_ranking,
 		typename defs::o_pilot_handover,
 		typename defs::o_request_aircraft_state,
 		typename defs::o_set_mission_monitor_status,
@@ -152,15 +163,16 @@ public:
 	 * \brief 	Default constructor for the model.
 	 */
 	LP_Manager() {
-        first_waypoint_number = -1;
+        cold->first_waypoint_number = -1;
 		state.current_state = States::IDLE;
-		lp_accept_time_prev = seconds_to_time<TIME>(LP_ACCEPT_TIMER);
-		orbit_time = seconds_to_time<TIME>(ORBIT_TIMER);
+		cold->lp_accept_time = seconds_to_time<TIME>(LP_ACCEPT_TIMER);
+		cold->orbit_time = seconds_to_time<TIME>(ORBIT_TIMER);
 		lp_count = 0;
-        mission_number = 0;
+        cold->mission_number = 0;
 		lp = message_landing_point_t();
-		plp = message_landing_point_t();
-		aircraft_state = message_aircraft_state_t();
+		cold->plp = message_landing_point_t();
+		cold->aircraft_state = message_aircraft_state_t();
+		scan_leg = 0;
 	}
 
 	/**
@@ -169,15 +181,16 @@ public:
 	 * \param	i_orbit_time		TIME length of the orbit timer.
 	 */
 	LP_Manager(TIME i_lp_accept_time, TIME i_orbit_time) {
-        first_waypoint_number = -1;
+        cold->first_waypoint_number = -1;
 		state.current_state = States::IDLE;
-		lp_accept_time_prev = i_lp_accept_time;
-		orbit_time = i_orbit_time;
+		cold->lp_accept_time = i_lp_accept_time;
+		cold->orbit_time = i_orbit_time;
 		lp_count = 0;
-        mission_number = 0;
+        cold->mission_number = 0;
 		lp = message_landing_point_t();
-		plp = message_landing_point_t();
+		cold->plp = message_landing_point_t();
 		new_lp_set = false;
+		scan_leg = 0;
 	}
 
 	/**
@@ -188,21 +201,34 @@ public:
 	 * \param	initial_state	States initial state of the model.
 	 */
 	LP_Manager(TIME i_lp_accept_time, TIME i_orbit_time, States initial_state) {
-        first_waypoint_number = -1;
+        cold->first_waypoint_number = -1;
 		state.current_state = initial_state;
-		lp_accept_time_prev = i_lp_accept_time;
-		orbit_time = i_orbit_time;
+		cold->lp_accept_time = i_lp_accept_time;
+		cold->orbit_time = i_orbit_time;
 		lp_count = 0;
-        mission_number = 0;
+        cold->mission_number = 0;
 		lp = message_landing_point_t();
-		plp = message_landing_point_t();
+		cold->plp = message_landing_point_t();
 		new_lp_set = false;
+		scan_leg = 0;
+
+		// The timers of the states started in are running from the start.
+		if (initial_state == States::LZE_SCAN) {
+			timers.arm("orbit", cold->orbit_time);
+		} else if (initial_state == States::LP_APPROACH) {
+			timers.arm("lp_accept", cold->lp_accept_time);
+		}
 	}
 
 	/// Internal transitions of the model
 	void internal_transition() {
+		timers.advance(time_advance());
+
 		switch (state.current_state) {
 			case States::START_LZE_SCAN:
+				timers.arm("orbit", cold->orbit_time);
+				scan_leg = 0;
+				arm_scan_leg();
 				state.current_state = States::LZE_SCAN;
 				break;
 			case States::REQUEST_STATE_LP:
@@ -212,7 +238,13 @@ public:
 				state.current_state = States::GET_STATE_PLP;
 				break;
 			case States::LZE_SCAN:
-				state.current_state = States::HANDOVER_CONTROL;
+				if (timers.expired("orbit")) {
+					state.current_state = States::HANDOVER_CONTROL;
+				} else if (timers.expired("scan_leg")) {
+					// The next leg of the scan pattern was sent in the output.
+					scan_leg++;
+					arm_scan_leg();
+				}
 				break;
 			case States::NOTIFY_LP:
 				state.current_state = States::LP_APPROACH;
@@ -228,6 +260,8 @@ public:
 
 	/// External transitions of the model
 	void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		timers.advance(e);
+
 		//If we get any messages on the pilot takeover port in any state (apart from HANDOVER_CONTROL), immediately transition into the pilot in control state.
         bool received_pilot_takeover = !cadmium::get_messages<typename defs::i_pilot_takeover>(mbs).empty();
 		if (received_pilot_takeover && state.current_state != States::HANDOVER_CONTROL) {
@@ -238,13 +272,11 @@ public:
         bool received_start_mission = !cadmium::get_messages<typename defs::i_start_mission>(mbs).empty();
         if (received_start_mission) {
             reset_state();
-            mission_number = cadmium::get_messages<typename defs::i_start_mission>(mbs).back();
+            cold->mission_number = cadmium::get_messages<typename defs::i_start_mission>(mbs).back();
             state.current_state = States::WAIT_LP_PLP;
             return;
         }
 
-        update_lp_accept_time(e);
-
         switch (state.current_state) {
             case States::WAIT_LP_PLP: {
                 bool received_lp = !cadmium::get_messages<typename defs::i_lp_recv>(mbs).empty();
@@ -252,15 +284,17 @@ public:
                 if (received_lp) {
                     set_lp_if_valid(&mbs);
                     if (received_plp_ach) {
-                        first_waypoint_number = lp.missionItemNo;
+                        cold->first_waypoint_number = lp.missionItemNo;
                     } else {
-                        first_waypoint_number = lp.missionItemNo + 1;
+                        cold->first_waypoint_number = lp.missionItemNo + 1;
                     }
-                    lp.missionItemNo = first_waypoint_number;
+                    lp.missionItemNo = cold->first_waypoint_number;
                     state.current_state = States::REQUEST_STATE_LP;
                 } else if (received_plp_ach) {
-                    plp = cadmium::get_messages<typename defs::i_plp_ach>(mbs)[0];
-                    first_waypoint_number = plp.missionItemNo;
+                    cold->plp = cadmium::get_messages<typename defs::i_plp_ach>(mbs)[0];
+                    cold->lp_candidates.set_plp(cold->plp);
+                    cold->scan = cold->scan_patterns.scan(cold->plp, time_to_seconds(cold->orbit_time));
+                    cold->first_waypoint_number = cold->plp.missionItemNo;
                     state.current_state = States::REQUEST_STATE_PLP;
                 }
                 break;
@@ -277,14 +311,15 @@ public:
                 bool received_aircraft_state = !cadmium::get_messages<typename defs::i_aircraft_state>(mbs).empty();
 
                 if (received_aircraft_state) {
-                    std::vector<message_aircraft_state_t> new_aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(
+                    const std::vector<message_aircraft_state_t>& new_aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(
                             mbs);
-                    aircraft_state = new_aircraft_state[0];
-                    if (aircraft_state.alt_AGL < DEFAULT_HOVER_ALTITUDE_AGL) {
-                        plp.alt = (aircraft_state.alt_MSL - aircraft_state.alt_AGL + DEFAULT_HOVER_ALTITUDE_AGL);
+                    cold->aircraft_state = new_aircraft_state[0];
+                    if (cold->aircraft_state.alt_AGL < DEFAULT_HOVER_ALTITUDE_AGL) {
+                        cold->plp.alt = (cold->aircraft_state.alt_MSL - cold->aircraft_state.alt_AGL + DEFAULT_HOVER_ALTITUDE_AGL);
                     } else {
-                        plp.alt = aircraft_state.alt_MSL;
+                        cold->plp.alt = cold->aircraft_state.alt_MSL;
                     }
+                    cold->lp_candidates.set_aircraft_state(cold->aircraft_state);
                     state.current_state = States::START_LZE_SCAN;
                 }
                 break;
@@ -293,14 +328,15 @@ public:
                 bool received_aircraft_state = !cadmium::get_messages<typename defs::i_aircraft_state>(mbs).empty();
 
                 if (received_aircraft_state) {
-                    std::vector<message_aircraft_state_t> new_aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(
+                    const std::vector<message_aircraft_state_t>& new_aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(
                             mbs);
-                    aircraft_state = new_aircraft_state[0];
-                    if (aircraft_state.alt_AGL < DEFAULT_HOVER_ALTITUDE_AGL) {
-                        lp.alt = (aircraft_state.alt_MSL - aircraft_state.alt_AGL + DEFAULT_HOVER_ALTITUDE_AGL);
+                    cold->aircraft_state = new_aircraft_state[0];
+                    if (cold->aircraft_state.alt_AGL < DEFAULT_HOVER_ALTITUDE_AGL) {
+                        lp.alt = (cold->aircraft_state.alt_MSL - cold->aircraft_state.alt_AGL + DEFAULT_HOVER_ALTITUDE_AGL);
                     } else {
-                        lp.alt = aircraft_state.alt_MSL;
+                        lp.alt = cold->aircraft_state.alt_MSL;
                     }
+                    cold->lp_candidates.set_aircraft_state(cold->aircraft_state);
                     state.current_state = States::NOTIFY_LP;
                 }
                 break;
@@ -319,7 +355,7 @@ public:
                     state.current_state = States::LP_ACCEPT_EXP;
                 } else if (received_lp) {
                     set_lp_if_valid(&mbs);
-                    lp.missionItemNo = first_waypoint_number;
+                    lp.missionItemNo = cold->first_waypoint_number;
                     state.current_state = States::REQUEST_STATE_LP;
                 }
                 break;
@@ -330,12 +366,11 @@ public:
 	}
 
 	/// Function used to decide precedence between internal and external transitions when both are scheduled simultaneously.
-	void confluence_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+	void confluence_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
 		//If the external input is a pilot takeover message,
 		if (cadmium::get_messages<typename defs::i_pilot_takeover>(mbs).size() >= 1) {
-			//Execute the external transition first, then the internal.
-			external_transition(TIME(), std::move(mbs));
-			internal_transition();
+			//Execute the external transition only, the internal transition has no effect once the pilot is in control.
+			external_transition(e, std::move(mbs));
 		} else {
 			internal_transition();
 			external_transition(TIME(), std::move(mbs));
@@ -348,32 +383,22 @@ public:
 
 		switch (state.current_state) {
 			case States::START_LZE_SCAN: {
-				message_fcc_command_t fcc_command = message_fcc_command_t();
-				fcc_command.orbit(
-						aircraft_state.gps_time,
-						plp.lat * (1E7),
-						plp.lon * (1E7),
-						plp.alt * FT_TO_METERS,
-						DEFAULT_ORBIT_RADIUS,
-						DEFAULT_ORBIT_VELOCITY,
-						DEFAULT_ORBIT_YAW_BEHAVIOUR
-				);
-				cadmium::get_messages<typename defs::o_fcc_command_orbit>(bags).push_back(fcc_command);
+				push_scan_commands(bags, 0);
 
 				// Update the ground control computer
 				cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-						"Starting an orbit to scan LZ",
+						GCS_Text_E::STARTING_LZ_SCAN,
 						Mav_Severities_E::MAV_SEVERITY_INFO
 				);
 
 				// Update BOSS display message
 				cadmium::get_messages<typename defs::o_update_boss>(bags).emplace_back(
-                        mission_number,
-                        plp.missionItemNo,
-                        plp.lat,
-                        plp.lon,
-                        plp.alt * FT_TO_METERS,
-                        plp.hdg,
+                        cold->mission_number,
+                        cold->plp.missionItemNo,
+                        cold->plp.lat,
+                        cold->plp.lon,
+                        cold->plp.alt * FT_TO_METERS,
+                        cold->plp.hdg,
                         0.1, // If set to 0 displays a doghouse, else displays a circle
                         DEFAULT_ACCEPTANCE_RADIUS_HORZ,
                         0,
@@ -385,27 +410,32 @@ public:
 			}
 			case States::LZE_SCAN:
 				{
+					if (scan_leg_due()) {
+						push_scan_commands(bags, scan_leg + 1);
+						break;
+					}
+
 					// Update the ground control computer
 					cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-							"Landing point not found. Hovering over PLP",
+							GCS_Text_E::LP_NOT_FOUND,
 							Mav_Severities_E::MAV_SEVERITY_ALERT
 					);
 
 					// Update BOSS display message
 					cadmium::get_messages<typename defs::o_update_boss>(bags).emplace_back(
-                            mission_number,
-                            plp.missionItemNo,
-                            plp.lat,
-                            plp.lon,
-                            plp.alt * FT_TO_METERS,
-                            plp.hdg,
+                            cold->mission_number,
+                            cold->plp.missionItemNo,
+                            cold->plp.lat,
+                            cold->plp.lon,
+                            cold->plp.alt * FT_TO_METERS,
+                            cold->plp.hdg,
                             0.1,
                             DEFAULT_ACCEPTANCE_RADIUS_HORZ,
                             0,
                             "MAN CTRL"
 					);
 
-					cadmium::get_messages<typename defs::o_pilot_handover>(bags).push_back(plp);
+					cadmium::get_messages<typename defs::o_pilot_handover>(bags).push_back(cold->plp);
 
 				}
 				break;
@@ -413,12 +443,13 @@ public:
 				{
 					if (lp_count == 0) {
 						cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-								"LP timer started",
+								GCS_Text_E::LP_TIMER_STARTED,
 								Mav_Severities_E::MAV_SEVERITY_INFO
 						);
 					}
 					if (new_lp_set) {
 						cadmium::get_messages<typename defs::o_lp_new>(bags).push_back(lp);
+						cadmium::get_messages<typename defs::o_lp_ranking>(bags) = cold->lp_candidates.ranked();
 					}
 				}
 				break;
@@ -428,7 +459,7 @@ public:
 
 					// Update the ground control computer
 					cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-							"LP accept timer expired",
+							GCS_Text_E::LP_ACCEPT_TIMER_EXPIRED,
 							Mav_Severities_E::MAV_SEVERITY_INFO
 					);
 				}
@@ -467,11 +498,11 @@ public:
 				next_internal = TIME(TA_ZERO);
 				break;
 			case States::LZE_SCAN:
-				next_internal = orbit_time;
+				next_internal = std::min(timers.remaining("orbit"), timers.remaining("scan_leg"));
 				break;
 			case States::LP_APPROACH:
 				//Schedule the amount of time that was left on the LP accept timer.
-				next_internal = lp_accept_time_prev;
+				next_internal = timers.remaining("lp_accept");
 				break;
 			default:
                 assert(false && "Unhandled state time advance.");
@@ -490,84 +521,148 @@ public:
 	}
 
 private:
-    /// Required to display the landing point doghouses.
-    int first_waypoint_number;
-    /// Variable to count the number of valid LPs that have been sent.
-    int lp_count;
-    /// Variable for storing the number of the mission for updating BOSS.
-    int mission_number;
-    /// Variable for storing the location of the current valid landing point.
-    message_landing_point_t lp;
+	/**
+	 *	\struct	cold_state_t
+	 * 	\brief 	Definition of the variables only used when a mission starts or a landing point or aircraft state is received.
+	 *	\param	first_waypoint_number	Required to display the landing point doghouses.
+	 *	\param	mission_number			Number of the mission for updating BOSS.
+	 *	\param	plp						Location of the planned landing point.
+	 *	\param	aircraft_state			Current aircraft state.
+	 *	\param	lp_accept_time			Length of the LP accept timer.
+	 *	\param	orbit_time				Length of the orbit timer.
+	 *	\param	lp_candidates			Ranked landing point candidates received from the perception system.
+	 *	\param	scan_patterns			LZ scan patterns generated for each planned landing point.
+	 *	\param	scan					Legs of the LZ scan around the current planned landing point and their velocity.
+	 */
+	struct cold_state_t {
+		int first_waypoint_number;
+		int mission_number;
+		message_landing_point_t plp;
+		message_aircraft_state_t aircraft_state;
+		TIME lp_accept_time;
+		TIME orbit_time;
+		LP_Candidate_Pool lp_candidates;
+		Scan_Pattern_Cache scan_patterns;
+		scan_pattern_t scan;
+	};
+
+	// The variables used by every transition are declared together so that they share cache lines.
+	/// Variable for tracking the LP accept ("lp_accept"), orbit ("orbit") and LZ scan leg ("scan_leg") timers.
+	Timer_Wheel<TIME> timers;
+	/// Variable to count the number of valid LPs that have been sent.
+	int lp_count;
 	/// Variable set when a new lp has been received, indicating that one should be sent.
 	bool new_lp_set;
-    /// Variable for storing the location of the planned landing point.
-    message_landing_point_t plp;
-    /// Variable for storing the current aircraft state.
-    message_aircraft_state_t aircraft_state;
-    /// Variable to store the remaining amount of time on the LP accept timer for decrementing upon new LP received.
-    TIME lp_accept_time_prev;
-	/// Variable to store the length of the orbit timer.
-    TIME orbit_time;
+	/// Variable for storing the index of the leg of the LZ scan being flown.
+	size_t scan_leg;
+	/// Variable for storing the location of the current valid landing point.
+	message_landing_point_t lp;
+	/// Variable for storing the rarely used variables out of line, see cold_state_t.
+	Cold_Storage<cold_state_t> cold;
+
+	/// Function for adding the FCC commands that fly a leg of the LZ scan, the velocity of the scan is sent ahead of the leg.
+	void push_scan_commands(typename cadmium::make_message_bags<output_ports>::type& bags, size_t index) const {
+		if (index < cold->scan.legs.size()) {
+			message_fcc_command_t fcc_command_velocity = message_fcc_command_t();
+			fcc_command_velocity.change_velocity(cold->scan.velocity * KTS_TO_MPS, cold->aircraft_state.gps_time);
+			cadmium::get_messages<typename defs::o_fcc_command_orbit>(bags).push_back(fcc_command_velocity);
+		}
+		cadmium::get_messages<typename defs::o_fcc_command_orbit>(bags).push_back(scan_command(index));
+	}
+
+	/// Function for building the FCC command that flies a leg of the LZ scan, an orbit of the PLP if there is no pattern.
+	message_fcc_command_t scan_command(size_t index) const {
+		message_fcc_command_t fcc_command = message_fcc_command_t();
+		if (index >= cold->scan.legs.size()) {
+			fcc_command.orbit(
+					cold->aircraft_state.gps_time,
+					cold->plp.lat * (1E7),
+					cold->plp.lon * (1E7),
+					cold->plp.alt * FT_TO_METERS,
+					DEFAULT_ORBIT_RADIUS,
+					DEFAULT_ORBIT_VELOCITY * KTS_TO_MPS,
+					DEFAULT_ORBIT_YAW_BEHAVIOUR
+			);
+		} else if (cold->scan.legs[index].radius > 0.0f) {
+			fcc_command.orbit(
+					cold->aircraft_state.gps_time,
+					cold->scan.legs[index].lat * (1E7),
+					cold->scan.legs[index].lon * (1E7),
+					cold->plp.alt * FT_TO_METERS,
+					cold->scan.legs[index].radius,
+					cold->scan.velocity * KTS_TO_MPS,
+					DEFAULT_ORBIT_YAW_BEHAVIOUR
+			);
+		} else {
+			fcc_command.reposition(
+					cold->aircraft_state.gps_time,
+					cold->scan.legs[index].lat * (1E7),
+					cold->scan.legs[index].lon * (1E7),
+					cold->plp.alt * FT_TO_METERS
+			);
+		}
+		return fcc_command;
+	}
+
+	/// Function for starting the timer for the current leg of the LZ scan, if there is a leg after it.
+	void arm_scan_leg() {
+		if (scan_leg + 1 >= cold->scan.legs.size()) {
+			timers.cancel("scan_leg");
+			return;
+		}
+		double leg_time = cold->scan.legs[scan_leg].length / (cold->scan.velocity * KTS_TO_MPS);
+		timers.arm("scan_leg", milliseconds_to_time<TIME>(std::llround(leg_time * 1000.0)));
+	}
+
+	/// Function for checking if the next leg of the LZ scan is due before the orbit timer expires.
+	bool scan_leg_due() const {
+		return timers.remaining("scan_leg") < timers.remaining("orbit");
+	}
 
 	/**
 	 *	\brief 		Function set_lp_if_valid is used to set the current valid landing point.
-	 *	\details	The function checks if any landing points have been received, if none have the most
-	 * 				recent is selected. If there have been multiple valid LPs, the most recent valid LP is
-	 * 				chosen. An LP is considered valid if it has a large enough separation from the previous LP.
+	 *	\details	The received landing points are added to the candidate pool as a single frame. If no landing
+	 * 				point has been chosen yet the best ranked candidate is selected, otherwise the best ranked
+	 * 				candidate is selected only if it is valid, so the current LP is kept while it is still ranked
+	 * 				first. An LP is considered valid if it has a large enough separation from the previous LP.
+	 * 				Candidates with equal scores are ranked newest first.
 	 * 	\param		mbs	Bag of messages received on the input ports received from Cadmium simulation engine.
 	 */
     void set_lp_if_valid(typename cadmium::make_message_bags<input_ports>::type * mbs) {
-        std::vector<message_landing_point_t> landing_points = cadmium::get_messages<typename defs::i_lp_recv>(*mbs);
+        cold->lp_candidates.add_frame(cadmium::get_messages<typename defs::i_lp_recv>(*mbs));
 
+        message_landing_point_t new_lp;
+        bool new_lp_valid;
         if (lp_count == 0) {
-            lp = landing_points.back(); // Pick the newest landing point for the first new LP (found at the back of the vector of inputs)
-            lp_count++;
-            lp.id = lp_count;
-			new_lp_set = true;
+            new_lp_valid = cold->lp_candidates.best(new_lp);
         } else {
-            for (message_landing_point_t new_lp : landing_points) {
-                float distance_xy;
-                float distance_z;
-                get_distance_to_point_global_wgs84(
-                        lp.lat, lp.lon, lp.alt,
-                        new_lp.lat, new_lp.lon, new_lp.alt,
-                        &distance_xy, &distance_z);
-                bool new_lp_valid = (distance_xy > LP_SEPARATION);
-                //If the landing point is far enough away from the previous landing point,
-                if (new_lp_valid) {
-                    //Set the current landing point to be the new landing point.
-                    lp = new_lp;
-                    lp_count++;
-                    lp.id = lp_count;
-					new_lp_set = true;
-                    break;
-                }
-            }
+            new_lp_valid = cold->lp_candidates.best_if_separated_from(lp, new_lp);
         }
-    }
 
-	/**
-	 *	\brief 	Function update_lp_accept_time is used to update the LP accept timer based on the current state and an elapsed time.
-	 */
-    void update_lp_accept_time(TIME e) {
-        if (state.current_state == States::REQUEST_STATE_LP ||
-            state.current_state == States::GET_STATE_LP ||
-            state.current_state == States::NOTIFY_LP ||
-            state.current_state == States::LP_APPROACH) {
-            lp_accept_time_prev = lp_accept_time_prev - e;
-            if (lp_accept_time_prev <= TIME(TA_ZERO)) {
-                lp_accept_time_prev = TIME(TA_ZERO);
+        //If a landing point was found, set the current landing point to be the new landing point.
+        if (new_lp_valid) {
+            //The LP accept timer starts when the first landing point is chosen.
+            if (lp_count == 0) {
+                timers.arm("lp_accept", cold->lp_accept_time);
             }
+            lp = new_lp;
+            lp_count++;
+            lp.id = lp_count;
+            new_lp_set = true;
         }
     }
 
     /// Function reset_state resets the private variables to a default value.
     void reset_state() {
-        lp_accept_time_prev = seconds_to_time<TIME>(LP_ACCEPT_TIMER);
-        orbit_time = seconds_to_time<TIME>(ORBIT_TIMER);
-        mission_number = 0;
+        cold->lp_accept_time = seconds_to_time<TIME>(LP_ACCEPT_TIMER);
+        cold->orbit_time = seconds_to_time<TIME>(ORBIT_TIMER);
+        cold->mission_number = 0;
         lp_count = 0;
 		new_lp_set = false;
+		cold->lp_candidates.clear();
+		cold->scan.legs.clear();
+		scan_leg = 0;
+		timers.clear();
     }
 };
 
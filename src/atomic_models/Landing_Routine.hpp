@@ -17,6 +17,7 @@
 #include "../message_structures/message_fcc_command_t.hpp"
 #include "../message_structures/message_landing_point_t.hpp"
 #include "../message_structures/message_update_gcs_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Utility functions
 #include "../enum_string_conversion.hpp"
@@ -70,7 +71,7 @@ public:
 
 		struct o_fcc_command_land : public cadmium::out_port<message_fcc_command_t> {};
 		struct o_mission_complete : public cadmium::out_port<bool> {};
-		struct o_update_boss : public cadmium::out_port<message_boss_mission_update_t> {};
+		struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 		struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
 		struct o_update_mission_item : public cadmium::out_port<bool> {};
 	};
@@ -123,8 +124,7 @@ public:
 	 * \brief 	Default constructor for the model.
 	 */
 	Landing_Routine() {
-        landing_point = message_landing_point_t();
-        mission_number = 0;
+        reset_state();
         state.current_state = States::IDLE;
 	}
 
@@ -134,8 +134,7 @@ public:
 	 * \param	initial_state	States initial state of the model.
 	 */
 	explicit Landing_Routine(States initial_state) {
-        landing_point = message_landing_point_t();
-        mission_number = 0;
+        reset_state();
         state.current_state = initial_state;
 	}
 
@@ -163,6 +162,7 @@ public:
 
         bool received_start_mission = !cadmium::get_messages<typename defs::i_start_mission>(mbs).empty();
         if (received_start_mission) {
+            reset_state();
             mission_number = cadmium::get_messages<typename defs::i_start_mission>(mbs).back();
             state.current_state = States::WAIT_LAND_REQUEST;
             return;
@@ -222,7 +222,7 @@ public:
 
 				// Update the ground control computer
 				cadmium::get_messages<typename Landing_Routine::defs::o_update_gcs>(bags).emplace_back(
-						"Landing",
+						GCS_Text_E::LANDING,
 						Mav_Severities_E::MAV_SEVERITY_ALERT
 				);
 				break;
@@ -233,7 +233,7 @@ public:
 
 				// Update the ground control computer
 				cadmium::get_messages<typename Landing_Routine::defs::o_update_gcs>(bags).emplace_back(
-						"Just landed!",
+						GCS_Text_E::JUST_LANDED,
 						Mav_Severities_E::MAV_SEVERITY_INFO
 				);
 				break;
@@ -276,6 +276,12 @@ private:
     message_landing_point_t landing_point;
     /// Variable for storing the number of the mission for updating BOSS.
     int mission_number;
+
+    /// Function for resetting private variables.
+    void reset_state() {
+        landing_point = message_landing_point_t();
+        mission_number = 0;
+    }
 };
 
 #endif // LANDING_ROUTING_HPP
@@ -20,6 +20,7 @@
 // Utility functions
 #include "../enum_string_conversion.hpp"
 #include "../Constants.hpp"
+#include "../timer_wheel.hpp"
 
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
@@ -34,7 +35,9 @@
  *	\brief		Definition of the Mission Initialization atomic model.
  *	\details	This class defines the Mission Initialization atomic model for use in the Cadmium DEVS
 				simulation software. The model represents the behaviour of the Supervisor at the beginning
-				of the mission when the autonomy system is being initialized.
+				of the mission when the autonomy system is being initialized. The perception system and
+				aircraft state checks are requested together and joined in WAIT_FOR_CHECKS, each with its
+				own timeout, so the time to start the mission is bounded by the slowest check.
  *	\image		html atomic_models/mission_initialization.png
  */
 template<typename TIME>
@@ -49,10 +52,8 @@ public:
 		(MISSION_STATUS)
 		(RESUME_MISSION)
 		(CHECK_AUTONOMY)
-		(CHECK_PERCEPTION_SYSTEM)
-		(OUTPUT_PERCEPTION_STATUS)
-		(REQUEST_AIRCRAFT_STATE)
-		(CHECK_AIRCRAFT_STATE)
+		(WAIT_FOR_CHECKS)
+		(AIRCRAFT_STATE_TIMEOUT)
 		(OUTPUT_TAKEOFF_POSITION)
 		(REQUIRE_MONITORING)
 		(START_MISSION)
@@ -109,39 +110,49 @@ public:
 	>;
 
 	/**
-	 *	\anchor	Handle_Waypoint_state_type
+	 *	\anchor	Mission_Initialization_state_type
 	 *	\par	State
 	 * 	Definition of the states of the atomic model.
-	 * 	\param 	current_state 	Current state of atomic model.
+	 * 	\param 	current_state 			Current state of atomic model.
+	 * 	\param 	perception_checked 		Whether the perception status has been received or timed out.
+	 * 	\param 	aircraft_state_checked 	Whether the aircraft state has been received.
 	 */
 	struct state_type {
 		States current_state;
+		bool perception_checked;
+		bool aircraft_state_checked;
 	} state;
 
 	/**
 	 * \brief 	Default constructor for the model.
 	 */
-	Mission_Initialization() {
-		state.current_state = States::IDLE;
-        mission_data = message_start_supervisor_t();
-		perception_healthy = false;
-		aircraft_height = 0.0;
-	}
+	Mission_Initialization() : Mission_Initialization(States::IDLE) {}
 
 	/**
 	 * \brief 	Constructor for the model with initial state parameter
 	 * 			for debugging or partial execution startup.
 	 * \param	initial_state	States initial state of the model.
 	 */
-	explicit Mission_Initialization(States initial_state) {
+	explicit Mission_Initialization(States initial_state)
+		: Mission_Initialization(TIME(MISSION_INIT_PERCEPTION_TIMEOUT), TIME(MISSION_INIT_AIRCRAFT_STATE_TIMEOUT), initial_state) {}
+
+	/**
+	 * \brief 	Constructor for the model with parameters for the timeouts of the checks.
+	 * \param	i_perception_timeout		TIME to wait for the perception status before reporting the perception system as not operational.
+	 * \param	i_aircraft_state_timeout	TIME to wait for the aircraft state before abandoning the mission start.
+	 * \param	initial_state				States initial state of the model.
+	 */
+	Mission_Initialization(TIME i_perception_timeout, TIME i_aircraft_state_timeout, States initial_state = States::IDLE) {
+		perception_timeout = i_perception_timeout;
+		aircraft_state_timeout = i_aircraft_state_timeout;
+		reset_state();
 		state.current_state = initial_state;
-        mission_data = message_start_supervisor_t();
-		perception_healthy = false;
-		aircraft_height = 0.0;
 	}
 
 	/// Internal transitions of the model
 	void internal_transition() {
+		timers.advance(time_advance());
+
 		switch (state.current_state) {
 			case States::MISSION_STATUS:
 				state.current_state = mission_data.mission_started ? States::RESUME_MISSION: States::CHECK_AUTONOMY;
@@ -150,13 +161,31 @@ public:
 				state.current_state = States::IDLE;
 				break;
 			case States::CHECK_AUTONOMY:
-				state.current_state = state.current_state = mission_data.autonomy_armed ? States::CHECK_PERCEPTION_SYSTEM: States::IDLE;
+				if (mission_data.autonomy_armed) {
+					// Both checks were requested in the output, wait for them together.
+					state.perception_checked = false;
+					state.aircraft_state_checked = false;
+					perception_healthy = false;
+					timers.arm("perception", perception_timeout);
+					timers.arm("aircraft_state", aircraft_state_timeout);
+					state.current_state = States::WAIT_FOR_CHECKS;
+				} else {
+					state.current_state = States::IDLE;
+				}
 				break;
-			case States::OUTPUT_PERCEPTION_STATUS:
-				state.current_state = States::REQUEST_AIRCRAFT_STATE;
+			case States::WAIT_FOR_CHECKS:
+				if (timers.expired("aircraft_state")) {
+					timers.clear();
+					state.current_state = States::AIRCRAFT_STATE_TIMEOUT;
+				} else if (timers.expired("perception")) {
+					// A perception system that does not answer is reported the same as an unhealthy one.
+					timers.cancel("perception");
+					state.perception_checked = true;
+					join_checks();
+				}
 				break;
-			case States::REQUEST_AIRCRAFT_STATE:
-				state.current_state = States::CHECK_AIRCRAFT_STATE;
+			case States::AIRCRAFT_STATE_TIMEOUT:
+				state.current_state = States::IDLE;
 				break;
 			case States::OUTPUT_TAKEOFF_POSITION:
 				state.current_state = States::START_MISSION;
@@ -170,33 +199,36 @@ public:
 	}
 
 	/// External transitions of the model
-	void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+	void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		timers.advance(e);
+
+		// A new start supervisor restarts the initialisation in any state, abandoning the checks of the previous one.
+		bool received_start_supervisor = !cadmium::get_messages<typename defs::i_start_supervisor>(mbs).empty();
+		if (received_start_supervisor) {
+			reset_state();
+			// Get the most recent start supervisor input (found at the back of the vector of inputs)
+			mission_data = cadmium::get_messages<typename defs::i_start_supervisor>(mbs).back();
+			state.current_state = States::MISSION_STATUS;
+			return;
+		}
+
 		switch (state.current_state) {
-			case States::IDLE: {
-				bool received_start_supervisor = !cadmium::get_messages<typename defs::i_start_supervisor>(mbs).empty();
-				if (received_start_supervisor) {
-					// Get the most recent start supervisor input (found at the back of the vector of inputs)
-					mission_data = cadmium::get_messages<typename defs::i_start_supervisor>(mbs).back();
-					state.current_state = States::MISSION_STATUS;
-				}
-				break;
-			}
-			case States::CHECK_PERCEPTION_SYSTEM: {
+			case States::WAIT_FOR_CHECKS: {
 				bool received_perception_status = !cadmium::get_messages<typename defs::i_perception_status>(mbs).empty();
-				if (received_perception_status) {
-					std::vector<bool> perception_status = cadmium::get_messages<typename defs::i_perception_status>(mbs);
+				if (received_perception_status && !state.perception_checked) {
+					const std::vector<bool>& perception_status = cadmium::get_messages<typename defs::i_perception_status>(mbs);
 					perception_healthy = perception_status[0];
-					state.current_state = States::OUTPUT_PERCEPTION_STATUS;
+					timers.cancel("perception");
+					state.perception_checked = true;
 				}
-				break;
-			}
-			case States::CHECK_AIRCRAFT_STATE: {
 				bool received_aircraft_state = !cadmium::get_messages<typename defs::i_aircraft_state>(mbs).empty();
-				if (received_aircraft_state) {
-					std::vector<message_aircraft_state_t> new_aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(mbs);
+				if (received_aircraft_state && !state.aircraft_state_checked) {
+					const std::vector<message_aircraft_state_t>& new_aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(mbs);
 					aircraft_height = new_aircraft_state[0].alt_AGL;
-					state.current_state = States::OUTPUT_TAKEOFF_POSITION;
+					timers.cancel("aircraft_state");
+					state.aircraft_state_checked = true;
 				}
+				join_checks();
 				break;
 			}
 			default:
@@ -218,32 +250,28 @@ public:
 			case States::CHECK_AUTONOMY: {
 				if (mission_data.autonomy_armed) {
 					cadmium::get_messages<typename defs::o_request_perception_status>(bags).emplace_back(true);
+					cadmium::get_messages<typename defs::o_request_aircraft_state>(bags).emplace_back(true);
 				}
 				break;
 			}
-			case States::OUTPUT_PERCEPTION_STATUS: {
-				std::string update_text;
-				if (perception_healthy) {
-					update_text = "The perceptions system is ready for operation!";
-				} else {
-					update_text = "The perception system is not operational!";
-				}
+			case States::AIRCRAFT_STATE_TIMEOUT: {
 				cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-						update_text,
+						GCS_Text_E::AIRCRAFT_STATE_NOT_AVAILABLE,
 						Mav_Severities_E::MAV_SEVERITY_ALERT
 				);
 				break;
 			}
-			case States::REQUEST_AIRCRAFT_STATE: {
-				cadmium::get_messages<typename defs::o_request_aircraft_state>(bags).emplace_back(true);
-				break;
-			}
 			case States::OUTPUT_TAKEOFF_POSITION: {
+				cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
+						perception_healthy ? GCS_Text_E::PERCEPTION_READY : GCS_Text_E::PERCEPTION_NOT_OPERATIONAL,
+						Mav_Severities_E::MAV_SEVERITY_ALERT
+				);
+
 				cadmium::get_messages<typename defs::o_set_mission_monitor_status>(bags).emplace_back(1);
 
 				if (aircraft_height > 10.0) {
 					cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-							"Starting Mission in air!",
+							GCS_Text_E::STARTING_MISSION_IN_AIR,
 							Mav_Severities_E::MAV_SEVERITY_ALERT
 					);
 				}
@@ -265,15 +293,15 @@ public:
 		TIME next_internal;
 		switch (state.current_state) {
 			case States::IDLE:
-			case States::CHECK_PERCEPTION_SYSTEM:
-			case States::CHECK_AIRCRAFT_STATE:
 				next_internal = std::numeric_limits<TIME>::infinity();
 				break;
+			case States::WAIT_FOR_CHECKS:
+				next_internal = timers.next_expiry();
+				break;
 			case States::MISSION_STATUS:
 			case States::RESUME_MISSION:
 			case States::CHECK_AUTONOMY:
-			case States::OUTPUT_PERCEPTION_STATUS:
-			case States::REQUEST_AIRCRAFT_STATE:
+			case States::AIRCRAFT_STATE_TIMEOUT:
 			case States::OUTPUT_TAKEOFF_POSITION:
 			case States::START_MISSION:
 				next_internal = TIME(TA_ZERO);
@@ -301,6 +329,30 @@ private:
 	bool perception_healthy;
 	/// Variable for storing the height of the aircraft in ft AGL to determine if the aircraft is starting on the ground.
 	double aircraft_height;
+	/// Variable for storing the time to wait for the perception status.
+	TIME perception_timeout;
+	/// Variable for storing the time to wait for the aircraft state.
+	TIME aircraft_state_timeout;
+	/// Variable for tracking the perception ("perception") and aircraft state ("aircraft_state") check timers.
+	Timer_Wheel<TIME> timers;
+
+	/// Function for resetting private variables.
+	void reset_state() {
+		state.perception_checked = false;
+		state.aircraft_state_checked = false;
+		mission_data = message_start_supervisor_t();
+		perception_healthy = false;
+		aircraft_height = 0.0;
+		timers.clear();
+	}
+
+	/// Function for moving on to the takeoff position once both checks have completed.
+	void join_checks() {
+		if (state.perception_checked && state.aircraft_state_checked) {
+			timers.clear();
+			state.current_state = States::OUTPUT_TAKEOFF_POSITION;
+		}
+	}
 };
 
 #endif // MISSION_INITIALIZATION_HPP
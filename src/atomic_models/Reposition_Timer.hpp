@@ -16,9 +16,11 @@
 #include "../message_structures/message_landing_point_t.hpp"
 #include "../message_structures/message_boss_mission_update_t.hpp"
 #include "../message_structures/message_update_gcs_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Utility functions
 #include "../time_conversion.hpp"
+#include "../timer_wheel.hpp"
 #include "../enum_string_conversion.hpp"
 #include "../Constants.hpp"
 
@@ -29,6 +31,7 @@
 // System Libraries
 #include <limits> // Used to set the time advance to infinity
 #include <cassert>
+#include <cstdio>
 #include <string>
 
 /**
@@ -76,7 +79,7 @@ public:
         struct o_land : public cadmium::out_port<message_landing_point_t> {};
         struct o_pilot_handover : public cadmium::out_port<message_landing_point_t> {};
         struct o_request_reposition : public cadmium::out_port<message_landing_point_t> {};
-        struct o_update_boss : public cadmium::out_port<message_boss_mission_update_t> {};
+        struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
         struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
     };
 
@@ -172,6 +175,8 @@ public:
 
 	/// Internal transitions of the model
     void internal_transition() {
+        timers.advance(time_advance());
+
         switch (state.current_state) {
             case States::NOTIFY_UPDATE:
                 state.current_state = States::UPDATE_LP;
@@ -180,6 +185,7 @@ public:
                 state.current_state = States::NEW_LP_REPO;
                 break;
             case States::NEW_LP_REPO:
+                timers.arm("repo", repo_time);
                 state.current_state = States::LP_REPO;
                 break;
             case States::LP_REPO:
@@ -194,7 +200,9 @@ public:
     }
 
 	/// External transitions of the model
-    void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+    void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+        timers.advance(e);
+
         bool received_pilot_takeover = !cadmium::get_messages<typename defs::i_pilot_takeover>(mbs).empty();
         if (received_pilot_takeover) {
             state.current_state = States::PILOT_CONTROL;
@@ -213,10 +221,11 @@ public:
             case States::WAIT_NEW_LP: {
 				bool received_lp_new = !cadmium::get_messages<typename defs::i_lp_new>(mbs).empty();
 				if (received_lp_new) {
-					std::vector<message_landing_point_t> new_landing_points = cadmium::get_messages<typename defs::i_lp_new>(
+					const std::vector<message_landing_point_t>& new_landing_points = cadmium::get_messages<typename defs::i_lp_new>(
 							mbs);
 					// Get the most recent landing point input (found at the back of the vector of inputs)
 					landing_point = new_landing_points.back();
+					timers.arm("upd", upd_time);
 					state.current_state = States::NOTIFY_UPDATE;
 				}
 				break;
@@ -224,10 +233,9 @@ public:
             case States::UPDATE_LP: {
 				bool received_lp_new = !cadmium::get_messages<typename defs::i_lp_new>(mbs).empty();
 				if (received_lp_new) {
-					std::vector<message_landing_point_t> new_landing_points = cadmium::get_messages<typename defs::i_lp_new>(mbs);
+					const std::vector<message_landing_point_t>& new_landing_points = cadmium::get_messages<typename defs::i_lp_new>(mbs);
 					// Get the most recent landing point input (found at the back of the vector of inputs)
 					landing_point = new_landing_points.back();
-					update_upd_time(e);
 					state.current_state = States::NOTIFY_UPDATE;
 				}
 				break;
@@ -236,7 +244,7 @@ public:
 				bool received_lp_new = !cadmium::get_messages<typename defs::i_lp_new>(mbs).empty();
 				bool received_lp_crit_met = !cadmium::get_messages<typename defs::i_lp_crit_met>(mbs).empty();
 				if (received_lp_new) {
-					std::vector<message_landing_point_t> new_landing_points = cadmium::get_messages<typename defs::i_lp_new>(mbs);
+					const std::vector<message_landing_point_t>& new_landing_points = cadmium::get_messages<typename defs::i_lp_new>(mbs);
 					// Get the most recent landing point input (found at the back of the vector of inputs)
 					landing_point = new_landing_points.back();
 					state.current_state = States::NEW_LP_REPO;
@@ -270,9 +278,11 @@ public:
         switch (state.current_state) {
 			case States::NOTIFY_UPDATE: {
 				if (last_lp == 0) {
-					// Update the ground control computer
+					// Update the ground control computer, the text is formatted in place to avoid building a string.
+					char update_text[MAVLINK_MSG_STATUSTEXT_TEXT_LEN + 1];
+					std::snprintf(update_text, sizeof(update_text), "LP found. Holding for %llds", static_cast<long long>(upd_time.getSeconds()));
 					cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-							"LP found. Holding for " + std::to_string(upd_time.getSeconds()) + "s",
+							update_text,
 							Mav_Severities_E::MAV_SEVERITY_ALERT
 					);
 				}
@@ -314,7 +324,7 @@ public:
 
 				// Update the ground control computer
 				cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-						"Repo timer expired, hovering over the last LP",
+						GCS_Text_E::REPO_TIMER_EXPIRED,
 						Mav_Severities_E::MAV_SEVERITY_ALERT
 				);
 
@@ -345,10 +355,10 @@ public:
                 next_internal = std::numeric_limits<TIME>::infinity();
                 break;
             case States::UPDATE_LP:
-                next_internal = upd_time;
+                next_internal = timers.remaining("upd");
                 break;
             case States::LP_REPO:
-                next_internal = repo_time;
+                next_internal = timers.remaining("repo");
                 break;
             case States::NOTIFY_UPDATE:
             case States::NEW_LP_REPO:
@@ -378,10 +388,12 @@ private:
     int mission_number;
     /// Variable for storing the length of the reposition timer.
     TIME repo_time;
-    /// Variable for storing the remaining length of the update timer.
+    /// Variable for storing the length of the update timer.
 	TIME upd_time;
     /// Variable for storing the number of the last landing point, to check if one has been received yet.
     mutable int last_lp;
+    /// Variable for tracking the update ("upd") and reposition ("repo") timers.
+    Timer_Wheel<TIME> timers;
 
     /// Function for resetting private variables.
     void reset_state() {
@@ -390,16 +402,7 @@ private:
         landing_point = message_landing_point_t();
 		upd_time = seconds_to_time<TIME>(UPD_TIMER);
         last_lp = 0;
-    }
-
-    /**
-     * \brief   Function update_upd_time is used to update the update timer based on the current state and an elapsed time.
-     */
-	void update_upd_time(TIME e) {
-        upd_time = upd_time - e;
-        if (upd_time <= TIME(TA_ZERO)) {
-            upd_time = TIME(TA_ZERO);
-        }
+        timers.clear();
     }
 };
 
@@ -21,6 +21,7 @@
 // Utility functions
 #include "../enum_string_conversion.hpp"
 #include "../time_conversion.hpp"
+#include "../timer_wheel.hpp"
 #include <mavNRC/geo.h>
 #include "../Constants.hpp"
 
@@ -32,6 +33,7 @@
 #include <limits> // Used to set the time advance to infinity
 #include <cassert>
 #include <string>
+#include <deque>
 
 /**
  * 	\class		Stabilize
@@ -57,6 +59,7 @@ public:
 		(STABILIZING)
 		(CHECK_STATE)
 		(HOVER)
+		(END_STREAM)
 	)
 
 	/**
@@ -74,6 +77,7 @@ public:
 		struct o_fcc_command_hover : public cadmium::out_port<message_fcc_command_t> {};
 		struct o_hover_criteria_met : public cadmium::out_port<bool> {};
 		struct o_request_aircraft_state : public cadmium::out_port<bool> {};
+		struct o_stream_aircraft_state : public cadmium::out_port<bool> {};
 		struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
 	};
 
@@ -100,12 +104,14 @@ public:
 	 * 	\param	o_fcc_command_hover			Port for sending hover commands to the FCC.
 	 * 	\param	o_hover_criteria_met		Port for sending notification that the helicopter is now hovering at the specified hover criteria.
 	 * 	\param	o_request_aircraft_state	Port for requesting the current aircraft state.
+	 * 	\param	o_stream_aircraft_state		Port for subscribing (true) and unsubscribing (false) from the aircraft state stream when in streaming mode.
 	 * 	\param	o_update_gcs 				Port for sending updates to the GCS.
 	 */
 	using output_ports = std::tuple<
 		typename defs::o_fcc_command_hover,
 		typename defs::o_hover_criteria_met,
 		typename defs::o_request_aircraft_state,
+		typename defs::o_stream_aircraft_state,
 		typename defs::o_update_gcs
 	>;
 
@@ -138,6 +144,8 @@ public:
 		state.stabilization_time_prev = TIME("00:00:00:000");
 		hover_criteria = message_hover_criteria_t();
 		aircraft_state = message_aircraft_state_t();
+		streaming = false;
+		stream_time = TIME("00:00:00:000");
 	}
 
 	/**
@@ -152,6 +160,8 @@ public:
 		state.stabilization_time_prev = TIME("00:00:00:000");
 		hover_criteria = message_hover_criteria_t();
 		aircraft_state = message_aircraft_state_t();
+		streaming = false;
+		stream_time = TIME("00:00:00:000");
 	}
 
 	/**
@@ -167,6 +177,8 @@ public:
 		state.stabilization_time_prev = TIME("00:00:00:000");
 		hover_criteria = message_hover_criteria_t();
 		aircraft_state = message_aircraft_state_t();
+		streaming = false;
+		stream_time = TIME("00:00:00:000");
 	}
 
 	/**
@@ -183,10 +195,40 @@ public:
 		state.stabilization_time_prev = TIME("00:00:00:000");
 		hover_criteria = message_hover_criteria_t();
 		aircraft_state = message_aircraft_state_t();
+		streaming = false;
+		stream_time = TIME("00:00:00:000");
+	}
+
+	/**
+	 * \brief 	Constructor for the model with parameter for whether the hover criteria should be evaluated on every
+	 * 			aircraft state sample instead of being polled.
+	 * \details	In streaming mode the model subscribes to the aircraft state stream after sending the hover command and
+	 * 			keeps a sliding window of the in tolerance samples. The hover criteria is met once the window spans
+	 * 			the time tolerance. Gaps in the stream longer than the polling rate restart the window.
+	 * \param	polling_rate	TIME rate at which the aircraft state should be polled, or the largest gap allowed between
+	 * 							streamed samples in streaming mode.
+	 * \param	streaming		bool whether the aircraft state should be streamed at the sensor rate.
+	 */
+	Stabilize(TIME polling_rate, bool streaming) : Stabilize(polling_rate) {
+		this->streaming = streaming;
+	}
+
+	/**
+	 * \brief 	Constructor for the model with streaming and initial state parameters
+	 * 			for debugging or partial execution startup.
+	 * \param	polling_rate	TIME rate at which the aircraft state should be polled, or the largest gap allowed between
+	 * 							streamed samples in streaming mode.
+	 * \param	streaming		bool whether the aircraft state should be streamed at the sensor rate.
+	 * \param	initial_state	States initial state of the model.
+	 */
+	Stabilize(TIME polling_rate, bool streaming, States initial_state) : Stabilize(polling_rate, initial_state) {
+		this->streaming = streaming;
 	}
 
 	/// Internal transitions of the model
 	void internal_transition() {
+		timers.advance(time_advance());
+
 		switch (state.current_state) {
 			case States::REQUEST_AIRCRAFT_STATE:
 				state.current_state = States::GET_AIRCRAFT_STATE;
@@ -205,6 +247,9 @@ public:
                 reset_state();
 				state.current_state = States::WAIT_STABILIZE;
 				break;
+			case States::END_STREAM:
+				state.current_state = States::WAIT_STABILIZE;
+				break;
 			default:
 				break;
 		}
@@ -212,11 +257,14 @@ public:
 
 	/// External transitions of the model
 	void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		timers.advance(e);
+
 		bool received_cancel_hover = !cadmium::get_messages<typename defs::i_cancel_hover>(mbs).empty();
 		bool received_start_mission = !cadmium::get_messages<typename defs::i_start_mission>(mbs).empty();
 		if (received_cancel_hover || received_start_mission) {
+			bool subscribed = streaming && state.current_state == States::STABILIZING;
 			reset_state();
-            state.current_state = States::WAIT_STABILIZE;
+            state.current_state = subscribed ? States::END_STREAM : States::WAIT_STABILIZE;
 			return;
 		}
 
@@ -245,15 +293,33 @@ public:
 					aircraft_state = cadmium::get_messages<typename defs::i_aircraft_state>(mbs)[0];
 					state.in_tolerance = calculate_hover_criteria_met(aircraft_state);
 					if (!state.in_tolerance) {
+						timers.cancel("stabilization");
 						state.stabilization_time_prev = seconds_to_time<TIME>(hover_criteria.timeTol);
 					} else {
-						state.stabilization_time_prev = state.stabilization_time_prev - (polling_rate + e);
-						state.time_tolerance_met = (state.stabilization_time_prev <= TIME("00:00:00:000"));
+						// The time tolerance starts from the first sample in tolerance, not the poll before it.
+						if (!timers.armed("stabilization") && !timers.expired("stabilization")) {
+							timers.arm("stabilization", seconds_to_time<TIME>(hover_criteria.timeTol));
+						}
+						state.stabilization_time_prev = timers.remaining("stabilization");
+						state.time_tolerance_met = timers.expired("stabilization");
 					}
 					state.current_state = States::STABILIZING;
 				}
 				break;
 			}
+			case States::STABILIZING: {
+				if (!streaming) {
+					break;
+				}
+				stream_time = stream_time + e;
+				// Every sample in the bag is evaluated so that none of the stream is discarded.
+				for (const auto& sample : cadmium::get_messages<typename defs::i_aircraft_state>(mbs)) {
+					aircraft_state = sample;
+					state.time_tolerance_met = update_hover_window(aircraft_state);
+				}
+				state.in_tolerance = !hover_window.empty();
+				break;
+			}
 			default:
 				break;
 		}
@@ -264,6 +330,10 @@ public:
 		bool received_cancel_hover = !cadmium::get_messages<typename defs::i_cancel_hover>(mbs).empty();
 
 		if (received_cancel_hover) {
+			// The subscription to the aircraft state stream has already been sent with the hover command.
+			if (streaming && state.current_state == States::INIT_HOVER) {
+				state.current_state = States::STABILIZING;
+			}
 			external_transition(TIME(), std::move(mbs));
 		} else {
 			internal_transition();
@@ -287,19 +357,28 @@ public:
 						hover_criteria.desiredAltMSL * FT_TO_METERS
 				);
 				cadmium::get_messages<typename defs::o_fcc_command_hover>(bags).push_back(mfc);
+				if (streaming) {
+					cadmium::get_messages<typename defs::o_stream_aircraft_state>(bags).emplace_back(true);
+				}
 				break;
 			}
 			case States::STABILIZING:
 				if (state.time_tolerance_met && state.in_tolerance) {
 					cadmium::get_messages<typename defs::o_hover_criteria_met>(bags).emplace_back(true);
 					cadmium::get_messages<typename defs::o_update_gcs>(bags).emplace_back(
-							"Came to hover!",
+							GCS_Text_E::CAME_TO_HOVER,
 							Mav_Severities_E::MAV_SEVERITY_INFO
 					);
+					if (streaming) {
+						cadmium::get_messages<typename defs::o_stream_aircraft_state>(bags).emplace_back(false);
+					}
 				} else {
 					cadmium::get_messages<typename defs::o_request_aircraft_state>(bags).emplace_back(true);
 				}
 				break;
+			case States::END_STREAM:
+				cadmium::get_messages<typename defs::o_stream_aircraft_state>(bags).emplace_back(false);
+				break;
 			default:
 				break;
 		}
@@ -320,10 +399,17 @@ public:
 			case States::REQUEST_AIRCRAFT_STATE:
 			case States::INIT_HOVER:
 			case States::HOVER:
+			case States::END_STREAM:
 				next_internal = TIME(TA_ZERO);
 				break;
 			case States::STABILIZING:
-				next_internal = polling_rate;
+				if (!streaming) {
+					next_internal = polling_rate;
+				} else if (state.time_tolerance_met && state.in_tolerance) {
+					next_internal = TIME(TA_ZERO);
+				} else {
+					next_internal = std::numeric_limits<TIME>::infinity();
+				}
 				break;
 			default:
 				assert(false && "Unhandled state time advance.");
@@ -351,12 +437,46 @@ private:
 	message_aircraft_state_t aircraft_state;
 	/// Variable for storing the rate at which the aircraft state should be polled.
 	TIME polling_rate;
+	/// Variable for storing whether the aircraft state is streamed rather than polled.
+	bool streaming;
+	/// Variable for storing the time elapsed since the aircraft state stream was subscribed to.
+	TIME stream_time;
+	/// Variable for storing the stream times of the in tolerance samples that make up the sliding window.
+	std::deque<TIME> hover_window;
+	/// Variable for tracking the time tolerance ("stabilization") timer.
+	Timer_Wheel<TIME> timers;
 
     /// Function for resetting the state of the model.
 	void reset_state() {
 		state.stabilization_time_prev = TIME("00:00:000");
 		state.in_tolerance = false;
 		state.time_tolerance_met = false;
+		stream_time = TIME("00:00:00:000");
+		hover_window.clear();
+		timers.clear();
+	}
+
+	/// @brief 	Function update_hover_window is used to add a streamed aircraft state sample to the sliding window.
+	/// @param 	sample message_aircraft_state_t sample of the aircraft state received at the current stream time.
+	/// @return	true if every sample in the window is within the criteria and the window spans the time tolerance, false otherwise.
+	bool update_hover_window(const message_aircraft_state_t& sample) {
+		if (!hover_window.empty() && (stream_time - hover_window.back()) > polling_rate) {
+			hover_window.clear();
+		}
+
+		if (!calculate_hover_criteria_met(sample)) {
+			hover_window.clear();
+			return false;
+		}
+
+		hover_window.push_back(stream_time);
+
+		// Only the newest sample that still covers the time tolerance needs to be kept at the front of the window.
+		TIME time_tolerance = seconds_to_time<TIME>(hover_criteria.timeTol);
+		while (hover_window.size() > 1 && (stream_time - hover_window[1]) >= time_tolerance) {
+			hover_window.pop_front();
+		}
+		return (stream_time - hover_window.front()) >= time_tolerance;
 	}
 
 	/// @brief 	Function calculate_hover_criteria_met is used to check if a given aircraft state is within the current hover criteria.
@@ -0,0 +1,435 @@
+/**
+ * 	\file		Touchdown_Estimator.hpp
+ *	\brief		Definition of the Touchdown Estimator atomic model.
+ *	\details	This header file defines the Touchdown Estimator atomic model for use in the Cadmium DEVS
+				simulation software. The model predicts when the aircraft will touch down during a
+				landing from the streamed height above ground so that the landing can be declared
+				without waiting for the next poll of the landing height.
+ */
+
+#ifndef TOUCHDOWN_ESTIMATOR_HPP
+#define TOUCHDOWN_ESTIMATOR_HPP
+
+// Messages structures
+#include "../message_structures/message_aircraft_state_t.hpp"
+#include "../message_structures/message_fcc_command_t.hpp"
+
+// Utility functions
+#include "../enum_string_conversion.hpp"
+#include "../time_conversion.hpp"
+#include "../timer_wheel.hpp"
+#include "../Constants.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+
+// System Libraries
+#include <limits> // Used to set the time advance to infinity
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <string>
+#include <utility>
+
+/**
+ * 	\class		Touchdown_Estimator
+ *	\brief		Definition of the Touchdown Estimator atomic model.
+ *	\details	This class defines the Touchdown Estimator atomic model for use in the Cadmium DEVS
+				simulation software. When a landing is commanded the model subscribes to the aircraft
+				state stream and fits the vertical speed to a window of recent heights above ground.
+				Once consecutive estimates of the touchdown time agree, the prediction is sent and a
+				single event is scheduled at the touchdown time to declare the landing. A streamed
+				height below the landing height, or the landing achieved signal from the height
+				threshold poller, declares the landing immediately. A pilot takeover or a new mission
+				stops the estimate, and the model unsubscribes from the stream if it was subscribed.
+ */
+template<typename TIME>
+class Touchdown_Estimator {
+public:
+	/**
+	 *	\par	States
+	 * 	Declaration of the states of the atomic model.
+	 */
+	DEFINE_ENUM_WITH_STRING_CONVERSIONS(States,
+		(IDLE)
+		(START_ESTIMATE)
+		(ESTIMATING)
+		(NOTIFY_PREDICTION)
+		(TOUCHDOWN_PREDICTED)
+		(NOTIFY_LANDED)
+		(LANDED)
+		(END_STREAM)
+		(PILOT_CONTROL)
+	);
+
+	/**
+	 *	\brief	For definition of the input and output ports see:
+	 *	\ref 	Touchdown_Estimator_input_ports "Input Ports" and
+	 *	\ref 	Touchdown_Estimator_output_ports "Output Ports"
+	 * 	\note 	All input and output ports must be listed in this struct.
+	 */
+	struct defs {
+		struct i_aircraft_state : public cadmium::in_port<message_aircraft_state_t> {};
+		struct i_fcc_command_land : public cadmium::in_port<message_fcc_command_t> {};
+		struct i_landing_achieved : public cadmium::in_port<bool> {};
+		struct i_pilot_takeover : public cadmium::in_port<bool> {};
+		struct i_start_mission : public cadmium::in_port<int> {};
+
+		struct o_landing_achieved : public cadmium::out_port<bool> {};
+		struct o_stream_aircraft_state : public cadmium::out_port<bool> {};
+		struct o_touchdown_prediction : public cadmium::out_port<double> {};
+	};
+
+	/**
+	 * 	\anchor	Touchdown_Estimator_input_ports
+	 *	\par	Input Ports
+	 * 	Definition of the input ports for the model.
+	 * 	\param	i_aircraft_state	Port for receiving the streamed state of the aircraft.
+	 * 	\param	i_fcc_command_land	Port for receiving the land command sent to the FCC.
+	 * 	\param	i_landing_achieved	Port for receiving signal from the height threshold check indicating that the aircraft has landed.
+	 * 	\param	i_pilot_takeover	Port for receiving signal indicating that the pilot has taken control from the supervisor.
+	 * 	\param 	i_start_mission 	Port for receiving signal indicating the mission has started.
+	 */
+	using input_ports = std::tuple<
+		typename defs::i_aircraft_state,
+		typename defs::i_fcc_command_land,
+		typename defs::i_landing_achieved,
+		typename defs::i_pilot_takeover,
+		typename defs::i_start_mission
+	>;
+
+	/**
+	 *	\anchor	Touchdown_Estimator_output_ports
+	 * 	\par 	Output Ports
+	 * 	Definition of the output ports for the model.
+	 * 	\param	o_landing_achieved		Port for declaring that the aircraft has landed.
+	 * 	\param	o_stream_aircraft_state	Port for subscribing (true) and unsubscribing (false) from the aircraft state stream.
+	 * 	\param	o_touchdown_prediction	Port for sending the time in seconds until the predicted touchdown.
+	 */
+	using output_ports = std::tuple<
+		typename defs::o_landing_achieved,
+		typename defs::o_stream_aircraft_state,
+		typename defs::o_touchdown_prediction
+	>;
+
+	/**
+	 *	\anchor	Touchdown_Estimator_state_type
+	 *	\par	State
+	 * 	Definition of the states of the atomic model.
+	 * 	\param 	current_state 		Current state of atomic model.
+	 * 	\param 	vertical_speed		Vertical speed in ft/s fit to the window of heights, negative when descending.
+	 * 	\param 	time_to_touchdown	Time in seconds from the last sample to the predicted touchdown.
+	 */
+	struct state_type {
+		States current_state;
+		double vertical_speed;
+		double time_to_touchdown;
+	} state;
+
+	/**
+	 * \brief 	Default constructor for the model.
+	 */
+	Touchdown_Estimator() : Touchdown_Estimator(DEFAULT_LAND_CRITERIA_VERT_DIST) {}
+
+	/**
+	 * \brief 	Constructor for the model with parameter for the height the aircraft is considered landed at.
+	 * \param	landing_height_ft	float height above ground in feet below which the aircraft has landed.
+	 */
+	explicit Touchdown_Estimator(float landing_height_ft) : Touchdown_Estimator(landing_height_ft, States::IDLE) {}
+
+	/**
+	 * \brief 	Constructor for the model with parameters for the landing height and the initial state
+	 * 			for debugging or partial execution startup.
+	 * \param	landing_height_ft	float height above ground in feet below which the aircraft has landed.
+	 * \param	initial_state		States initial state of the model.
+	 */
+	Touchdown_Estimator(float landing_height_ft, States initial_state) {
+		this->landing_height_ft = landing_height_ft;
+		reset_state();
+		state.current_state = initial_state;
+	}
+
+	/// Internal transitions of the model
+	void internal_transition() {
+		TIME e = time_advance();
+		timers.advance(e);
+		estimate_time = estimate_time + e;
+
+		switch (state.current_state) {
+			case States::START_ESTIMATE:
+				state.current_state = States::ESTIMATING;
+				break;
+			case States::NOTIFY_PREDICTION:
+				state.current_state = States::TOUCHDOWN_PREDICTED;
+				break;
+			case States::TOUCHDOWN_PREDICTED:
+			case States::NOTIFY_LANDED:
+				streaming = false;
+				state.current_state = States::LANDED;
+				break;
+			case States::END_STREAM:
+				state.current_state = after_stream;
+				break;
+			default:
+				break;
+		}
+	}
+
+	/// External transitions of the model
+	void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		timers.advance(e);
+		estimate_time = estimate_time + e;
+
+		bool received_start_mission = !cadmium::get_messages<typename defs::i_start_mission>(mbs).empty();
+		if (received_start_mission) {
+			stop_estimate(States::IDLE);
+			return;
+		}
+
+		if (state.current_state == States::PILOT_CONTROL) {
+			return;
+		}
+
+		bool received_pilot_takeover = !cadmium::get_messages<typename defs::i_pilot_takeover>(mbs).empty();
+		if (received_pilot_takeover) {
+			stop_estimate(States::PILOT_CONTROL);
+			return;
+		}
+
+		// Fall back to the height threshold check whenever it reports the landing first.
+		bool received_landing_achieved = !cadmium::get_messages<typename defs::i_landing_achieved>(mbs).empty();
+		if (received_landing_achieved && state.current_state != States::NOTIFY_LANDED && state.current_state != States::END_STREAM) {
+			timers.cancel("touchdown");
+			state.current_state = States::NOTIFY_LANDED;
+			return;
+		}
+
+		switch (state.current_state) {
+			case States::IDLE:
+			case States::LANDED: {
+				bool received_fcc_command_land = !cadmium::get_messages<typename defs::i_fcc_command_land>(mbs).empty();
+				if (received_fcc_command_land) {
+					reset_state();
+					streaming = true;
+					state.current_state = States::START_ESTIMATE;
+				}
+				break;
+			}
+			case States::ESTIMATING:
+			case States::TOUCHDOWN_PREDICTED: {
+				bool received_aircraft_state = !cadmium::get_messages<typename defs::i_aircraft_state>(mbs).empty();
+				if (received_aircraft_state) {
+					update_estimate(cadmium::get_messages<typename defs::i_aircraft_state>(mbs).back());
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	/// Function used to decide precedence between internal and external transitions when both are scheduled simultaneously.
+	void confluence_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		internal_transition();
+		external_transition(TIME(), std::move(mbs));
+	}
+
+	/// Function for generating output from the model before internal transitions.
+	[[nodiscard]] typename cadmium::make_message_bags<output_ports>::type output() const {
+		typename cadmium::make_message_bags<output_ports>::type bags;
+
+		switch (state.current_state) {
+			case States::START_ESTIMATE:
+				cadmium::get_messages<typename defs::o_stream_aircraft_state>(bags).push_back(true);
+				break;
+			case States::NOTIFY_PREDICTION:
+				cadmium::get_messages<typename defs::o_touchdown_prediction>(bags).push_back(state.time_to_touchdown);
+				break;
+			case States::TOUCHDOWN_PREDICTED:
+			case States::NOTIFY_LANDED:
+				cadmium::get_messages<typename defs::o_landing_achieved>(bags).push_back(true);
+				if (streaming) {
+					cadmium::get_messages<typename defs::o_stream_aircraft_state>(bags).push_back(false);
+				}
+				break;
+			case States::END_STREAM:
+				cadmium::get_messages<typename defs::o_stream_aircraft_state>(bags).push_back(false);
+				break;
+			default:
+				break;
+		}
+
+		return bags;
+	}
+
+	/// Function to declare the time advance value for each state of the model.
+	TIME time_advance() const {
+		switch (state.current_state) {
+			case States::IDLE:
+			case States::ESTIMATING:
+			case States::LANDED:
+			case States::PILOT_CONTROL:
+				return std::numeric_limits<TIME>::infinity();
+			case States::START_ESTIMATE:
+			case States::NOTIFY_PREDICTION:
+			case States::NOTIFY_LANDED:
+			case States::END_STREAM:
+				return TIME(TA_ZERO);
+			case States::TOUCHDOWN_PREDICTED:
+				return timers.remaining("touchdown");
+			default:
+				assert(false && "Unhandled state time advance.");
+		}
+	}
+
+	/**
+	 *  \brief 		Operator for defining how the model state will be represented as a string.
+	 * 	\warning 	Prepended "State: " is required for log parsing, do not remove.
+	 */
+	friend std::ostringstream& operator<<(std::ostringstream& os, const typename Touchdown_Estimator<TIME>::state_type& i) {
+		os << "State: " << enumToString(i.current_state)
+		   << std::fixed << std::setprecision(2)
+		   << " " << i.vertical_speed
+		   << " " << i.time_to_touchdown
+		   << std::endl;
+		return os;
+	}
+
+private:
+	/// Height above ground in feet below which the aircraft has landed.
+	float landing_height_ft;
+	/// Time since the landing was commanded, used to time stamp the samples.
+	TIME estimate_time;
+	/// Window of the most recent samples as pairs of time in seconds and height above ground in feet.
+	std::deque<std::pair<double, double>> height_window;
+	/// Touchdown time in seconds of the previous estimate, NaN if there was none.
+	double previous_touchdown;
+	/// Whether the model is subscribed to the aircraft state stream.
+	bool streaming;
+	/// State entered once the model has unsubscribed from the aircraft state stream.
+	States after_stream;
+	/// Used to schedule the predicted touchdown ("touchdown").
+	Timer_Wheel<TIME> timers;
+
+	/// Function for resetting the estimate and returning to the idle state.
+	void reset_state() {
+		state.current_state = States::IDLE;
+		state.vertical_speed = 0.0;
+		state.time_to_touchdown = std::numeric_limits<double>::infinity();
+		estimate_time = TIME("00:00:00:000");
+		height_window.clear();
+		previous_touchdown = std::nan("");
+		streaming = false;
+		after_stream = States::IDLE;
+		timers.clear();
+	}
+
+	/// Function for stopping the estimate, unsubscribing from the aircraft state stream before entering the next state.
+	void stop_estimate(States next_state) {
+		bool subscribed = streaming;
+		reset_state();
+		after_stream = next_state;
+		state.current_state = subscribed ? States::END_STREAM : next_state;
+	}
+
+	/**
+	 *	\brief 		Function update_estimate is used to add a streamed sample to the window and update the touchdown estimate.
+	 *	\details	While estimating, the touchdown is scheduled once two consecutive estimates agree within
+	 * 				TOUCHDOWN_CONVERGENCE_TOLERANCE. Once scheduled, the event is only cancelled if the
+	 * 				aircraft stops descending.
+	 * 	\param		i_aircraft_state	message_aircraft_state_t most recent streamed state of the aircraft.
+	 */
+	void update_estimate(const message_aircraft_state_t& i_aircraft_state) {
+		double sample_time = time_to_seconds(estimate_time);
+		if (!height_window.empty() && sample_time <= height_window.back().first) {
+			height_window.pop_back();
+		}
+		height_window.emplace_back(sample_time, i_aircraft_state.alt_AGL);
+		while (height_window.size() > TOUCHDOWN_WINDOW_SIZE) {
+			height_window.pop_front();
+		}
+
+		if (i_aircraft_state.alt_AGL < landing_height_ft) {
+			timers.cancel("touchdown");
+			state.current_state = States::NOTIFY_LANDED;
+			return;
+		}
+
+		double touchdown;
+		bool descending = fit_touchdown(touchdown);
+		state.time_to_touchdown = descending ? std::max(touchdown - sample_time, 0.0) : std::numeric_limits<double>::infinity();
+
+		if (state.current_state == States::TOUCHDOWN_PREDICTED) {
+			if (!descending) {
+				timers.cancel("touchdown");
+				previous_touchdown = std::nan("");
+				state.current_state = States::ESTIMATING;
+			}
+			return;
+		}
+
+		bool converged = descending &&
+				!std::isnan(previous_touchdown) &&
+				std::abs(touchdown - previous_touchdown) <= TOUCHDOWN_CONVERGENCE_TOLERANCE &&
+				state.time_to_touchdown <= TOUCHDOWN_MAX_HORIZON;
+		previous_touchdown = descending ? touchdown : std::nan("");
+
+		if (converged) {
+			timers.arm("touchdown", milliseconds_to_time<TIME>(std::llround(state.time_to_touchdown * 1000.0)));
+			state.current_state = States::NOTIFY_PREDICTION;
+		}
+	}
+
+	/**
+	 *	\brief 		Function fit_touchdown is used to fit a constant vertical speed to the window of heights.
+	 *	\details	The fit is only trusted when the window is full, the aircraft is descending faster than
+	 * 				TOUCHDOWN_MIN_DESCENT_RATE and the RMS error of the fit is below TOUCHDOWN_MAX_RESIDUAL.
+	 * 	\param		touchdown	double set to the time in seconds the fitted height reaches the landing height.
+	 * 	\return		true if the fit can be trusted, false otherwise.
+	 */
+	bool fit_touchdown(double& touchdown) {
+		state.vertical_speed = 0.0;
+		if (height_window.size() < TOUCHDOWN_WINDOW_SIZE) {
+			return false;
+		}
+
+		double mean_time = 0.0;
+		double mean_height = 0.0;
+		for (const auto& sample : height_window) {
+			mean_time += sample.first;
+			mean_height += sample.second;
+		}
+		mean_time /= height_window.size();
+		mean_height /= height_window.size();
+
+		double covariance = 0.0;
+		double variance = 0.0;
+		for (const auto& sample : height_window) {
+			covariance += (sample.first - mean_time) * (sample.second - mean_height);
+			variance += (sample.first - mean_time) * (sample.first - mean_time);
+		}
+		if (variance <= 0.0) {
+			return false;
+		}
+		state.vertical_speed = covariance / variance;
+
+		double squared_error = 0.0;
+		for (const auto& sample : height_window) {
+			double error = sample.second - (mean_height + state.vertical_speed * (sample.first - mean_time));
+			squared_error += error * error;
+		}
+
+		if (state.vertical_speed > -TOUCHDOWN_MIN_DESCENT_RATE ||
+			std::sqrt(squared_error / height_window.size()) > TOUCHDOWN_MAX_RESIDUAL) {
+			return false;
+		}
+
+		touchdown = mean_time + (landing_height_ft - mean_height) / state.vertical_speed;
+		return true;
+	}
+};
+
+#endif // TOUCHDOWN_ESTIMATOR_HPP
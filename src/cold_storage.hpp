@@ -0,0 +1,62 @@
+/**
+ * 	\file		cold_storage.hpp
+ *	\brief		Definition of the cold storage used by the atomic models.
+ *	\details	This header file defines a holder for the variables of an atomic model that are rarely
+				used, so that they are stored out of line and the variables used by every transition
+				are packed into fewer cache lines.
+ */
+
+#ifndef COLD_STORAGE_HPP
+#define COLD_STORAGE_HPP
+
+// System Libraries
+#include <memory>
+
+/**
+ * 	\class		Cold_Storage
+ *	\brief		Definition of the cold storage used by the atomic models.
+ *	\details	This class stores a value on the heap and only keeps a pointer to it inline. Unlike a
+				plain pointer it behaves as a value, copying a model copies the stored value, so it
+				can replace a group of member variables without changing how the model is copied.
+ */
+template<typename T>
+class Cold_Storage {
+public:
+	/// Default constructor for a default constructed value.
+	Cold_Storage() : value(std::make_unique<T>()) {}
+
+	/// Copy constructor, copying the stored value.
+	Cold_Storage(const Cold_Storage& other) : value(std::make_unique<T>(*other.value)) {}
+
+	/// Copy assignment, copying the stored value.
+	Cold_Storage& operator=(const Cold_Storage& other) {
+		*value = *other.value;
+		return *this;
+	}
+
+	/// @return	Stored value.
+	T& operator*() {
+		return *value;
+	}
+
+	/// @return	Stored value.
+	const T& operator*() const {
+		return *value;
+	}
+
+	/// @return	Pointer to the stored value.
+	T* operator->() {
+		return value.get();
+	}
+
+	/// @return	Pointer to the stored value.
+	const T* operator->() const {
+		return value.get();
+	}
+
+private:
+	/// Value stored out of line.
+	std::unique_ptr<T> value;
+};
+
+#endif // COLD_STORAGE_HPP
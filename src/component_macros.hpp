@@ -12,5 +12,6 @@
 #define SUPERVISOR_SIG_ID_WAYPOINT 3
 #define SUPERVISOR_SIG_ID_LP_RECEIVE 4
 #define SUPERVISOR_SIG_ID_PLP_ACHIEVED 5
+#define SUPERVISOR_SIG_ID_WAYPOINT_UPDATE 6
 
 #endif /* COMPONENT_MACROS_HPP */
\ No newline at end of file
@@ -0,0 +1,193 @@
+/**
+ * 	\file		Closed_Loop.hpp
+ *	\brief		Definition of the Closed Loop coupled model.
+ *	\details	This header file defines the Closed Loop coupled model for use in the Cadmium DEVS
+				simulation software. The model flies the Supervisor against the FCC Emulator, so that
+				whole missions can be run without the aircraft.
+ */
+
+#ifndef CLOSED_LOOP_HPP
+#define CLOSED_LOOP_HPP
+
+// Messages structures
+#include "../message_structures/message_aircraft_state_t.hpp"
+
+// IO model headers
+#include "../io_models/FCC_Emulator.hpp"
+#include "../io_models/Packet_Builder.hpp"
+
+// Coupled model headers
+#include "Supervisor.hpp"
+
+// Constants
+#include "../Constants.hpp"
+
+// Utility functions
+#include "../metered_model.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+
+// Time Class Header
+#include <NDTime.hpp>
+
+/**
+ * 	\class		Closed_Loop
+ *	\brief		Definition of the Closed Loop coupled model.
+ *	\details	This class defines the Closed Loop coupled model for use in the Cadmium DEVS
+				simulation software. The FCC commands of the Supervisor are built into packets by the
+				same packet builder the Vehicle sends to the FCC, and the packets are flown by the FCC
+				Emulator in place of the FCC and the aircraft. The aircraft state requested or streamed by
+				the Supervisor and landing achieved are fed back from the emulator, while the inputs from
+				the mission manager, perception system and pilot are given on the input ports of the model.
+ */
+class Closed_Loop {
+	using TIME = NDTime;
+
+public:
+	/**
+	 * \brief 	Constructor for the model with the state of the aircraft at the start of the mission.
+	 * \param	i_initial_state	message_aircraft_state_t state of the aircraft at the start, hovering.
+	 */
+	explicit Closed_Loop(message_aircraft_state_t i_initial_state = message_aircraft_state_t())
+			: initial_state(i_initial_state) {}
+
+	/**
+	 *	\brief	For definition of the input and output ports see:
+	*	\ref 	Closed_Loop_input_ports "Input Ports" and
+	*	\ref 	Closed_Loop_output_ports "Output Ports"
+	* 	\note 	All input and output ports must be listed in this struct.
+	*/
+	struct defs {
+		/***** Define input ports for coupled model *****/
+		struct i_LP_recv : public cadmium::in_port<message_landing_point_t> {};
+		struct i_perception_status : public cadmium::in_port<bool> {};
+		struct i_pilot_takeover : public cadmium::in_port<bool> {};
+		struct i_PLP_ach : public cadmium::in_port<message_landing_point_t> {};
+		struct i_start_supervisor : public cadmium::in_port<message_start_supervisor_t> {};
+		struct i_waypoint : public cadmium::in_port<message_fcc_command_t> {};
+		struct i_waypoint_update : public cadmium::in_port<message_waypoint_update_t> {};
+
+		/***** Define output ports for coupled model *****/
+		struct o_aircraft_state : public cadmium::out_port<message_aircraft_state_t> {};
+		struct o_mission_complete : public cadmium::out_port<bool> {};
+		struct o_notify_pilot : public cadmium::out_port<bool> {};
+		struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
+	};
+
+private:
+	/// Variable for storing the state of the aircraft at the start of the mission, declared before the emulator.
+	message_aircraft_state_t initial_state;
+
+	// Instantiate the Supervisor.
+	Supervisor supervisor_instance;
+	std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> supervisor = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>("supervisor", supervisor_instance.submodels, supervisor_instance.iports, supervisor_instance.oports, supervisor_instance.eics, supervisor_instance.eocs, supervisor_instance.ics);
+
+	// Instantiate the FCC packet builder and the emulator flying its packets.
+	std::shared_ptr<cadmium::dynamic::modeling::model> pb_fcc = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_Fcc>::model, TIME>("pb_fcc");
+	std::shared_ptr<cadmium::dynamic::modeling::model> fcc_emulator = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<FCC_Emulator>::model, TIME, message_aircraft_state_t, float>("fcc_emulator", message_aircraft_state_t(initial_state), DEFAULT_LAND_CRITERIA_VERT_DIST);
+
+public:
+	/**
+	 *	\anchor	Closed_Loop_submodels
+	 * 	\par 	Submodels
+	 * 	Definition of the sub-models that make up the coupled model.
+	 * 	\param 	supervisor		Model for the behaviour of the Supervisor.
+	 * 	\param 	pb_fcc			Model for building the FCC commands into packets.
+	 * 	\param 	fcc_emulator	Model for the FCC and the aircraft flying the packets.
+	 */
+ 	cadmium::dynamic::modeling::Models submodels = {
+		supervisor,
+		pb_fcc,
+		fcc_emulator
+	};
+
+	/**
+	 * 	\anchor	Closed_Loop_input_ports
+	 *	\par	Input Ports
+	 * 	Definition of the input ports for the model.
+	 * 	\param 	i_LP_recv			Port for receiving landing points from the perception system.
+	 * 	\param 	i_perception_status	Port for receiving the status of the perception system.
+	 * 	\param 	i_pilot_takeover	Port for signal indicating that the pilot has taken control from the supervisor.
+	 * 	\param 	i_PLP_ach			Port for receiving signal indicating that the planned landing point has been achieved.
+	 * 	\param 	i_start_supervisor	Port for receiving signal indicating the mission has started.
+	 * 	\param 	i_waypoint			Port for receiving new waypoints during the on-route phase.
+	 * 	\param 	i_waypoint_update	Port for receiving indexed updates to the waypoints of the route.
+	 */
+ 	cadmium::dynamic::modeling::Ports iports = {
+		typeid(defs::i_LP_recv),
+		typeid(defs::i_perception_status),
+		typeid(defs::i_pilot_takeover),
+		typeid(defs::i_PLP_ach),
+		typeid(defs::i_start_supervisor),
+		typeid(defs::i_waypoint),
+		typeid(defs::i_waypoint_update)
+	};
+
+	/**
+	 *	\anchor	Closed_Loop_output_ports
+	 * 	\par 	Output Ports
+	 * 	Definition of the output ports for the model.
+	 * 	\param 	o_aircraft_state	Port for sending the aircraft state fed back to the Supervisor.
+	 * 	\param 	o_mission_complete	Port for declaring the mission as being complete after landing.
+	 * 	\param 	o_notify_pilot		Port for notifying the pilot that they should take control of the aircraft.
+	 * 	\param 	o_update_gcs		Port for sending updates to the GCS.
+	 */
+ 	cadmium::dynamic::modeling::Ports oports = {
+		typeid(defs::o_aircraft_state),
+		typeid(defs::o_mission_complete),
+		typeid(defs::o_notify_pilot),
+		typeid(defs::o_update_gcs)
+	};
+
+	/**
+	 * 	\par 	External Input Couplings
+	 *	Definition of the external to internal couplings for the model.
+	 * 	\see 	Closed_Loop
+	 */
+ 	cadmium::dynamic::modeling::EICs eics = {
+		cadmium::dynamic::translate::make_EIC<defs::i_LP_recv, Supervisor::defs::i_LP_recv>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_perception_status, Supervisor::defs::i_perception_status>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_pilot_takeover, Supervisor::defs::i_pilot_takeover>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_PLP_ach, Supervisor::defs::i_PLP_ach>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_start_supervisor, Supervisor::defs::i_start_supervisor>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_waypoint, Supervisor::defs::i_waypoint>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_waypoint_update, Supervisor::defs::i_waypoint_update>("supervisor")
+	};
+
+	/**
+	 * 	\par 	External Output Couplings
+	 *	Definition of the internal to external couplings for the model.
+	 * 	\see 	Closed_Loop
+	 */
+ 	cadmium::dynamic::modeling::EOCs eocs = {
+		cadmium::dynamic::translate::make_EOC<FCC_Emulator<TIME>::defs::o_message, defs::o_aircraft_state>("fcc_emulator"),
+		cadmium::dynamic::translate::make_EOC<Supervisor::defs::o_mission_complete, defs::o_mission_complete>("supervisor"),
+		cadmium::dynamic::translate::make_EOC<Supervisor::defs::o_notify_pilot, defs::o_notify_pilot>("supervisor"),
+		cadmium::dynamic::translate::make_EOC<Supervisor::defs::o_update_gcs, defs::o_update_gcs>("supervisor")
+	};
+
+	/**
+	 * 	\par 	Internal Couplings
+	 * 	Definition of the internal to internal couplings for the model.
+	 * 	\see 	Closed_Loop
+	 */
+ 	cadmium::dynamic::modeling::ICs ics = {
+		// Commands to the FCC
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_hover, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_land, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_orbit, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_velocity, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_waypoint_update, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+		cadmium::dynamic::translate::make_IC<Packet_Builder_Fcc<TIME>::defs::o_packet, FCC_Emulator<TIME>::defs::i_packet>("pb_fcc", "fcc_emulator"),
+
+		// Aircraft state fed back to the Supervisor
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_request_aircraft_state, FCC_Emulator<TIME>::defs::i_request>("supervisor", "fcc_emulator"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_stream_aircraft_state, FCC_Emulator<TIME>::defs::i_stream>("supervisor", "fcc_emulator"),
+		cadmium::dynamic::translate::make_IC<FCC_Emulator<TIME>::defs::o_message, Supervisor::defs::i_aircraft_state>("fcc_emulator", "supervisor"),
+		cadmium::dynamic::translate::make_IC<FCC_Emulator<TIME>::defs::o_landing_achieved, Supervisor::defs::i_landing_achieved>("fcc_emulator", "supervisor")
+	};
+};
+
+#endif // CLOSED_LOOP_HPP
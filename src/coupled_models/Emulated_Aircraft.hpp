@@ -0,0 +1,151 @@
+/**
+ * 	\file		Emulated_Aircraft.hpp
+ *	\brief		Definition of the Emulated Aircraft coupled model.
+ *	\details	This header file defines the Emulated Aircraft coupled model for use in the Cadmium DEVS
+				simulation software. The model flies the FCC packets of a vehicle with the FCC Emulator and
+				publishes the state of the emulated aircraft to the source the vehicle reads it from.
+ */
+
+#ifndef EMULATED_AIRCRAFT_HPP
+#define EMULATED_AIRCRAFT_HPP
+
+// Messages structures
+#include "../message_structures/message_aircraft_state_t.hpp"
+
+// IO model headers
+#include "../io_models/FCC_Emulator.hpp"
+#include "../io_models/State_Publisher.hpp"
+
+// Constants
+#include "../Constants.hpp"
+
+// Utility functions
+#include "../aircraft_state_source.hpp"
+#include "../metered_model.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+
+// Time Class Header
+#include <NDTime.hpp>
+
+// System Libraries
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * 	\class		Emulated_Aircraft
+ *	\brief		Definition of the Emulated Aircraft coupled model.
+ *	\details	This class defines the Emulated Aircraft coupled model for use in the Cadmium DEVS
+				simulation software. It stands in for the FCC and the aircraft of a vehicle in the
+				real-time runners. The FCC packets of the vehicle are flown by the FCC Emulator, which
+				streams the aircraft state to a State Publisher that sets it in the source read by the
+				input models of the vehicle. Both models are Metered, so unlike the shared memory the
+				emulated aircraft follows the time warp of the process along with the vehicle.
+ */
+class Emulated_Aircraft {
+	using TIME = NDTime;
+
+public:
+	/**
+	 * \brief 	Constructor for the model with the state of the aircraft at the start and the source it is published to.
+	 * \param	i_initial_state	message_aircraft_state_t state of the aircraft at the start, hovering.
+	 * \param	i_state_source	std::shared_ptr<Stored_State_Source> source read by the input models of the vehicle.
+	 */
+	Emulated_Aircraft(message_aircraft_state_t i_initial_state, std::shared_ptr<Stored_State_Source> i_state_source)
+			: initial_state(i_initial_state), state_source(std::move(i_state_source)) {
+		// The source is connected from the start, as the aircraft is already hovering in its initial state.
+		state_source->set(initial_state);
+	}
+
+	/**
+	 * \brief 	Function to read the state of the aircraft at the start from a file.
+	 * \param	file_path	std::string path of the file, in the format of the closed loop initial states.
+	 * \return	message_aircraft_state_t read from the file.
+	 * \throws	std::runtime_error if the file cannot be opened or does not hold an aircraft state.
+	 */
+	static message_aircraft_state_t read_initial_state(const std::string& file_path) {
+		std::ifstream file(file_path);
+		if (!file.is_open()) {
+			throw(std::runtime_error("Could not open the initial aircraft state file " + file_path));
+		}
+		message_aircraft_state_t initial_state;
+		if (!(file >> initial_state)) {
+			throw(std::runtime_error("No aircraft state in " + file_path));
+		}
+		return initial_state;
+	}
+
+	/**
+	 *	\brief	For definition of the input and output ports see:
+	*	\ref 	Emulated_Aircraft_input_ports "Input Ports"
+	* 	\note 	All input and output ports must be listed in this struct.
+	*/
+	struct defs {
+		/***** Define input ports for coupled model *****/
+		struct i_fcc_packet : public cadmium::in_port<std::vector<char>> {};
+	};
+
+private:
+	/// Variable for storing the state of the aircraft at the start, declared before the emulator.
+	message_aircraft_state_t initial_state;
+	/// Variable for storing the source the aircraft state is published to, declared before the publisher.
+	std::shared_ptr<Stored_State_Source> state_source;
+
+	// Instantiate the emulator, streaming the aircraft state from the start, and the publisher of its state.
+	std::shared_ptr<cadmium::dynamic::modeling::model> fcc_emulator = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<FCC_Emulator>::model, TIME, message_aircraft_state_t, float, bool>("fcc_emulator", message_aircraft_state_t(initial_state), DEFAULT_LAND_CRITERIA_VERT_DIST, true);
+	std::shared_ptr<cadmium::dynamic::modeling::model> state_publisher = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<State_Publisher>::model, TIME, std::shared_ptr<Stored_State_Source>>("state_publisher", std::shared_ptr<Stored_State_Source>(state_source));
+
+public:
+	/**
+	 *	\anchor	Emulated_Aircraft_submodels
+	 * 	\par 	Submodels
+	 * 	Definition of the sub-models that make up the coupled model.
+	 * 	\param 	fcc_emulator	Model for the FCC and the aircraft flying the packets.
+	 * 	\param 	state_publisher	Model for setting the aircraft state in the source of the vehicle.
+	 */
+ 	cadmium::dynamic::modeling::Models submodels = {
+		fcc_emulator,
+		state_publisher
+	};
+
+	/**
+	 * 	\anchor	Emulated_Aircraft_input_ports
+	 *	\par	Input Ports
+	 * 	Definition of the input ports for the model.
+	 * 	\param 	i_fcc_packet	Port for receiving the FCC packets of the vehicle.
+	 */
+ 	cadmium::dynamic::modeling::Ports iports = {
+		typeid(defs::i_fcc_packet)
+	};
+
+	/// The model has no output ports, the aircraft state is published to the source.
+ 	cadmium::dynamic::modeling::Ports oports = { };
+
+	/**
+	 * 	\par 	External Input Couplings
+	 *	Definition of the external to internal couplings for the model.
+	 * 	\see 	Emulated_Aircraft
+	 */
+ 	cadmium::dynamic::modeling::EICs eics = {
+		cadmium::dynamic::translate::make_EIC<defs::i_fcc_packet, FCC_Emulator<TIME>::defs::i_packet>("fcc_emulator")
+	};
+
+	/// The model has no external output couplings.
+ 	cadmium::dynamic::modeling::EOCs eocs = { };
+
+	/**
+	 * 	\par 	Internal Couplings
+	 * 	Definition of the internal to internal couplings for the model.
+	 * 	\see 	Emulated_Aircraft
+	 */
+ 	cadmium::dynamic::modeling::ICs ics = {
+		cadmium::dynamic::translate::make_IC<FCC_Emulator<TIME>::defs::o_message, State_Publisher<TIME>::defs::i_aircraft_state>("fcc_emulator", "state_publisher")
+	};
+};
+
+#endif // EMULATED_AIRCRAFT_HPP
@@ -19,15 +19,20 @@
 #include "../message_structures/message_fcc_command_t.hpp"
 #include "../message_structures/message_boss_mission_update_t.hpp"
 #include "../message_structures/message_update_gcs_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Atomic model headers
 #include "../atomic_models/Landing_Routine.hpp"
 #include "../atomic_models/Reposition_Timer.hpp"
 #include "../atomic_models/Command_Reposition.hpp"
+#include "../atomic_models/Touchdown_Estimator.hpp"
 
 // Constants
 #include "../Constants.hpp"
 
+// Utility functions
+#include "../metered_model.hpp"
+
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
 #include <cadmium/modeling/dynamic_model_translator.hpp>
@@ -60,6 +65,7 @@ public:
 		struct i_hover_criteria_met : public cadmium::in_port<bool> {};
 		struct i_landing_achieved : public cadmium::in_port<bool> {};
 		struct i_lp_new : public cadmium::in_port<message_landing_point_t> {};
+		struct i_lp_ranking : public cadmium::in_port<message_landing_point_t> {};
 		struct i_pilot_takeover : public cadmium::in_port<bool> {};
 		struct i_start_mission : public cadmium::in_port<int> {};
 
@@ -72,15 +78,18 @@ public:
 		struct o_request_aircraft_state : public cadmium::out_port<bool> {};
 		struct o_set_mission_monitor_status : public cadmium::out_port<uint8_t> {};
 		struct o_stabilize : public cadmium::out_port<message_hover_criteria_t> {};
-		struct o_update_boss : public cadmium::out_port<message_boss_mission_update_t> {};
+		struct o_stream_aircraft_state : public cadmium::out_port<bool> {};
+		struct o_touchdown_prediction : public cadmium::out_port<double> {};
+		struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 		struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
 		struct o_update_mission_item : public cadmium::out_port<bool> {};
 	};
 
 	// Instantiate the Atomic models.
-	std::shared_ptr <cadmium::dynamic::modeling::model> landing_routine = cadmium::dynamic::translate::make_dynamic_atomic_model<Landing_Routine, TIME>("landing_routine");
-	std::shared_ptr <cadmium::dynamic::modeling::model> command_reposition = cadmium::dynamic::translate::make_dynamic_atomic_model<Command_Reposition, TIME>("command_reposition");
-	std::shared_ptr <cadmium::dynamic::modeling::model> reposition_timer = cadmium::dynamic::translate::make_dynamic_atomic_model<Reposition_Timer, TIME, TIME, TIME>("reposition_timer", seconds_to_time<TIME>(REPO_TIMER), seconds_to_time<TIME>(UPD_TIMER));
+	std::shared_ptr <cadmium::dynamic::modeling::model> landing_routine = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Landing_Routine>::model, TIME>("landing_routine");
+	std::shared_ptr <cadmium::dynamic::modeling::model> command_reposition = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Command_Reposition>::model, TIME>("command_reposition");
+	std::shared_ptr <cadmium::dynamic::modeling::model> reposition_timer = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Reposition_Timer>::model, TIME, TIME, TIME>("reposition_timer", seconds_to_time<TIME>(REPO_TIMER), seconds_to_time<TIME>(UPD_TIMER));
+	std::shared_ptr <cadmium::dynamic::modeling::model> touchdown_estimator = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Touchdown_Estimator>::model, TIME, float>("touchdown_estimator", DEFAULT_LAND_CRITERIA_VERT_DIST);
 
 	/**
 	 * 	\anchor	LP_Reposition_input_ports
@@ -91,6 +100,7 @@ public:
 	 * 	\param 	i_landing_achieved		Port for receiving signal indicating that the aircraft has successfully landed.
 	 * 	\param 	i_hover_criteria_met	Port for receiving updates on whether the previously commanded hover was achieved.
 	 * 	\param 	i_lp_new				Port for receiving new valid landing points that should be repositioned to.
+	 * 	\param 	i_lp_ranking			Port for receiving the landing point candidates from best to worst.
 	 * 	\param 	i_pilot_takeover		Port for receiving signal indicating that the pilot has taken control from the supervisor.
 	 * 	\param 	i_start_mission			Port for receiving signal indicating the mission has started.
 	 */
@@ -100,6 +110,7 @@ public:
 		typeid(defs::i_hover_criteria_met),
 		typeid(defs::i_landing_achieved),
 		typeid(defs::i_lp_new),
+		typeid(defs::i_lp_ranking),
 		typeid(defs::i_pilot_takeover),
 		typeid(defs::i_start_mission)
 	};
@@ -116,6 +127,8 @@ public:
 	 * 	\param 	o_request_aircraft_state		Port for requesting the current aircraft state.
 	 * 	\param 	o_set_mission_monitor_status	Port for telling the mission monitor to stop monitoring mission progress.
 	 * 	\param 	o_stabilize						Port for requesting the helicopter hover at a specific location.
+	 * 	\param 	o_stream_aircraft_state			Port for starting and stopping the aircraft state stream.
+	 * 	\param 	o_touchdown_prediction			Port for sending the time in seconds until the predicted touchdown.
 	 * 	\param 	o_update_boss					Port for sending updates to BOSS.
 	 * 	\param 	o_update_gcs					Port for sending updates to the GCS.
 	 * 	\param 	o_update_mission_item			Port for updating the mission manager that the last mission item has been reached.
@@ -129,6 +142,8 @@ public:
 		typeid(defs::o_request_aircraft_state),
 		typeid(defs::o_set_mission_monitor_status),
 		typeid(defs::o_stabilize),
+		typeid(defs::o_stream_aircraft_state),
+		typeid(defs::o_touchdown_prediction),
 		typeid(defs::o_update_boss),
 		typeid(defs::o_update_gcs),
 		typeid(defs::o_update_mission_item)
@@ -141,11 +156,13 @@ public:
 	 * 	\param 	landing_routine		Model for behaviour when attempting to land.
 	 *	\param 	command_reposition	Model for behaviour when repositioning to a landing point.
 	 *	\param 	reposition_timer	Model for behaviour when new landing points are received.
+	 *	\param 	touchdown_estimator	Model for predicting the touchdown while landing.
 	 */
  	cadmium::dynamic::modeling::Models submodels = {
 		landing_routine,
 		command_reposition,
-		reposition_timer
+		reposition_timer,
+		touchdown_estimator
 	};
 
 	/**
@@ -154,11 +171,11 @@ public:
 	 * 	\see 	LP_Reposition
 	 */
  	cadmium::dynamic::modeling::EICs eics = {
-		cadmium::dynamic::translate::make_EIC<defs::i_landing_achieved, Landing_Routine<TIME>::defs::i_landing_achieved>("landing_routine"),
 		cadmium::dynamic::translate::make_EIC<defs::i_pilot_takeover, Landing_Routine<TIME>::defs::i_pilot_takeover>("landing_routine"),
 		cadmium::dynamic::translate::make_EIC<defs::i_start_mission, Landing_Routine<TIME>::defs::i_start_mission>("landing_routine"),
 
 		cadmium::dynamic::translate::make_EIC<defs::i_hover_criteria_met, Command_Reposition<TIME>::defs::i_hover_criteria_met>("command_reposition"),
+		cadmium::dynamic::translate::make_EIC<defs::i_lp_ranking, Command_Reposition<TIME>::defs::i_lp_ranking>("command_reposition"),
 		cadmium::dynamic::translate::make_EIC<defs::i_pilot_takeover, Command_Reposition<TIME>::defs::i_pilot_takeover>("command_reposition"),
 		cadmium::dynamic::translate::make_EIC<defs::i_aircraft_state, Command_Reposition<TIME>::defs::i_aircraft_state>("command_reposition"),
 		cadmium::dynamic::translate::make_EIC<defs::i_start_mission, Command_Reposition<TIME>::defs::i_start_mission>("command_reposition"),
@@ -166,7 +183,12 @@ public:
 		cadmium::dynamic::translate::make_EIC<defs::i_pilot_takeover, Reposition_Timer<TIME>::defs::i_pilot_takeover>("reposition_timer"),
 		cadmium::dynamic::translate::make_EIC<defs::i_control_yielded, Reposition_Timer<TIME>::defs::i_control_yielded>("reposition_timer"),
 		cadmium::dynamic::translate::make_EIC<defs::i_lp_new, Reposition_Timer<TIME>::defs::i_lp_new>("reposition_timer"),
-		cadmium::dynamic::translate::make_EIC<defs::i_start_mission, Reposition_Timer<TIME>::defs::i_start_mission>("reposition_timer")
+		cadmium::dynamic::translate::make_EIC<defs::i_start_mission, Reposition_Timer<TIME>::defs::i_start_mission>("reposition_timer"),
+
+		cadmium::dynamic::translate::make_EIC<defs::i_aircraft_state, Touchdown_Estimator<TIME>::defs::i_aircraft_state>("touchdown_estimator"),
+		cadmium::dynamic::translate::make_EIC<defs::i_landing_achieved, Touchdown_Estimator<TIME>::defs::i_landing_achieved>("touchdown_estimator"),
+		cadmium::dynamic::translate::make_EIC<defs::i_pilot_takeover, Touchdown_Estimator<TIME>::defs::i_pilot_takeover>("touchdown_estimator"),
+		cadmium::dynamic::translate::make_EIC<defs::i_start_mission, Touchdown_Estimator<TIME>::defs::i_start_mission>("touchdown_estimator")
 	};
 
 	/**
@@ -195,7 +217,10 @@ public:
 		cadmium::dynamic::translate::make_EOC<Reposition_Timer<TIME>::defs::o_cancel_hover, defs::o_cancel_hover>("reposition_timer"),
 		cadmium::dynamic::translate::make_EOC<Reposition_Timer<TIME>::defs::o_pilot_handover, defs::o_pilot_handover>("reposition_timer"),
 		cadmium::dynamic::translate::make_EOC<Reposition_Timer<TIME>::defs::o_update_boss, defs::o_update_boss>("reposition_timer"),
-		cadmium::dynamic::translate::make_EOC<Reposition_Timer<TIME>::defs::o_update_gcs, defs::o_update_gcs>("reposition_timer")
+		cadmium::dynamic::translate::make_EOC<Reposition_Timer<TIME>::defs::o_update_gcs, defs::o_update_gcs>("reposition_timer"),
+
+		cadmium::dynamic::translate::make_EOC<Touchdown_Estimator<TIME>::defs::o_stream_aircraft_state, defs::o_stream_aircraft_state>("touchdown_estimator"),
+		cadmium::dynamic::translate::make_EOC<Touchdown_Estimator<TIME>::defs::o_touchdown_prediction, defs::o_touchdown_prediction>("touchdown_estimator")
 	};
 
 	/**
@@ -210,7 +235,13 @@ public:
 		// reposition_timer
 		cadmium::dynamic::translate::make_IC<Reposition_Timer<TIME>::defs::o_land, Landing_Routine<TIME>::defs::i_land>("reposition_timer", "landing_routine"),
 		cadmium::dynamic::translate::make_IC<Reposition_Timer<TIME>::defs::o_pilot_handover, Command_Reposition<TIME>::defs::i_pilot_handover>("reposition_timer", "command_reposition"),
-		cadmium::dynamic::translate::make_IC<Reposition_Timer<TIME>::defs::o_request_reposition, Command_Reposition<TIME>::defs::i_request_reposition>("reposition_timer", "command_reposition")
+		cadmium::dynamic::translate::make_IC<Reposition_Timer<TIME>::defs::o_request_reposition, Command_Reposition<TIME>::defs::i_request_reposition>("reposition_timer", "command_reposition"),
+
+		// landing_routine
+		cadmium::dynamic::translate::make_IC<Landing_Routine<TIME>::defs::o_fcc_command_land, Touchdown_Estimator<TIME>::defs::i_fcc_command_land>("landing_routine", "touchdown_estimator"),
+
+		// touchdown_estimator
+		cadmium::dynamic::translate::make_IC<Touchdown_Estimator<TIME>::defs::o_landing_achieved, Landing_Routine<TIME>::defs::i_landing_achieved>("touchdown_estimator", "landing_routine")
 	};
 };
 
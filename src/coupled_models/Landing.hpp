@@ -18,6 +18,7 @@
 #include "../message_structures/message_fcc_command_t.hpp"
 #include "../message_structures/message_boss_mission_update_t.hpp"
 #include "../message_structures/message_update_gcs_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Atomic model headers
 #include "../atomic_models/LP_Manager.hpp"
@@ -29,6 +30,7 @@
 
 // Utility functions
 #include "../time_conversion.hpp"
+#include "../metered_model.hpp"
 
 // Constants
 #include "../Constants.hpp"
@@ -80,15 +82,17 @@ public:
 		struct o_notify_pilot : public cadmium::out_port<bool> {};
 		struct o_request_aircraft_state : public cadmium::out_port<bool> {};
 		struct o_set_mission_monitor_status : public cadmium::out_port<uint8_t> {};
-		struct o_update_boss : public cadmium::out_port<message_boss_mission_update_t> {};
+		struct o_stream_aircraft_state : public cadmium::out_port<bool> {};
+		struct o_touchdown_prediction : public cadmium::out_port<double> {};
+		struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 		struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
 		struct o_update_mission_item : public cadmium::out_port<bool> {};
 	};
 
 	// Instantiate the Atomic models.
-	std::shared_ptr<cadmium::dynamic::modeling::model> lp_manager = cadmium::dynamic::translate::make_dynamic_atomic_model<LP_Manager, TIME, TIME, TIME>("lp_manager", seconds_to_time<TIME>(LP_ACCEPT_TIMER), seconds_to_time<TIME>(ORBIT_TIMER));
-	std::shared_ptr<cadmium::dynamic::modeling::model> stabilize = cadmium::dynamic::translate::make_dynamic_atomic_model<Stabilize, TIME>("stabilize");
-	std::shared_ptr<cadmium::dynamic::modeling::model> handover_control = cadmium::dynamic::translate::make_dynamic_atomic_model<Handover_Control, TIME>("handover_control");
+	std::shared_ptr<cadmium::dynamic::modeling::model> lp_manager = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<LP_Manager>::model, TIME, TIME, TIME>("lp_manager", seconds_to_time<TIME>(LP_ACCEPT_TIMER), seconds_to_time<TIME>(ORBIT_TIMER));
+	std::shared_ptr<cadmium::dynamic::modeling::model> stabilize = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Stabilize>::model, TIME, TIME, bool>("stabilize", TIME(STABILIZE_POLLING_RATE), STABILIZE_STREAMING);
+	std::shared_ptr<cadmium::dynamic::modeling::model> handover_control = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Handover_Control>::model, TIME>("handover_control");
 
 	// Instantiate the Coupled models.
 	LP_Reposition lpr = LP_Reposition();
@@ -129,6 +133,8 @@ public:
 	 * 	\param 	o_notify_pilot					Port for notifying the pilot that they should take control of the aircraft.
 	 * 	\param 	o_request_aircraft_state		Port for requesting the current aircraft state.
 	 * 	\param 	o_set_mission_monitor_status	Port for telling the mission monitor to stop monitoring mission progress.
+	 * 	\param 	o_stream_aircraft_state			Port for starting and stopping the aircraft state stream.
+	 * 	\param 	o_touchdown_prediction			Port for sending the time in seconds until the predicted touchdown.
 	 * 	\param 	o_update_boss					Port for sending updates to BOSS.
 	 * 	\param 	o_update_gcs					Port for sending updates to the GCS.
 	 * 	\param 	o_update_mission_item			Port for updating the mission manager that the last mission item has been reached.
@@ -145,6 +151,8 @@ public:
 		typeid(defs::o_notify_pilot),
 		typeid(defs::o_request_aircraft_state),
 		typeid(defs::o_set_mission_monitor_status),
+		typeid(defs::o_stream_aircraft_state),
+		typeid(defs::o_touchdown_prediction),
 		typeid(defs::o_update_boss),
 		typeid(defs::o_update_gcs),
 		typeid(defs::o_update_mission_item)
@@ -218,6 +226,8 @@ public:
 		cadmium::dynamic::translate::make_EOC<LP_Reposition::defs::o_update_boss, defs::o_update_boss>("lp_reposition"),
 		cadmium::dynamic::translate::make_EOC<LP_Reposition::defs::o_update_gcs, defs::o_update_gcs>("lp_reposition"),
 		cadmium::dynamic::translate::make_EOC<LP_Reposition::defs::o_update_mission_item, defs::o_update_mission_item>("lp_reposition"),
+		cadmium::dynamic::translate::make_EOC<LP_Reposition::defs::o_stream_aircraft_state, defs::o_stream_aircraft_state>("lp_reposition"),
+		cadmium::dynamic::translate::make_EOC<LP_Reposition::defs::o_touchdown_prediction, defs::o_touchdown_prediction>("lp_reposition"),
 
 		// handover_control
 		cadmium::dynamic::translate::make_EOC<Handover_Control<TIME>::defs::o_control_yielded, defs::o_control_yielded>("handover_control"),
@@ -226,6 +236,7 @@ public:
 		//stabilize
 		cadmium::dynamic::translate::make_EOC<Stabilize<TIME>::defs::o_fcc_command_hover, defs::o_fcc_command_hover>("stabilize"),
 		cadmium::dynamic::translate::make_EOC<Stabilize<TIME>::defs::o_request_aircraft_state, defs::o_request_aircraft_state>("stabilize"),
+		cadmium::dynamic::translate::make_EOC<Stabilize<TIME>::defs::o_stream_aircraft_state, defs::o_stream_aircraft_state>("stabilize"),
 		cadmium::dynamic::translate::make_EOC<Stabilize<TIME>::defs::o_update_gcs, defs::o_update_gcs>("stabilize")
 	};
 
@@ -237,6 +248,7 @@ public:
 	cadmium::dynamic::modeling::ICs ics = {
 		// lp_manager
 		cadmium::dynamic::translate::make_IC<LP_Manager<TIME>::defs::o_lp_new, LP_Reposition::defs::i_lp_new>("lp_manager","lp_reposition"),
+		cadmium::dynamic::translate::make_IC<LP_Manager<TIME>::defs::o_lp_ranking, LP_Reposition::defs::i_lp_ranking>("lp_manager","lp_reposition"),
 		cadmium::dynamic::translate::make_IC<LP_Manager<TIME>::defs::o_pilot_handover, Handover_Control<TIME>::defs::i_pilot_handover>("lp_manager","handover_control"),
 
 		// lp_reposition
@@ -13,11 +13,17 @@
 #define ON_ROUTE_HPP
 
 // Messages structures
+#include "../message_structures/message_boss_mission_update_t.hpp"
 #include "../message_structures/message_fcc_command_t.hpp"
+#include "../message_structures/message_waypoint_update_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Atomic model headers
 #include "../atomic_models/Handle_Waypoint.hpp"
 
+// Utility functions
+#include "../metered_model.hpp"
+
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
 #include <cadmium/modeling/dynamic_model_translator.hpp>
@@ -48,13 +54,15 @@ public:
 		struct i_pilot_takeover : public cadmium::out_port<bool> {};
 		struct i_start_mission : public cadmium::out_port<int> {};
 		struct i_waypoint : public cadmium::out_port<message_fcc_command_t> {};
+		struct i_waypoint_update : public cadmium::out_port<message_waypoint_update_t> {};
 
 		/***** Define output ports for coupled model *****/
 		struct o_fcc_waypoint_update : public cadmium::out_port<message_fcc_command_t> {};
+		struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 	};
 
 	// Instantiate the Atomic models.
-	std::shared_ptr <cadmium::dynamic::modeling::model> handle_waypoint = cadmium::dynamic::translate::make_dynamic_atomic_model<Handle_Waypoint, TIME>("handle_waypoint");
+	std::shared_ptr <cadmium::dynamic::modeling::model> handle_waypoint = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Handle_Waypoint>::model, TIME>("handle_waypoint");
 
 	/**
 	 * 	\anchor	On_Route_input_ports
@@ -63,11 +71,13 @@ public:
 	 * 	\param 	i_pilot_takeover	Port for signal indicating that the pilot has taken control from the supervisor.
 	 * 	\param 	i_start_mission		Port for receiving signal indicating the mission has started.
 	 * 	\param 	i_waypoint			Port for receiving new waypoints during the on-route phase.
+	 * 	\param 	i_waypoint_update	Port for receiving indexed updates to the waypoints of the route.
 	 */
  	cadmium::dynamic::modeling::Ports iports = {
 			typeid(defs::i_pilot_takeover),
 			typeid(defs::i_start_mission),
-			typeid(defs::i_waypoint)
+			typeid(defs::i_waypoint),
+			typeid(defs::i_waypoint_update)
 	};
 
 	/**
@@ -75,9 +85,11 @@ public:
 	 * 	\par 	Output Ports
 	 * 	Definition of the output ports for the model.
 	 * 	\param 	o_fcc_waypoint_update	Port for sending waypoint commands to the FCC.
+	 * 	\param 	o_update_boss			Port for sending the active waypoint and the waypoint preview to BOSS.
 	 */
  	cadmium::dynamic::modeling::Ports oports = {
-			typeid(defs::o_fcc_waypoint_update)
+			typeid(defs::o_fcc_waypoint_update),
+			typeid(defs::o_update_boss)
 	};
 
 	/**
@@ -99,7 +111,8 @@ public:
 		// handle_waypoint
 		cadmium::dynamic::translate::make_EIC<defs::i_pilot_takeover, Handle_Waypoint<TIME>::defs::i_pilot_takeover>("handle_waypoint"),
 		cadmium::dynamic::translate::make_EIC<defs::i_start_mission, Handle_Waypoint<TIME>::defs::i_start_mission>("handle_waypoint"),
-		cadmium::dynamic::translate::make_EIC<defs::i_waypoint, Handle_Waypoint<TIME>::defs::i_waypoint>("handle_waypoint")
+		cadmium::dynamic::translate::make_EIC<defs::i_waypoint, Handle_Waypoint<TIME>::defs::i_waypoint>("handle_waypoint"),
+		cadmium::dynamic::translate::make_EIC<defs::i_waypoint_update, Handle_Waypoint<TIME>::defs::i_waypoint_update>("handle_waypoint")
 	};
 
 	/**
@@ -110,6 +123,7 @@ public:
  	cadmium::dynamic::modeling::EOCs eocs = {
 		 // handle_waypoint
 		 cadmium::dynamic::translate::make_EOC<Handle_Waypoint<TIME>::defs::o_fcc_waypoint_update, defs::o_fcc_waypoint_update>("handle_waypoint"),
+		 cadmium::dynamic::translate::make_EOC<Handle_Waypoint<TIME>::defs::o_update_boss, defs::o_update_boss>("handle_waypoint"),
 	};
 
 	/**
@@ -18,6 +18,8 @@
 #include "../message_structures/message_landing_point_t.hpp"
 #include "../message_structures/message_start_supervisor_t.hpp"
 #include "../message_structures/message_update_gcs_t.hpp"
+#include "../message_structures/message_waypoint_update_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Coupled model headers
 #include "Takeoff.hpp"
@@ -58,6 +60,7 @@ public:
 		struct i_PLP_ach : public cadmium::in_port<message_landing_point_t> {};
 		struct i_start_supervisor : public cadmium::in_port<message_start_supervisor_t> {};
 		struct i_waypoint : public cadmium::in_port<message_fcc_command_t> {};
+		struct i_waypoint_update : public cadmium::in_port<message_waypoint_update_t> {};
 
 		/***** Define output ports for coupled model *****/
 		struct o_control_yielded : public cadmium::out_port<bool> {};
@@ -73,7 +76,9 @@ public:
 		struct o_request_aircraft_state : public cadmium::out_port<bool> {};
 		struct o_set_mission_monitor_status : public cadmium::out_port<uint8_t> {};
 		struct o_start_mission : public cadmium::out_port<int> {};
-		struct o_update_boss : public cadmium::out_port<message_boss_mission_update_t> {};
+		struct o_stream_aircraft_state : public cadmium::out_port<bool> {};
+		struct o_touchdown_prediction : public cadmium::out_port<double> {};
+		struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 		struct o_update_gcs : public cadmium::out_port<message_update_gcs_t> {};
 		struct o_update_mission_item : public cadmium::out_port<bool> {};
 	};
@@ -99,6 +104,7 @@ public:
 	 * 	\param 	i_PLP_ach			Port for receiving signal indicating that the planned landing point has been achieved.
 	 * 	\param 	i_start_supervisor	Port for receiving signal indicating the mission has started.
 	 * 	\param 	i_waypoint			Port for receiving new waypoints during the on-route phase.
+	 * 	\param 	i_waypoint_update	Port for receiving indexed updates to the waypoints of the route.
 	 */
  	cadmium::dynamic::modeling::Ports iports = {
 		typeid(defs::i_aircraft_state),
@@ -108,7 +114,8 @@ public:
 		typeid(defs::i_pilot_takeover),
 		typeid(defs::i_PLP_ach),
 		typeid(defs::i_start_supervisor),
-		typeid(defs::i_waypoint)
+		typeid(defs::i_waypoint),
+		typeid(defs::i_waypoint_update)
 	};
 
 	/**
@@ -128,6 +135,8 @@ public:
 	 * 	\param 	o_request_aircraft_state		Port for requesting the current aircraft state.
 	 * 	\param 	o_set_mission_monitor_status	Port for telling the mission monitor to stop monitoring mission progress.
 	 * 	\param 	o_start_mission					Port for sending a notification that the mission has started.
+	 * 	\param 	o_stream_aircraft_state			Port for starting and stopping the aircraft state stream.
+	 * 	\param 	o_touchdown_prediction			Port for sending the time in seconds until the predicted touchdown.
 	 * 	\param 	o_update_boss					Port for sending updates to BOSS.
 	 * 	\param 	o_update_gcs					Port for sending updates to the GCS.
 	 * 	\param 	o_update_mission_item			Port for updating the mission manager that the last mission item has been reached.
@@ -146,6 +155,8 @@ public:
 		typeid(defs::o_request_aircraft_state),
 		typeid(defs::o_set_mission_monitor_status),
 		typeid(defs::o_start_mission),
+		typeid(defs::o_stream_aircraft_state),
+		typeid(defs::o_touchdown_prediction),
 		typeid(defs::o_update_boss),
 		typeid(defs::o_update_gcs),
 		typeid(defs::o_update_mission_item)
@@ -178,6 +189,7 @@ public:
 
 		// on_route
 		cadmium::dynamic::translate::make_EIC<defs::i_waypoint, On_Route::defs::i_waypoint>("on_route"),
+		cadmium::dynamic::translate::make_EIC<defs::i_waypoint_update, On_Route::defs::i_waypoint_update>("on_route"),
 		cadmium::dynamic::translate::make_EIC<defs::i_pilot_takeover, On_Route::defs::i_pilot_takeover>("on_route"),
 
 		// landing
@@ -202,6 +214,7 @@ public:
 
 		// on_route
 		cadmium::dynamic::translate::make_EOC<On_Route::defs::o_fcc_waypoint_update, defs::o_fcc_waypoint_update>("on_route"),
+		cadmium::dynamic::translate::make_EOC<On_Route::defs::o_update_boss, defs::o_update_boss>("on_route"),
 
 		// landing
 		cadmium::dynamic::translate::make_EOC<Landing::defs::o_request_aircraft_state, defs::o_request_aircraft_state>("landing"),
@@ -217,7 +230,9 @@ public:
 		cadmium::dynamic::translate::make_EOC<Landing::defs::o_update_boss, defs::o_update_boss>("landing"),
 		cadmium::dynamic::translate::make_EOC<Landing::defs::o_update_gcs, defs::o_update_gcs>("landing"),
 		cadmium::dynamic::translate::make_EOC<Landing::defs::o_set_mission_monitor_status, defs::o_set_mission_monitor_status>("landing"),
-		cadmium::dynamic::translate::make_EOC<Landing::defs::o_update_mission_item, defs::o_update_mission_item>("landing")
+		cadmium::dynamic::translate::make_EOC<Landing::defs::o_update_mission_item, defs::o_update_mission_item>("landing"),
+		cadmium::dynamic::translate::make_EOC<Landing::defs::o_stream_aircraft_state, defs::o_stream_aircraft_state>("landing"),
+		cadmium::dynamic::translate::make_EOC<Landing::defs::o_touchdown_prediction, defs::o_touchdown_prediction>("landing")
 	};
 
 	/**
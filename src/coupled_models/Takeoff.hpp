@@ -23,6 +23,9 @@
 //Atomic model headers
 #include "../atomic_models/Mission_Initialization.hpp"
 
+// Utility functions
+#include "../metered_model.hpp"
+
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
 #include <cadmium/modeling/dynamic_model_translator.hpp>
@@ -62,8 +65,8 @@ public:
 	};
 
 	// Instantiate the Atomic models.
-	std::shared_ptr <cadmium::dynamic::modeling::model> mission_initialization = cadmium::dynamic::translate::make_dynamic_atomic_model<Mission_Initialization, TIME>("mission_initialization");
-	std::shared_ptr <cadmium::dynamic::modeling::model> cache_input = cadmium::dynamic::translate::make_dynamic_atomic_model<Cache_Input_Boolean, TIME, bool>("cache_input", false);
+	std::shared_ptr <cadmium::dynamic::modeling::model> mission_initialization = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Mission_Initialization>::model, TIME>("mission_initialization");
+	std::shared_ptr <cadmium::dynamic::modeling::model> cache_input = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Cache_Input_Boolean>::model, TIME, bool>("cache_input", false);
 
 	/**
 	 * 	\anchor	Takeoff_input_ports
@@ -0,0 +1,249 @@
+/**
+ * 	\file		Vehicle.hpp
+ *	\brief		Definition of the Vehicle coupled model.
+ *	\details	This header file defines the Vehicle coupled model for use in the Cadmium DEVS
+				simulation software. The model represents a single aircraft, made up of the Supervisor
+				and the models it uses to communicate with the aircraft systems.
+ */
+
+#ifndef VEHICLE_HPP
+#define VEHICLE_HPP
+
+// IO model headers
+#include "../io_models/Supervisor_UDP_Input.hpp"
+#include "../io_models/Aircraft_State_Input.hpp"
+#include "../io_models/Polling_Condition_Input.hpp"
+#include "../io_models/Packet_Builder.hpp"
+#include "../io_models/UDP_Output.hpp"
+#include "../io_models/RUDP_Output.hpp"
+#include "../io_models/GPS_Time.hpp"
+
+// Coupled model headers
+#include "Supervisor.hpp"
+
+// Constants
+#include "../Constants.hpp"
+
+// Utility functions
+#include "../aircraft_state_source.hpp"
+#include "../metered_model.hpp"
+
+// System Libraries
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+
+// Time Class Header
+#include <NDTime.hpp>
+
+/**
+ * 	\class		Vehicle
+ *	\brief		Definition of the Vehicle coupled model.
+ *	\details	This class defines the Vehicle coupled model for use in the Cadmium DEVS
+				simulation software. The model connects the Supervisor to its inputs and outputs.
+				Every port the vehicle listens on or sends to is offset by the port offset so that
+				several vehicles can run in the same process without their sockets colliding, and the
+				aircraft state is read from the source of the vehicle so that each vehicle can fly its
+				own aircraft. The inputs received over the network can also be given on the input ports
+				of the vehicle, which is how tests and benchmarks drive it without a mission manager.
+ */
+class Vehicle {
+	using TIME = NDTime;
+
+public:
+	/**
+	 * \brief 	Constructor for the model with parameters for the offset of its ports and the source of its aircraft state.
+	 * \param	i_port_offset	unsigned short offset added to every port of the vehicle.
+	 * \param	i_state_source	std::shared_ptr<Aircraft_State_Source> source of the aircraft state, the shared memory by default.
+	 */
+	explicit Vehicle(unsigned short i_port_offset = 0, std::shared_ptr<Aircraft_State_Source> i_state_source = Shared_Memory_State_Source::instance())
+			: port_offset(i_port_offset), state_source(std::move(i_state_source)) {}
+
+	struct defs {
+		/***** Define input ports for coupled model *****/
+		struct i_LP_recv : public cadmium::in_port<message_landing_point_t> {};
+		struct i_perception_status : public cadmium::in_port<bool> {};
+		struct i_PLP_ach : public cadmium::in_port<message_landing_point_t> {};
+		struct i_start_supervisor : public cadmium::in_port<message_start_supervisor_t> {};
+		struct i_waypoint : public cadmium::in_port<message_fcc_command_t> {};
+		struct i_waypoint_update : public cadmium::in_port<message_waypoint_update_t> {};
+
+		/***** Define output ports for coupled model *****/
+		struct o_fcc_packet : public cadmium::out_port<std::vector<char>> {};
+	};
+
+private:
+	/// Variable for storing the offset added to every port of the vehicle.
+	unsigned short port_offset;
+	/// Variable for storing the source of the aircraft state read by the input models, declared before them.
+	std::shared_ptr<Aircraft_State_Source> state_source;
+
+	/// Function for offsetting a port by the port offset of the vehicle, throwing std::out_of_range if it is past 65535.
+	unsigned short port(unsigned short base_port) const {
+		long offset_port = static_cast<long>(base_port) + port_offset;
+		if (offset_port > std::numeric_limits<unsigned short>::max()) {
+			throw(std::out_of_range("Port offset " + std::to_string(port_offset) + " takes port " + std::to_string(base_port) + " past 65535"));
+		}
+		return static_cast<unsigned short>(offset_port);
+	}
+
+	// Instantiate the Supervisor.
+	Supervisor supervisor_instance;
+	std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> supervisor = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>("supervisor", supervisor_instance.submodels, supervisor_instance.iports, supervisor_instance.oports, supervisor_instance.eics, supervisor_instance.eocs, supervisor_instance.ics);
+
+	// Instantiate the input readers.
+	std::shared_ptr<cadmium::dynamic::modeling::model> im_udp_interface = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Supervisor_UDP_Input>::model, TIME, TIME, unsigned short>("im_udp_interface", TIME("00:00:00:100"), port(PORT_SUPERVISOR));
+	std::shared_ptr<cadmium::dynamic::modeling::model> im_aircraft_state = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Aircraft_State_Input>::model, TIME, TIME, std::shared_ptr<Aircraft_State_Source>>("im_aircraft_state", TIME(AIRCRAFT_STATE_STREAM_PERIOD), std::shared_ptr<Aircraft_State_Source>(state_source));
+	std::shared_ptr<cadmium::dynamic::modeling::model> im_landing_achieved = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Polling_Condition_Input_Landing_Achieved>::model, TIME, TIME, float, std::shared_ptr<Aircraft_State_Source>>("im_landing_achieved", TIME("00:00:00:100"), DEFAULT_LAND_CRITERIA_VERT_DIST, std::shared_ptr<Aircraft_State_Source>(state_source));
+	std::shared_ptr<cadmium::dynamic::modeling::model> im_pilot_takeover = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Polling_Condition_Input_Pilot_Takeover>::model, TIME, TIME, std::shared_ptr<Aircraft_State_Source>>("im_pilot_takeover", TIME("00:00:01:000"), std::shared_ptr<Aircraft_State_Source>(state_source));
+
+    // Instantiate the Packet Builders.
+	std::shared_ptr<cadmium::dynamic::modeling::model> pb_bool_mission_complete = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_Bool>::model, TIME, uint8_t>("pb_bool_mission_complete", SIG_ID_MISSION_COMPLETE);
+    std::shared_ptr<cadmium::dynamic::modeling::model> pb_int_mission_start = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_Int>::model, TIME, uint8_t>("pb_int_mission_start", SIG_ID_START_MISSION);
+    std::shared_ptr<cadmium::dynamic::modeling::model> pb_bool_update_mission_item = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_Bool>::model, TIME, uint8_t>("pb_bool_update_mission_item", SIG_ID_MISSION_ITEM_REACHED);
+    std::shared_ptr<cadmium::dynamic::modeling::model> pb_uint8_set_mission_monitor_status = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_Uint8>::model, TIME, uint8_t>("pb_uint8_set_mission_monitor_status", SIG_ID_SET_MISSION_MONITOR_STATUS);
+
+    std::shared_ptr<cadmium::dynamic::modeling::model> pb_boss = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_Boss>::model, TIME>("pb_boss");
+    std::shared_ptr<cadmium::dynamic::modeling::model> pb_fcc = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_Fcc>::model, TIME>("pb_fcc");
+    std::shared_ptr<cadmium::dynamic::modeling::model> pb_gcs = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_GCS>::model, TIME>("pb_gcs");
+    std::shared_ptr<cadmium::dynamic::modeling::model> pb_landing_point = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<Packet_Builder_Landing_Point>::model, TIME>("pb_landing_point");
+
+    std::shared_ptr<cadmium::dynamic::modeling::model> udp_boss = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<UDP_Output>::model, TIME, const char *, const unsigned short, bool>("udp_boss", IPV4_BOSS, port(PORT_BOSS), true);
+    std::shared_ptr<cadmium::dynamic::modeling::model> udp_fcc = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<UDP_Output>::model, TIME, const char *, const unsigned short, bool>("udp_fcc", IPV4_FCC, port(PORT_FCC), true);
+    std::shared_ptr<cadmium::dynamic::modeling::model> udp_gcs = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<UDP_Output>::model, TIME, const char *, const unsigned short, bool>("udp_gcs", IPV4_GCS, port(PORT_GCS), false);
+    std::shared_ptr<cadmium::dynamic::modeling::model> udp_gcs_broadcast = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<UDP_Output>::model, TIME, const char *, const unsigned short, bool>("udp_gcs_broadcast", IPV4_QGC_BROADCAST, port(PORT_QGC_BROADCAST), true);
+    std::shared_ptr<cadmium::dynamic::modeling::model> rudp_mavnrc = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<RUDP_Output>::model, TIME, const char *, const unsigned short, int, int>("rudp_mavnrc", IPV4_MAVNRC, port(PORT_MAVNRC), DEFAULT_TIMEOUT_MS, 10);
+
+    // Instantiate GPS time logger
+	std::shared_ptr<cadmium::dynamic::modeling::model> gps_time = cadmium::dynamic::translate::make_dynamic_atomic_model<Metered<GPS_Time>::model, TIME>("a_gps_time");
+
+    // The models to be included in this coupled model
+	// (accepts atomic and coupled models)
+public:
+	/**
+	 *	\brief	Definition of the submodels and couplings of the vehicle.
+	 *	\note	The input ports of the vehicle are only used when it is not driven over the network, and its output port
+	 *			is only coupled when its aircraft is emulated.
+	 */
+ 	cadmium::dynamic::modeling::Models submodels = {
+            supervisor,
+            im_landing_achieved,
+            im_aircraft_state,
+            im_pilot_takeover,
+            im_udp_interface,
+            pb_bool_mission_complete,
+            pb_int_mission_start,
+			pb_bool_update_mission_item,
+            pb_uint8_set_mission_monitor_status,
+            pb_boss,
+            pb_fcc,
+            pb_gcs,
+            pb_landing_point,
+            udp_boss,
+            udp_fcc,
+            udp_gcs,
+			udp_gcs_broadcast,
+            gps_time,
+            rudp_mavnrc
+	};
+
+	/**
+	 * 	\anchor	Vehicle_input_ports
+	 *	\par	Input Ports
+	 * 	Definition of the input ports for the model, which are forwarded to the Supervisor alongside the inputs received over the network.
+	 * 	\param 	i_LP_recv			Port for receiving landing points from the perception system.
+	 * 	\param 	i_perception_status	Port for receiving the status of the perception system.
+	 * 	\param 	i_PLP_ach			Port for receiving signal indicating that the planned landing point has been achieved.
+	 * 	\param 	i_start_supervisor	Port for receiving signal indicating the mission has started.
+	 * 	\param 	i_waypoint			Port for receiving new waypoints during the on-route phase.
+	 * 	\param 	i_waypoint_update	Port for receiving indexed updates to the waypoints of the route.
+	 */
+ 	cadmium::dynamic::modeling::Ports iports = {
+		typeid(defs::i_LP_recv),
+		typeid(defs::i_perception_status),
+		typeid(defs::i_PLP_ach),
+		typeid(defs::i_start_supervisor),
+		typeid(defs::i_waypoint),
+		typeid(defs::i_waypoint_update)
+	};
+
+	/**
+	 *	\anchor	Vehicle_output_ports
+	 * 	\par 	Output Ports
+	 * 	Definition of the output ports for the model.
+	 * 	\param 	o_fcc_packet	Port for sending the FCC packets, which are also sent to the FCC over the network, to an emulated aircraft.
+	 */
+ 	cadmium::dynamic::modeling::Ports oports = {
+		typeid(defs::o_fcc_packet)
+	};
+
+ 	cadmium::dynamic::modeling::EICs eics = {
+		cadmium::dynamic::translate::make_EIC<defs::i_LP_recv, Supervisor::defs::i_LP_recv>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_perception_status, Supervisor::defs::i_perception_status>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_PLP_ach, Supervisor::defs::i_PLP_ach>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_start_supervisor, Supervisor::defs::i_start_supervisor>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_waypoint, Supervisor::defs::i_waypoint>("supervisor"),
+		cadmium::dynamic::translate::make_EIC<defs::i_waypoint_update, Supervisor::defs::i_waypoint_update>("supervisor")
+	};
+
+ 	cadmium::dynamic::modeling::EOCs eocs = {
+		cadmium::dynamic::translate::make_EOC<Packet_Builder_Fcc<TIME>::defs::o_packet, defs::o_fcc_packet>("pb_fcc")
+	};
+
+ 	cadmium::dynamic::modeling::ICs ics = {
+		cadmium::dynamic::translate::make_IC<Polling_Condition_Input_Landing_Achieved<TIME>::defs::o_message, Supervisor::defs::i_landing_achieved>("im_landing_achieved", "supervisor"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_land, Polling_Condition_Input_Landing_Achieved<TIME>::defs::i_start>("supervisor", "im_landing_achieved"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_mission_complete, Polling_Condition_Input_Landing_Achieved<TIME>::defs::i_quit>("supervisor", "im_landing_achieved"),
+
+		cadmium::dynamic::translate::make_IC<Aircraft_State_Input<TIME>::defs::o_message, Supervisor::defs::i_aircraft_state>("im_aircraft_state", "supervisor"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_request_aircraft_state, Aircraft_State_Input<TIME>::defs::i_request>("supervisor", "im_aircraft_state"),
+		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_stream_aircraft_state, Aircraft_State_Input<TIME>::defs::i_stream>("supervisor", "im_aircraft_state"),
+
+		cadmium::dynamic::translate::make_IC<Polling_Condition_Input_Pilot_Takeover<TIME>::defs::o_message, Supervisor::defs::i_pilot_takeover>("im_pilot_takeover", "supervisor"),
+		// cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_start_supervisor, Polling_Condition_Input_Pilot_Takeover<TIME>::defs::i_start>("im_udp_interface", "im_pilot_takeover"),
+		// cadmium::dynamic::translate::make_IC<Supervisor::defs::o_mission_complete, Polling_Condition_Input_Pilot_Takeover<TIME>::defs::i_quit>("supervisor", "im_pilot_takeover"),
+
+		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_lp_recv, Supervisor::defs::i_LP_recv>("im_udp_interface", "supervisor"),
+		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_plp_ach, Supervisor::defs::i_PLP_ach>("im_udp_interface", "supervisor"),
+		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_perception_status, Supervisor::defs::i_perception_status>("im_udp_interface", "supervisor"),
+		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_start_supervisor, Supervisor::defs::i_start_supervisor>("im_udp_interface", "supervisor"),
+		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_waypoint, Supervisor::defs::i_waypoint>("im_udp_interface", "supervisor"),
+		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_waypoint_update, Supervisor::defs::i_waypoint_update>("im_udp_interface", "supervisor"),
+		// cadmium::dynamic::translate::make_IC<Supervisor::defs::o_mission_complete, Supervisor_UDP_Input<TIME>::defs::i_quit>("supervisor", "im_udp_interface"),
+
+		// Output ICs
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_LP_new, Packet_Builder_Landing_Point<TIME>::defs::i_data>("supervisor", "pb_landing_point"),
+
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_start_mission, Packet_Builder_Int<TIME>::defs::i_data>("supervisor", "pb_int_mission_start"),
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_mission_complete, Packet_Builder_Bool<TIME>::defs::i_data>("supervisor", "pb_bool_mission_complete"),
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_update_mission_item, Packet_Builder_Bool<TIME>::defs::i_data>("supervisor", "pb_bool_update_mission_item"),
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_set_mission_monitor_status, Packet_Builder_Uint8<TIME>::defs::i_data>("supervisor", "pb_uint8_set_mission_monitor_status"),
+
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_update_boss, Packet_Builder_Boss<TIME>::defs::i_data>("supervisor", "pb_boss"),
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_update_gcs, Packet_Builder_GCS<TIME>::defs::i_data>("supervisor", "pb_gcs"),
+
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_hover, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_land, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_orbit, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_velocity, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_waypoint_update, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
+
+        cadmium::dynamic::translate::make_IC<Packet_Builder_Boss<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("pb_boss", "udp_boss"),
+        cadmium::dynamic::translate::make_IC<Packet_Builder_Fcc<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("pb_fcc", "udp_fcc"),
+        cadmium::dynamic::translate::make_IC<Packet_Builder_GCS<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("pb_gcs", "udp_gcs"),
+        cadmium::dynamic::translate::make_IC<Packet_Builder_GCS<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("pb_gcs", "udp_gcs_broadcast"),
+
+        cadmium::dynamic::translate::make_IC<Packet_Builder_Int<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_int_mission_start", "rudp_mavnrc"),
+        cadmium::dynamic::translate::make_IC<Packet_Builder_Bool<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_bool_mission_complete", "rudp_mavnrc"),
+        cadmium::dynamic::translate::make_IC<Packet_Builder_Bool<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_bool_update_mission_item", "rudp_mavnrc"),
+        cadmium::dynamic::translate::make_IC<Packet_Builder_Uint8<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_uint8_set_mission_monitor_status", "rudp_mavnrc"),
+        cadmium::dynamic::translate::make_IC<Packet_Builder_Landing_Point<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_landing_point", "rudp_mavnrc"),
+	};
+};
+
+#endif // VEHICLE_HPP
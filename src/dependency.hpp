@@ -0,0 +1,140 @@
+/**
+ * 	\file		dependency.hpp
+ *	\brief		Definition of the external dependencies of the Supervisor.
+ *	\details	This header file defines how the Supervisor connects to the resources it depends on, such
+				as shared memory and network connections. Connecting is retried with a backoff, so that a
+				dependency that is not available yet delays the models that need it instead of stopping the
+				Supervisor from starting.
+ */
+
+#ifndef DEPENDENCY_HPP
+#define DEPENDENCY_HPP
+
+// Utility functions
+#include "startup_profile.hpp"
+
+// Constants
+#include "Constants.hpp"
+
+// System Libraries
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ *	\brief 		Function retry_with_backoff is used to connect to a dependency, retrying until it succeeds.
+ *	\details	The wait between attempts starts at DEPENDENCY_RETRY_MIN_MS and doubles after every failed
+ * 				attempt up to DEPENDENCY_RETRY_MAX_MS. The first failure is reported, and the connection is
+ * 				marked in the startup profile once it succeeds.
+ * 	\param		name	Name of the dependency.
+ * 	\param		attempt	Function making one attempt to connect, returning true once connected.
+ * 	\param		stop	Function returning true when the attempts should stop, checked between attempts.
+ * 	\param		wait	Function waiting for a duration between attempts, returning early if stopped.
+ * 	\return		true if the dependency connected, false if the attempts were stopped.
+ */
+inline bool retry_with_backoff(const std::string& name, const std::function<bool()>& attempt, const std::function<bool()>& stop,
+							   const std::function<void(std::chrono::milliseconds)>& wait = [](std::chrono::milliseconds delay) { std::this_thread::sleep_for(delay); }) {
+	std::chrono::milliseconds delay(DEPENDENCY_RETRY_MIN_MS);
+	for (unsigned int attempts = 1; !stop(); attempts++) {
+		bool connected = false;
+		try {
+			connected = attempt();
+		}
+		catch (std::exception& error) {
+			if (attempts == 1) {
+				std::cout << "[Dependency] (WARNING) " << name << ": " << error.what() << std::endl;
+			}
+		}
+		if (connected) {
+			Startup_Profile::instance().mark(name + " connected");
+			if (attempts > 1) {
+				std::cout << "[Dependency] (INFO) Connected to " << name << " after " << attempts << " attempts." << std::endl;
+			}
+			return true;
+		}
+		if (attempts == 1) {
+			std::cout << "[Dependency] (WARNING) Could not connect to " << name << ", retrying in the background." << std::endl;
+		}
+		wait(delay);
+		delay = std::min(delay * 2, std::chrono::milliseconds(DEPENDENCY_RETRY_MAX_MS));
+	}
+	return false;
+}
+
+/**
+ * 	\class		Dependency
+ *	\brief		Definition of a dependency connected in the background.
+ *	\details	This class connects to a dependency in its own thread, retrying with a backoff, so that
+				every dependency of the Supervisor connects in parallel with the others and with the
+				building of the models. The models check whether the dependency is ready before using it
+				and wait in a degraded state until it is.
+ */
+class Dependency {
+public:
+	/**
+	 * \brief 	Constructor for the dependency, which starts connecting immediately.
+	 * \param	name		Name of the dependency.
+	 * \param	connect		Function making one attempt to connect, returning true once connected.
+	 * \param	disconnect	Function disconnecting the dependency once connected.
+	 */
+	Dependency(std::string name, std::function<bool()> connect, std::function<void()> disconnect = [] {})
+			: name(std::move(name)), connect(std::move(connect)), disconnect(std::move(disconnect)) {
+		worker = std::thread([this] {
+			std::unique_lock<std::mutex> lock(stop_mutex, std::defer_lock);
+			bool connected = retry_with_backoff(this->name, [this] { return this->connect(); }, [this] { return stopping.load(); },
+				[this, &lock](std::chrono::milliseconds delay) {
+					lock.lock();
+					stop_condition.wait_for(lock, delay, [this] { return stopping.load(); });
+					lock.unlock();
+				});
+			ready_flag.store(connected, std::memory_order_release);
+		});
+	}
+
+	Dependency(const Dependency&) = delete;
+	Dependency& operator=(const Dependency&) = delete;
+
+	/// Destructor which stops connecting, waits for the thread and disconnects the dependency.
+	~Dependency() {
+		{
+			std::lock_guard<std::mutex> lock(stop_mutex);
+			stopping = true;
+		}
+		stop_condition.notify_all();
+		if (worker.joinable()) {
+			worker.join();
+		}
+		if (ready()) {
+			disconnect();
+		}
+	}
+
+	/// @return	true once the dependency is connected.
+	[[nodiscard]] bool ready() const {
+		return ready_flag.load(std::memory_order_acquire);
+	}
+
+private:
+	/// Name of the dependency.
+	std::string name;
+	/// Function making one attempt to connect.
+	std::function<bool()> connect;
+	/// Function disconnecting the dependency.
+	std::function<void()> disconnect;
+	/// Whether the dependency is connected.
+	std::atomic<bool> ready_flag{false};
+	/// Variables for stopping the attempts to connect.
+	std::mutex stop_mutex;
+	std::condition_variable stop_condition;
+	std::atomic<bool> stopping{false};
+	/// Thread connecting to the dependency.
+	std::thread worker;
+};
+
+#endif // DEPENDENCY_HPP
@@ -0,0 +1,190 @@
+//C++ headers
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+//Cadmium Simulator headers
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+//Time class header
+#include <NDTime.hpp>
+
+// Project information headers this is created by cmake at generation time!!!!
+#include "SupervisorConfig.hpp"
+#include "fleet_config.hpp"
+
+//Coupled model headers
+#include "coupled_models/Vehicle.hpp"
+#include "coupled_models/Emulated_Aircraft.hpp"
+
+//Metrics headers
+#include "loop_watchdog.hpp"
+#include "metrics_endpoint.hpp"
+#include "startup_profile.hpp"
+#include "time_warp.hpp"
+
+//Aircraft state headers
+#include "state_feed.hpp"
+
+using TIME = NDTime;
+
+int main(int argc, char* argv[]) {
+	Startup_Profile::instance().mark("main entered");
+	if (argc < 2 || argc > 4) {
+		std::cout << "[Fleet] (ERROR) Usage: " << argv[0] << " <fleet configuration file> [time warp factor [initial aircraft state file]]" << std::endl;
+		return 1;
+	}
+	if (argc >= 3) {
+		try {
+			Time_Warp::set_factor(Time_Warp::parse_factor(argv[2]));
+		} catch (const std::invalid_argument& error) {
+			std::cout << "[Fleet] (ERROR) " << error.what() << std::endl;
+			return 1;
+		}
+		std::cout << "[Fleet] (INFO) Simulated time runs " << Time_Warp::factor() << " times faster than the wall clock" << std::endl;
+	}
+
+	std::vector<vehicle_config_t> vehicle_configs;
+	try {
+		vehicle_configs = read_fleet_config(argv[1]);
+	} catch (const std::runtime_error& error) {
+		std::cout << "[Fleet] (ERROR) " << error.what() << std::endl;
+		return 1;
+	}
+	if (vehicle_configs.empty()) {
+		std::cout << "[Fleet] (ERROR) No vehicles in " << argv[1] << std::endl;
+		return 1;
+	}
+
+	// Only an emulated aircraft is warped with its vehicle, an aircraft outside the process follows the wall clock.
+	bool any_emulated = false;
+	for (const vehicle_config_t& vehicle_config : vehicle_configs) {
+		if (vehicle_config.state_source == State_Source_E::EMULATOR) {
+			any_emulated = true;
+		} else if (Time_Warp::factor() != 1.0) {
+			std::cout << "[Fleet] (ERROR) Vehicle " << vehicle_config.name << " does not fly an emulated aircraft, so the fleet cannot be warped" << std::endl;
+			return 1;
+		}
+	}
+	message_aircraft_state_t initial_state;
+	if (any_emulated) {
+		if (argc != 4) {
+			std::cout << "[Fleet] (ERROR) An initial aircraft state file is needed for the emulated aircraft" << std::endl;
+			return 1;
+		}
+		try {
+			initial_state = Emulated_Aircraft::read_initial_state(argv[3]);
+		} catch (const std::runtime_error& error) {
+			std::cout << "[Fleet] (ERROR) " << error.what() << std::endl;
+			return 1;
+		}
+	} else if (argc == 4) {
+		std::cout << "[Fleet] (ERROR) No vehicle of " << argv[1] << " flies an emulated aircraft to start from " << argv[3] << std::endl;
+		return 1;
+	}
+
+	std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+	char folder_name[64] = {0};
+	std::strftime(folder_name, sizeof(folder_name), "%F-%H%M-%S", std::localtime(&now));
+
+	const std::string out_directory = std::string(PROJECT_DIRECTORY) + std::string("/test/flight_test_results/fleet-") + std::string(folder_name);
+
+	std::cout << "[Fleet] (INFO) Log files for " << vehicle_configs.size() << " vehicles will be saved under: " << out_directory << std::endl;
+
+	std::string out_messages_file = out_directory + std::string("/output_messages.txt");
+	std::string out_state_file = out_directory + std::string("/output_state.txt");
+
+	// Create the output location
+	boost::filesystem::create_directories(out_directory.c_str()); // Creates if it does not exist. Does nothing if it does.
+
+	// Receive the aircraft state of the vehicles that do not read the shared memory, all on one thread.
+	State_Feed state_feed;
+
+	// Instantiate a coupled model for each vehicle, with its ports offset so the vehicles do not share sockets.
+	cadmium::dynamic::modeling::Models vehicles;
+	// Each emulated aircraft is coupled to the FCC packets of its vehicle.
+	cadmium::dynamic::modeling::ICs ics;
+	for (const vehicle_config_t& vehicle_config : vehicle_configs) {
+		std::shared_ptr<Aircraft_State_Source> state_source;
+		if (vehicle_config.state_source == State_Source_E::EMULATOR) {
+			std::cout << "[Fleet] (INFO) Vehicle " << vehicle_config.name << " uses port offset " << vehicle_config.port_offset
+					  << " and flies an emulated aircraft" << std::endl;
+			std::shared_ptr<Stored_State_Source> emulated_state = std::make_shared<Stored_State_Source>();
+			Emulated_Aircraft aircraft_instance = Emulated_Aircraft(initial_state, emulated_state);
+			vehicles.push_back(std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+				"aircraft_" + vehicle_config.name, aircraft_instance.submodels, aircraft_instance.iports, aircraft_instance.oports, aircraft_instance.eics, aircraft_instance.eocs, aircraft_instance.ics
+			));
+			ics.push_back(cadmium::dynamic::translate::make_IC<Vehicle::defs::o_fcc_packet, Emulated_Aircraft::defs::i_fcc_packet>(
+				"vehicle_" + vehicle_config.name, "aircraft_" + vehicle_config.name
+			));
+			state_source = emulated_state;
+		} else if (vehicle_config.state_source == State_Source_E::SHARED_MEMORY) {
+			std::cout << "[Fleet] (INFO) Vehicle " << vehicle_config.name << " uses port offset " << vehicle_config.port_offset
+					  << " and reads the aircraft state from shared memory" << std::endl;
+			state_source = Shared_Memory_State_Source::instance();
+		} else {
+			unsigned short feed_port = static_cast<unsigned short>(PORT_STATE_FEED + vehicle_config.port_offset);
+			std::cout << "[Fleet] (INFO) Vehicle " << vehicle_config.name << " uses port offset " << vehicle_config.port_offset
+					  << " and receives the aircraft state on port " << feed_port << std::endl;
+			try {
+				state_source = state_feed.listen(feed_port);
+			} catch (const boost::system::system_error& error) {
+				std::cout << "[Fleet] (ERROR) Could not receive the aircraft state on port " << feed_port << ": " << error.what() << std::endl;
+				return 1;
+			}
+		}
+		Vehicle vehicle_instance = Vehicle(vehicle_config.port_offset, state_source);
+		vehicles.push_back(std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+			"vehicle_" + vehicle_config.name, vehicle_instance.submodels, vehicle_instance.iports, vehicle_instance.oports, vehicle_instance.eics, vehicle_instance.eocs, vehicle_instance.ics
+		));
+	}
+	Startup_Profile::instance().mark("models built");
+
+	// The vehicles are independent, so the fleet only couples them to their emulated aircraft.
+	// All of the vehicles are run by one runner, sharing its clock, its thread pool and the loggers.
+	std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> fleet = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+		"fleet", vehicles, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics
+	);
+
+	/*************** Loggers *******************/
+    static std::ofstream out_messages;
+    static std::ofstream out_state;
+
+	out_messages = std::ofstream(out_messages_file);
+	struct oss_sink_messages {
+		static std::ostream& sink() {
+			return out_messages;
+		}
+	};
+
+	out_state = std::ofstream(out_state_file);
+	struct oss_sink_state {
+		static std::ostream& sink() {
+			return out_state;
+		}
+	};
+
+	using state = cadmium::logger::logger<cadmium::logger::logger_state, cadmium::dynamic::logger::formatter<TIME>, oss_sink_state>;
+	using log_messages = cadmium::logger::logger<cadmium::logger::logger_messages, cadmium::dynamic::logger::formatter<TIME>, oss_sink_messages>;
+	using global_time_mes = cadmium::logger::logger<cadmium::logger::logger_global_time, cadmium::dynamic::logger::formatter<TIME>, oss_sink_messages>;
+	using global_time_sta = cadmium::logger::logger<cadmium::logger::logger_global_time, cadmium::dynamic::logger::formatter<TIME>, oss_sink_state>;
+	// The loop monitor is first so that a blocked logger delays the next iteration it sees.
+	using logger_fleet = cadmium::logger::multilogger<loop_monitor_logger, state, log_messages, global_time_mes, global_time_sta>;
+
+	// Serve the message and transition counts of the models while they run.
+	Metrics_Endpoint metrics_endpoint;
+	// Publish a heartbeat with the period and lateness of the loop, and alert the GCS when it is late.
+	Loop_Watchdog<TIME> loop_watchdog;
+	Startup_Profile::instance().mark("monitoring started");
+
+	cadmium::dynamic::engine::runner<NDTime, logger_fleet> r(fleet, { TIME("00:00:00:000:000") });
+	Startup_Profile::instance().mark("runner ready");
+	// Dependencies still connecting in the background are reported as they connect.
+	Startup_Profile::instance().report();
+	r.run_until_passivate();
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * 	\file		fleet_config.hpp
+ *	\brief		Definition of the fleet configuration.
+ *	\details	This header file defines the configuration of the vehicles run together by the fleet
+				runner. The configuration is a text file with one vehicle per line, given as the name
+				of the vehicle followed by the offset added to each of its ports and, optionally, where the
+				state of its aircraft is read from: "feed" for the state feed on PORT_STATE_FEED plus the
+				port offset, which is the default, "shared_memory", or "emulator" for an FCC emulator flying
+				the FCC packets of the vehicle in the same process. Blank lines and lines starting with
+				'#' are ignored. The ports of each vehicle are its base ports plus its offset, so the
+				offsets are checked on the ports they give rather than on their own values.
+ */
+
+#ifndef FLEET_CONFIG_HPP
+#define FLEET_CONFIG_HPP
+
+// Constants
+#include "Constants.hpp"
+
+// System Libraries
+#include <fstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Where the state of the aircraft of a vehicle is read from.
+enum class State_Source_E {
+	FEED,
+	SHARED_MEMORY,
+	EMULATOR
+};
+
+/**
+ *	\struct	vehicle_config_t
+ * 	\brief 	Definition of the configuration of a single vehicle of the fleet.
+ * 	\param 	name			Name of the vehicle, used to name its coupled model.
+ * 	\param 	port_offset		Offset added to every port the vehicle listens on or sends to.
+ * 	\param 	state_source	Where the state of the aircraft of the vehicle is read from.
+ */
+struct vehicle_config_t {
+	std::string name;
+	unsigned short port_offset;
+	State_Source_E state_source;
+};
+
+/**
+ *	\brief 		Function vehicle_ports is used to list the ports a vehicle listens on or sends to.
+ * 	\param		port_offset		long offset added to every port of the vehicle.
+ * 	\param		state_source	State_Source_E where the state of the aircraft of the vehicle is read from.
+ * 	\return		Base port and offset port of every port of the vehicle, the offset port can be past 65535.
+ */
+inline std::vector<std::pair<unsigned short, long>> vehicle_ports(long port_offset, State_Source_E state_source) {
+	std::vector<unsigned short> base_ports = {PORT_SUPERVISOR, PORT_BOSS, PORT_FCC, PORT_GCS, PORT_QGC_BROADCAST, PORT_MAVNRC};
+	if (state_source == State_Source_E::FEED) {
+		base_ports.push_back(PORT_STATE_FEED);
+	}
+	std::vector<std::pair<unsigned short, long>> ports;
+	for (unsigned short base_port : base_ports) {
+		ports.emplace_back(base_port, base_port + port_offset);
+	}
+	return ports;
+}
+
+/**
+ *	\brief 		Function read_fleet_config is used to read the vehicles of the fleet from a configuration file.
+ * 	\param		file_path	std::string path of the configuration file.
+ * 	\return		Configuration of each vehicle in the order they are listed.
+ * 	\throws		std::runtime_error if the file cannot be read, a line is malformed, a name or port offset is repeated,
+ * 				a port of a vehicle is past 65535, is used by another vehicle or is one of the ports of the process
+ * 				(PORT_HEARTBEAT and PORT_METRICS), or more than one vehicle reads the shared memory, which holds
+ * 				the state of a single aircraft.
+ */
+inline std::vector<vehicle_config_t> read_fleet_config(const std::string& file_path) {
+	std::ifstream file(file_path);
+	if (!file.is_open()) {
+		throw(std::runtime_error("Could not open fleet configuration " + file_path));
+	}
+
+	std::vector<vehicle_config_t> vehicles;
+	std::set<std::string> names;
+	std::set<unsigned short> port_offsets;
+	// The ports of the process are not offset, so no vehicle may use them.
+	std::map<long, std::string> used_ports = {{PORT_HEARTBEAT, "the heartbeat"}, {PORT_METRICS, "the metrics endpoint"}};
+	bool shared_memory_used = false;
+	std::string line;
+	int line_number = 0;
+	while (std::getline(file, line)) {
+		line_number++;
+		std::istringstream fields(line);
+		std::string name;
+		if (!(fields >> name) || name[0] == '#') {
+			continue;
+		}
+
+		long port_offset;
+		std::string source = "feed";
+		std::string extra;
+		if (!(fields >> port_offset) || (!(fields >> source) && !fields.eof()) || (fields >> extra) ||
+			port_offset < 0 || port_offset > std::numeric_limits<unsigned short>::max() ||
+			(source != "feed" && source != "shared_memory" && source != "emulator")) {
+			throw(std::runtime_error("Malformed vehicle on line " + std::to_string(line_number) + " of " + file_path));
+		}
+		if (!names.insert(name).second || !port_offsets.insert(static_cast<unsigned short>(port_offset)).second) {
+			throw(std::runtime_error("Repeated vehicle name or port offset on line " + std::to_string(line_number) + " of " + file_path));
+		}
+		State_Source_E state_source = (source == "shared_memory") ? State_Source_E::SHARED_MEMORY :
+									  (source == "emulator") ? State_Source_E::EMULATOR : State_Source_E::FEED;
+		for (const auto& [base_port, port] : vehicle_ports(port_offset, state_source)) {
+			if (port > std::numeric_limits<unsigned short>::max()) {
+				throw(std::runtime_error("Port offset takes port " + std::to_string(base_port) + " past 65535 on line " + std::to_string(line_number) + " of " + file_path));
+			}
+			auto [used, inserted] = used_ports.emplace(port, "vehicle " + name);
+			if (!inserted) {
+				throw(std::runtime_error("Port " + std::to_string(port) + " is already used by " + used->second + " on line " + std::to_string(line_number) + " of " + file_path));
+			}
+		}
+		if (state_source == State_Source_E::SHARED_MEMORY && std::exchange(shared_memory_used, true)) {
+			throw(std::runtime_error("More than one vehicle reads the shared memory on line " + std::to_string(line_number) + " of " + file_path));
+		}
+		vehicles.push_back(vehicle_config_t{name, static_cast<unsigned short>(port_offset), state_source});
+	}
+	return vehicles;
+}
+
+#endif // FLEET_CONFIG_HPP
@@ -0,0 +1,146 @@
+/**
+ * 	\file		ingress_statistics.hpp
+ *	\brief		Definition of the ingress statistics.
+ *	\details	This header file defines the statistics gathered while stress testing an ingress path,
+				matching the messages sent into the path with the messages that come out of it.
+ */
+
+#ifndef INGRESS_STATISTICS_HPP
+#define INGRESS_STATISTICS_HPP
+
+// System Libraries
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 	\class		Ingress_Statistics
+ *	\brief		Definition of the ingress statistics.
+ *	\details	This class records the time each message was sent by its id and works out the latency
+				when the message with the same id is received. Messages that have not been received are
+				in flight, and the number in flight is sampled to track how deep the queues along the
+				path grow. Messages still in flight at the end are counted as dropped.
+ */
+class Ingress_Statistics {
+public:
+	/// Default constructor for empty statistics.
+	Ingress_Statistics() {
+		clear();
+	}
+
+	/// Function for removing every recorded message and sample.
+	void clear() {
+		pending.clear();
+		latencies.clear();
+		sent_count = 0;
+		duplicate_count = 0;
+		max_depth = 0;
+		depth_total = 0.0;
+		depth_samples = 0;
+	}
+
+	/// @brief 	Function sent is used to record a message sent into the path.
+	/// @param 	id		int id of the message.
+	/// @param 	time	double time in seconds the message was sent.
+	void sent(int id, double time) {
+		pending[id] = time;
+		sent_count++;
+	}
+
+	/// @brief 	Function received is used to record a message coming out of the path.
+	/// @param 	id		int id of the message.
+	/// @param 	time	double time in seconds the message was received.
+	void received(int id, double time) {
+		auto it = pending.find(id);
+		if (it == pending.end()) {
+			duplicate_count++;
+			return;
+		}
+		latencies.push_back(time - it->second);
+		pending.erase(it);
+	}
+
+	/// Function for sampling the number of messages in flight.
+	void sample_depth() {
+		max_depth = std::max(max_depth, pending.size());
+		depth_total += pending.size();
+		depth_samples++;
+	}
+
+	/// @return	Number of messages sent into the path.
+	[[nodiscard]] size_t sent_messages() const {
+		return sent_count;
+	}
+
+	/// @return	Number of messages that came out of the path.
+	[[nodiscard]] size_t received_messages() const {
+		return latencies.size();
+	}
+
+	/// @return	Fraction of the messages sent that have not come out of the path.
+	[[nodiscard]] double drop_rate() const {
+		return (sent_count == 0) ? 0.0 : static_cast<double>(pending.size()) / sent_count;
+	}
+
+	/// @return	Largest number of messages sampled in flight.
+	[[nodiscard]] size_t max_queue_depth() const {
+		return max_depth;
+	}
+
+	/// @return	Mean number of messages sampled in flight.
+	[[nodiscard]] double mean_queue_depth() const {
+		return (depth_samples == 0) ? 0.0 : depth_total / depth_samples;
+	}
+
+	/// @brief 	Function latency is used to read a percentile of the latency of the messages received.
+	/// @param 	percentile	double percentile between 0 and 100.
+	/// @return	Latency in seconds, 0 if no messages have been received.
+	[[nodiscard]] double latency(double percentile) const {
+		if (latencies.empty()) {
+			return 0.0;
+		}
+		std::vector<double> sorted = latencies;
+		size_t index = std::min(sorted.size() - 1, static_cast<size_t>(percentile / 100.0 * sorted.size()));
+		std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+		return sorted[index];
+	}
+
+	/**
+	 * 	\brief 	Operator for printing a summary of the statistics.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, const Ingress_Statistics& stats) {
+		std::ios_base::fmtflags flags = os.flags();
+		std::streamsize precision = os.precision();
+		os << "Sent: " << stats.sent_messages()
+		   << " Received: " << stats.received_messages()
+		   << " Duplicates: " << stats.duplicate_count
+		   << std::fixed << std::setprecision(4)
+		   << " Drop rate: " << stats.drop_rate()
+		   << " Queue depth (max/mean): " << stats.max_queue_depth() << "/" << stats.mean_queue_depth()
+		   << " Latency (p50/p99/max): " << stats.latency(50.0) << "/" << stats.latency(99.0) << "/" << stats.latency(100.0) << " s";
+		os.flags(flags);
+		os.precision(precision);
+		return os;
+	}
+
+private:
+	/// Time in seconds each message in flight was sent, by id.
+	std::unordered_map<int, double> pending;
+	/// Latency in seconds of each message received.
+	std::vector<double> latencies;
+	/// Number of messages sent.
+	size_t sent_count;
+	/// Number of messages received that were not in flight.
+	size_t duplicate_count;
+	/// Largest number of messages sampled in flight.
+	size_t max_depth;
+	/// Sum of the number of messages sampled in flight.
+	double depth_total;
+	/// Number of times the messages in flight were sampled.
+	size_t depth_samples;
+};
+
+#endif // INGRESS_STATISTICS_HPP
@@ -18,6 +18,8 @@
 #include "message_structures/message_start_supervisor_t.hpp"
 #include "message_structures/message_update_gcs_t.hpp"
 #include "message_structures/message_boss_mission_update_t.hpp"
+#include "message_structures/message_waypoint_update_t.hpp"
+#include "message_structures/shared_message_t.hpp"
 
 // Aircraft State
 template<typename T>
@@ -53,10 +55,10 @@ public:
 
 // FCC Command
 template<typename T>
-class Input_Reader_Boss_Mission_Update : public cadmium::basic_models::pdevs::iestream_input<message_boss_mission_update_t, T> {
+class Input_Reader_Boss_Mission_Update : public cadmium::basic_models::pdevs::iestream_input<shared_message_t<message_boss_mission_update_t>, T> {
 public:
 	Input_Reader_Boss_Mission_Update() = default;
-	Input_Reader_Boss_Mission_Update(const char* file_path) : cadmium::basic_models::pdevs::iestream_input<message_boss_mission_update_t, T>(file_path) {};
+	Input_Reader_Boss_Mission_Update(const char* file_path) : cadmium::basic_models::pdevs::iestream_input<shared_message_t<message_boss_mission_update_t>, T>(file_path) {};
 };
 
 // FCC Command
@@ -99,4 +101,12 @@ public:
 	Input_Reader_Update_GCS(const char* file_path) : cadmium::basic_models::pdevs::iestream_input<message_update_gcs_t, T>(file_path) {};
 };
 
+// Waypoint Update
+template<typename T>
+class Input_Reader_Waypoint_Update : public cadmium::basic_models::pdevs::iestream_input<message_waypoint_update_t, T> {
+public:
+	Input_Reader_Waypoint_Update() = default;
+	Input_Reader_Waypoint_Update(const char* file_path) : cadmium::basic_models::pdevs::iestream_input<message_waypoint_update_t, T>(file_path) {};
+};
+
 #endif // INPUT_READERS_HPP
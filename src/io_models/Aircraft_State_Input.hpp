@@ -2,7 +2,8 @@
  * 	\file		Aircraft_State_Input.hpp
  *	\brief		Definition of the Aircraft State Input atomic model.
  *	\details	This header file defines the Aircraft State Input atomic model for use in the Cadmium DEVS
-				simulation software. The model connects to shared memory and outputs the aircraft state.
+				simulation software. The model reads the aircraft state from its source, the shared memory by
+				default, and outputs it. Until the source is connected, requests wait for it and are served once it connects.
  *	\image		html io_models/aircraft_state_input.png
  *	\author		Tanner Trautrim
  *	\author		James Horner
@@ -17,23 +18,28 @@
 
 // Utility functions
 #include "../enum_string_conversion.hpp"
+#include "../Constants.hpp"
+#include "../aircraft_state_source.hpp"
 
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
 #include <cadmium/modeling/message_bag.hpp>
 
-// Shared Memory Model
-#include <sharedmemorymodel/SharedMemoryModel.h>
-
 // System libraries
 #include <cassert>
+#include <memory>
 #include <string>
 
 /**
  *	\class		Aircraft_State_Input
  *	\brief		Definition of the Aircraft State Input atomic model.
  *	\details	This class defines the Aircraft State Input atomic model for use in the Cadmium DEVS
-				simulation software. The model connects to shared memory and outputs the aircraft state.
+				simulation software. The model reads the aircraft state from an Aircraft_State_Source, so
+				each vehicle of a fleet can read its own aircraft, and outputs it. Until the source is
+				connected, requests wait in the WAIT_FOR_DEPENDENCY state, which checks every
+				DEPENDENCY_POLL_PERIOD whether it has connected. Several models can subscribe
+				to the stream, so the subscriptions are counted and streaming stops once every subscriber
+				has unsubscribed.
  *	\image		html io_models/aircraft_state_input.png
  */
 template<typename TIME>
@@ -46,6 +52,8 @@ public:
 	DEFINE_ENUM_WITH_STRING_CONVERSIONS(States,
 		(IDLE)
 		(SEND)
+		(STREAM)
+		(WAIT_FOR_DEPENDENCY)
 	);
 
 	/**
@@ -57,6 +65,7 @@ public:
 	struct defs {
 		struct o_message : public cadmium::out_port<message_aircraft_state_t> { };
 		struct i_request : public cadmium::in_port<bool> { };
+		struct i_stream : public cadmium::in_port<bool> { };
 	};
 
 	/**
@@ -64,8 +73,9 @@ public:
 	 *	\par	Input Ports
 	 * 	Definition of the input ports for the model.
 	 * 	\param 	i_request	Port for receiving a request to get an aircraft state.
+	 * 	\param 	i_stream	Port for receiving a subscription (true) to or an unsubscription (false) from the aircraft state stream.
 	 */
-	using input_ports = std::tuple<typename defs::i_request>;
+	using input_ports = std::tuple<typename defs::i_request, typename defs::i_stream>;
 
 	/**
 	 *	\anchor	Aircraft_State_Input_output_ports
@@ -80,30 +90,35 @@ public:
 	 *	\par	State
 	 * 	Definition of the states of the atomic model.
 	 * 	\param 	current_state 	Current state of atomic model.
+	 * 	\param 	streaming 		Whether the aircraft state is currently being streamed.
+	 * 	\param 	subscribers 	Number of models subscribed to the aircraft state stream.
+	 * 	\param 	pending_request	Whether a request is waiting for the source to connect.
 	 */
 	struct state_type {
 		States current_state;
+		bool streaming;
+		unsigned int subscribers;
+		bool pending_request;
 	} state;
 
 	/**
 	 * \brief 	Default constructor for the model.
 	 */
-	Aircraft_State_Input() {
-		//Initialise the current state
-		state.current_state = States::IDLE;
-
-		model = SharedMemoryModel();
-		model.connectSharedMem();
-		if (!model.isConnected()) {
-			throw(std::runtime_error("Could not connect to shared memory."));
-		}
-	}
+	Aircraft_State_Input() : Aircraft_State_Input(TIME(AIRCRAFT_STATE_STREAM_PERIOD)) {}
 
 	/**
-	 * \brief 	Destructor for disconnecting from shared memory.
+	 * \brief 	Constructor for the model with parameters for the rate at which the aircraft state is streamed and where it is read from.
+	 * \param	stream_period	TIME period between aircraft state outputs while streaming.
+	 * \param	source			std::shared_ptr<Aircraft_State_Source> source of the aircraft state, the shared memory by default.
 	 */
-	~Aircraft_State_Input() {
-		model.disconnectSharedMem();
+	explicit Aircraft_State_Input(TIME stream_period, std::shared_ptr<Aircraft_State_Source> source = Shared_Memory_State_Source::instance())
+			: source(std::move(source)) {
+		//Initialise the current state
+		state.current_state = States::IDLE;
+		state.streaming = false;
+		state.subscribers = 0;
+		state.pending_request = false;
+		this->stream_period = stream_period;
 	}
 
 	/// Internal transitions of the model
@@ -111,7 +126,14 @@ public:
 		switch (state.current_state)
 		{
 			case States::SEND:
-				state.current_state = States::IDLE;
+			case States::STREAM:
+				state.current_state = state.streaming ? States::STREAM : States::IDLE;
+				break;
+			case States::WAIT_FOR_DEPENDENCY:
+				if (source->connected()) {
+					state.current_state = state.pending_request ? States::SEND : (state.streaming ? States::STREAM : States::IDLE);
+					state.pending_request = false;
+				}
 				break;
 			default:
 				break;
@@ -121,8 +143,27 @@ public:
 	/// External transitions of the model
 	void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
 		bool received_request = !cadmium::get_messages<typename defs::i_request>(mbs).empty();
-		if (received_request) {
+		bool received_stream = !cadmium::get_messages<typename defs::i_stream>(mbs).empty();
+		for (bool subscribe : cadmium::get_messages<typename defs::i_stream>(mbs)) {
+			if (subscribe) {
+				state.subscribers++;
+			} else if (state.subscribers > 0) {
+				state.subscribers--;
+			}
+		}
+		state.streaming = state.subscribers > 0;
+
+		if (!source->connected()) {
+			state.pending_request = state.pending_request || received_request;
+			if (state.pending_request || state.streaming) {
+				state.current_state = States::WAIT_FOR_DEPENDENCY;
+			} else if (received_stream) {
+				state.current_state = States::IDLE;
+			}
+		} else if (received_request) {
 			state.current_state = States::SEND;
+		} else if (received_stream) {
+			state.current_state = state.streaming ? States::STREAM : States::IDLE;
 		}
 	}
 
@@ -136,16 +177,8 @@ public:
 	[[nodiscard]] typename cadmium::make_message_bags<output_ports>::type output() const {
 		typename cadmium::make_message_bags<output_ports>::type bags;
 
-		if (state.current_state == States::SEND) {
-			cadmium::get_messages<typename defs::o_message>(bags).emplace_back(
-					model.sharedMemoryStruct->hg1700.time,
-					model.sharedMemoryStruct->hg1700.lat,
-					model.sharedMemoryStruct->hg1700.lng,
-					model.sharedMemoryStruct->hg1700.mixedhgt,
-					model.sharedMemoryStruct->hg1700.alt,
-					model.sharedMemoryStruct->hg1700.hdg,
-					sqrt(pow(model.sharedMemoryStruct->hg1700.ve, 2) + pow(model.sharedMemoryStruct->hg1700.vn, 2))
-			);
+		if (state.current_state == States::SEND || state.current_state == States::STREAM) {
+			cadmium::get_messages<typename defs::o_message>(bags).push_back(source->aircraft_state());
 		}
 		return bags;
 	}
@@ -157,6 +190,10 @@ public:
 				return std::numeric_limits<TIME>::infinity();
 			case States::SEND:
 				return TIME(TA_ZERO);
+			case States::STREAM:
+				return stream_period;
+			case States::WAIT_FOR_DEPENDENCY:
+				return TIME(DEPENDENCY_POLL_PERIOD);
 			default:
 				assert(false && "Unhandled state time advance.");
 		}
@@ -172,8 +209,10 @@ public:
 	}
 
 private:
-	// Variable used for shared memory management and access
-	SharedMemoryModel model;
+	// Variable for storing the period between aircraft state outputs while streaming
+	TIME stream_period;
+	// Variable for storing the source the aircraft state is read from
+	std::shared_ptr<Aircraft_State_Source> source;
 };
 
 #endif // AIRCRAFT_STATE_INPUT_HPP
@@ -3,6 +3,9 @@
  *	\brief		Definition of the Cache Input atomic model.
  *	\details	This header file defines the Cache Input atomic model for use in the Cadmium DEVS
 				simulation software. The model receives inputs and caches them for later access.
+				Each cached input is given a monotonic version and the time it was cached at so that
+				readers can ask for the input only if it has changed, and the model publishes when
+				the cached input has gone stale.
  *	\image		html io_models/cache_input.png
  *	\author		Tanner Trautrim
  *	\author		James Horner
@@ -11,8 +14,13 @@
 #ifndef CACHE_INPUT_HPP
 #define CACHE_INPUT_HPP
 
+// Messages structures
+#include "../message_structures/message_cache_entry_t.hpp"
+
 // Utility functions
 #include "../enum_string_conversion.hpp"
+#include "../time_conversion.hpp"
+#include "../timer_wheel.hpp"
 
 // Constants
 #include "../Constants.hpp"
@@ -23,6 +31,7 @@
 
 // System libraries
 #include <iostream>
+#include <limits>
 #include <string>
 
 /**
@@ -30,6 +39,9 @@
  *	\brief		Definition of the Cache Input atomic model.
  *	\details	This class defines the Cache Input atomic model for use in the Cadmium DEVS
 				simulation software. The model receives inputs and caches them for later access.
+				Requests are collected rather than dropped while the model is sending, and every
+				request received in the same step is answered by a single output. Requests for
+				the input changed since a version are only answered if a newer version is cached.
  *	\image		html io_models/cache_input.png
  */
 template<typename MSG, typename TIME>
@@ -53,19 +65,24 @@ public:
 	struct defs {
 		struct i_new_input   	: public cadmium::in_port<MSG> { };
 		struct i_get_input   	: public cadmium::in_port<bool> { };
+		struct i_get_changed 	: public cadmium::in_port<int> { };
 		struct o_cached_input	: public cadmium::out_port<MSG> { };
+		struct o_cached_entry	: public cadmium::out_port<message_cache_entry_t<MSG>> { };
+		struct o_stale       	: public cadmium::out_port<bool> { };
 	};
 
 	/**
 	 * 	\anchor	Cache_Input_input_ports
 	 *	\par	Input Ports
 	 * 	Definition of the input ports for the model.
-	 * 	\param 	i_new_input	Port for receiving a new message to cache.
-	 * 	\param 	i_get_input	Port for requesting a cached message be sent.
+	 * 	\param 	i_new_input		Port for receiving a new message to cache.
+	 * 	\param 	i_get_input		Port for requesting a cached message be sent.
+	 * 	\param 	i_get_changed	Port for requesting the cached entry be sent if its version is newer than the one given.
 	 */
 	using input_ports=std::tuple<
 			typename defs::i_new_input,
-			typename defs::i_get_input
+			typename defs::i_get_input,
+			typename defs::i_get_changed
 	>;
 
 	/**
@@ -73,9 +90,13 @@ public:
 	 * 	\par 	Output Ports
 	 * 	Definition of the output ports for the model.
 	 * 	\param	o_cached_input	Port for outputting cached messages.
+	 * 	\param	o_cached_entry	Port for outputting cached messages with their version and the time they were cached.
+	 * 	\param	o_stale			Port for outputting whether the cached message has gone stale.
 	 */
 	using output_ports=std::tuple<
-			typename defs::o_cached_input
+			typename defs::o_cached_input,
+			typename defs::o_cached_entry,
+			typename defs::o_stale
 	>;
 
 	/**
@@ -84,53 +105,102 @@ public:
 	 * 	Definition of the states of the atomic model.
 	 * 	\param 	current_state 	Current state of atomic model.
 	 * 	\param 	cached_input 	Message to store for future retrieval.
+	 * 	\param 	version 		Number of times a new message has been cached.
+	 * 	\param 	timestamp 		Time in seconds the message was cached at.
+	 * 	\param 	stale 			Whether the message has not been replaced within the stale time.
 	 */
 	struct state_type{
 		States current_state;
 		MSG cached_input;
+		int version;
+		double timestamp;
+		bool stale;
 	} state;
 
 	/**
 	 * \brief 	Default constructor for the model.
 	 */
-    Cache_Input() {
-        state.current_state = States::IDLE;
-		state.cached_input = MSG();
-    }
+    Cache_Input() : Cache_Input(MSG()) {}
+
+	/**
+	 * \brief 	Constructor for the model with an initial message that never goes stale.
+	 * \param	initial_cached_input	MSG initial message of the cache.
+	 */
+    explicit Cache_Input(MSG initial_cached_input) : Cache_Input(initial_cached_input, std::numeric_limits<TIME>::infinity()) {}
 
 	/**
-	 * \brief 	Constructor for the model with initial state parameter
-	 * 			for debugging or partial execution startup.
-	 * \param	initial_state	States initial state of the model.
+	 * \brief 	Constructor for the model with an initial message and the time it takes to go stale.
+	 * \param	initial_cached_input	MSG initial message of the cache.
+	 * \param	i_stale_time			TIME after a message is cached that it goes stale if it is not replaced.
 	 */
-    explicit Cache_Input(MSG initial_cached_input) {
+    Cache_Input(MSG initial_cached_input, TIME i_stale_time) {
         state.current_state = States::IDLE;
 		state.cached_input = initial_cached_input;
+		state.version = 0;
+		state.timestamp = 0.0;
+		state.stale = false;
+		stale_time = i_stale_time;
+		current_time = TIME();
+		send_input = false;
+		send_entry = false;
+		send_stale = false;
+		timers.arm("stale", stale_time);
     }
 
 	/// Internal transitions of the model
     void internal_transition() {
+		TIME elapsed = time_advance();
+		timers.advance(elapsed);
+		current_time = current_time + elapsed;
+
         if (state.current_state == States::SEND) {
+			send_input = false;
+			send_entry = false;
+			send_stale = false;
             state.current_state = States::IDLE;
         }
+
+		if (timers.expired("stale")) {
+			timers.cancel("stale");
+			state.stale = true;
+			send_stale = true;
+			state.current_state = States::SEND;
+		}
     }
 
 	/// External transitions of the model
-    void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+    void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		timers.advance(e);
+		current_time = current_time + e;
+
         bool new_input = !cadmium::get_messages<typename defs::i_new_input>(mbs).empty();
         bool get_input = !cadmium::get_messages<typename defs::i_get_input>(mbs).empty();
+        bool get_changed = !cadmium::get_messages<typename defs::i_get_changed>(mbs).empty();
 
-		switch (state.current_state) {
-			case States::IDLE:
-				if (new_input){
-					state.current_state = States::IDLE;
-					// Cache the most recent input (found at the back of the vector of inputs)
-					state.cached_input = cadmium::get_messages<typename defs::i_new_input>(mbs).back();
-				}
-				if (get_input) state.current_state = States::SEND;
-				break;
-			default:
-				break;
+		if (new_input) {
+			// Cache the most recent input (found at the back of the vector of inputs)
+			state.cached_input = cadmium::get_messages<typename defs::i_new_input>(mbs).back();
+			state.version++;
+			state.timestamp = time_to_seconds(current_time);
+			if (state.stale) {
+				state.stale = false;
+				send_stale = true;
+			}
+			timers.arm("stale", stale_time);
+		}
+
+		// Requests received while sending are added to the pending requests so they are answered in the same step.
+		if (get_input) {
+			send_input = true;
+		}
+		if (get_changed) {
+			for (int version : cadmium::get_messages<typename defs::i_get_changed>(mbs)) {
+				send_entry = send_entry || state.version > version;
+			}
+		}
+
+		if (send_input || send_entry || send_stale) {
+			state.current_state = States::SEND;
 		}
     }
 
@@ -145,9 +215,24 @@ public:
 		typename cadmium::make_message_bags<output_ports>::type bags;
 
         switch(state.current_state) {
-            case States::SEND:
-				cadmium::get_messages<typename defs::o_cached_input>(bags).push_back(state.cached_input);
+            case States::SEND: {
+				if (send_input) {
+					cadmium::get_messages<typename defs::o_cached_input>(bags).push_back(state.cached_input);
+				}
+				// Answer every reader waiting on an older version with a single entry.
+				if (send_entry) {
+					cadmium::get_messages<typename defs::o_cached_entry>(bags).emplace_back(
+							state.cached_input,
+							state.version,
+							state.timestamp,
+							state.stale
+					);
+				}
+				if (send_stale) {
+					cadmium::get_messages<typename defs::o_stale>(bags).push_back(state.stale);
+				}
 		        break;
+			}
             default:
                 break;
         }
@@ -158,7 +243,7 @@ public:
     TIME time_advance() const {
         switch (state.current_state) {
             case States::IDLE:
-                return std::numeric_limits<TIME>::infinity();
+                return timers.next_expiry();
             default:
                 return TIME(TA_ZERO);
         }
@@ -172,6 +257,20 @@ public:
         os << "State: " << enumToString(i.current_state) + std::string("\n");
         return os;
     }
+
+private:
+	/// Variable for storing the time after a message is cached that it goes stale.
+	TIME stale_time;
+	/// Variable for tracking the simulation time used to timestamp cached messages.
+	TIME current_time;
+	/// Variable for storing whether the cached message has been requested.
+	bool send_input;
+	/// Variable for storing whether the staleness of the cached message has changed.
+	bool send_stale;
+	/// Variable for storing whether a request for the cached message if it has changed was given an older version.
+	bool send_entry;
+	/// Variable for tracking the ("stale") timer.
+	Timer_Wheel<TIME> timers;
 };
 
 /**
@@ -185,6 +284,7 @@ class Cache_Input_Boolean : public Cache_Input<bool, T> {
 public:
 	Cache_Input_Boolean() = default;
 	explicit Cache_Input_Boolean(bool initial_cached_input) : Cache_Input<bool, T>(initial_cached_input) {};
+	Cache_Input_Boolean(bool initial_cached_input, T stale_time) : Cache_Input<bool, T>(initial_cached_input, stale_time) {};
 };
 
 #endif /* CACHE_INPUT_HPP */
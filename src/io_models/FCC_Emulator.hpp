@@ -0,0 +1,316 @@
+/**
+ * 	\file		FCC_Emulator.hpp
+ *	\brief		Definition of the FCC Emulator atomic model.
+ *	\details	This header file defines the FCC Emulator atomic model for use in the Cadmium DEVS
+				simulation software. The model stands in for the FCC and the aircraft, flying the
+				commands the Supervisor sends to the FCC and answering requests for the aircraft state,
+				so that whole missions can be run closed loop in simulated time.
+ */
+
+#ifndef FCC_EMULATOR_HPP
+#define FCC_EMULATOR_HPP
+
+// Message structures
+#include "../message_structures/message_aircraft_state_t.hpp"
+#include "../message_structures/message_fcc_command_t.hpp"
+
+// Utility functions
+#include "../enum_string_conversion.hpp"
+#include "../point_mass_model.hpp"
+#include "../time_conversion.hpp"
+#include "../timer_wheel.hpp"
+#include <mavNRC/endian.hpp>
+
+// Constants
+#include "../Constants.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+
+// System libraries
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ *	\class		FCC_Emulator
+ *	\brief		Definition of the FCC Emulator atomic model.
+ *	\details	This class defines the FCC Emulator atomic model for use in the Cadmium DEVS
+				simulation software. The model decodes the packets built by Packet_Builder_Fcc, flies
+				the commands with a Point_Mass_Model integrated every FCC_EMULATOR_STEP while the
+				aircraft is moving, and outputs the aircraft state on request or while streaming in the
+				same way as Aircraft_State_Input. Landing achieved is output once the aircraft has been
+				asked to land and is below the landing height. The model does not use the wall clock,
+				so it runs as fast as the simulation runner advances time.
+ */
+template<typename TIME>
+class FCC_Emulator {
+public:
+	/**
+	 *	\par	States
+	 * 	Declaration of the states of the atomic model.
+	 */
+	DEFINE_ENUM_WITH_STRING_CONVERSIONS(States,
+		(HOVER)
+		(FLYING)
+		(SEND)
+		(LANDING_ACHIEVED)
+		(LANDED)
+	);
+
+	/**
+	 *	\brief	For definition of the input and output ports see:
+	*	\ref 	FCC_Emulator_input_ports "Input Ports" and
+	*	\ref 	FCC_Emulator_output_ports "Output Ports"
+	* 	\note 	All input and output ports must be listed in this struct.
+	*/
+	struct defs {
+		struct i_packet : public cadmium::in_port<std::vector<char>> { };
+		struct i_request : public cadmium::in_port<bool> { };
+		struct i_stream : public cadmium::in_port<bool> { };
+		struct o_message : public cadmium::out_port<message_aircraft_state_t> { };
+		struct o_landing_achieved : public cadmium::out_port<bool> { };
+	};
+
+	/**
+	 * 	\anchor	FCC_Emulator_input_ports
+	 *	\par	Input Ports
+	 * 	Definition of the input ports for the model.
+	 * 	\param 	i_packet	Port for receiving packets of FCC commands built by Packet_Builder_Fcc.
+	 * 	\param 	i_request	Port for receiving a request to get an aircraft state.
+	 * 	\param 	i_stream	Port for receiving a request to start (true) or stop (false) streaming the aircraft state.
+	 */
+	using input_ports = std::tuple<
+		typename defs::i_packet,
+		typename defs::i_request,
+		typename defs::i_stream
+	>;
+
+	/**
+	 *	\anchor	FCC_Emulator_output_ports
+	 * 	\par 	Output Ports
+	 * 	Definition of the output ports for the model.
+	 * 	\param	o_message			Port for sending aircraft state messages.
+	 * 	\param	o_landing_achieved	Port for signalling that the aircraft has landed.
+	 */
+	using output_ports = std::tuple<
+		typename defs::o_message,
+		typename defs::o_landing_achieved
+	>;
+
+	/**
+	 *	\anchor	FCC_Emulator_state_type
+	 *	\par	State
+	 * 	Definition of the states of the atomic model.
+	 * 	\param 	current_state 		Current state of atomic model.
+	 * 	\param 	streaming 			Whether the aircraft state is currently being streamed.
+	 * 	\param 	landing_reported	Whether landing achieved has been output.
+	 */
+	struct state_type {
+		States current_state;
+		bool streaming;
+		bool landing_reported;
+	} state;
+
+	/**
+	 * \brief 	Default constructor for the model.
+	 */
+	FCC_Emulator() : FCC_Emulator(message_aircraft_state_t(), DEFAULT_LAND_CRITERIA_VERT_DIST) {}
+
+	/**
+	 * \brief 	Constructor for the model with the starting aircraft state.
+	 * \param	initial_state		message_aircraft_state_t state of the aircraft at the start, hovering.
+	 * \param	landing_height_ft	float height above the ground in feet that the aircraft is considered landed below.
+	 * \param	streaming			bool whether the aircraft state is streamed from the start, before any request to stream it.
+	 */
+	explicit FCC_Emulator(message_aircraft_state_t initial_state, float landing_height_ft = DEFAULT_LAND_CRITERIA_VERT_DIST, bool streaming = false) {
+		state.current_state = States::HOVER;
+		state.streaming = streaming;
+		state.landing_reported = false;
+		aircraft = Point_Mass_Model(initial_state);
+		this->landing_height_ft = landing_height_ft;
+		step_period = TIME(FCC_EMULATOR_STEP);
+		stream_period = TIME(AIRCRAFT_STATE_STREAM_PERIOD);
+		request = false;
+		if (streaming) {
+			timers.arm("stream", stream_period);
+		}
+	}
+
+	/// Internal transitions of the model
+	void internal_transition() {
+		TIME elapsed = time_advance();
+		fly(aircraft, elapsed);
+		timers.advance(elapsed);
+
+		switch (state.current_state) {
+			case States::SEND:
+				request = false;
+				break;
+			case States::LANDING_ACHIEVED:
+				state.landing_reported = true;
+				break;
+			default:
+				break;
+		}
+
+		// The aircraft state was output by the stream this step, start waiting for the next one.
+		if (timers.expired("stream")) {
+			timers.arm("stream", stream_period);
+		}
+
+		update_state();
+	}
+
+	/// External transitions of the model
+	void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		fly(aircraft, e);
+		timers.advance(e);
+
+		message_fcc_command_t fcc_command;
+		for (const auto& packet : cadmium::get_messages<typename defs::i_packet>(mbs)) {
+			if (decode(packet, fcc_command)) {
+				aircraft.command(fcc_command);
+			}
+		}
+
+		if (!cadmium::get_messages<typename defs::i_request>(mbs).empty()) {
+			request = true;
+		}
+
+		if (!cadmium::get_messages<typename defs::i_stream>(mbs).empty()) {
+			bool streaming = cadmium::get_messages<typename defs::i_stream>(mbs).back();
+			if (streaming && !state.streaming) {
+				timers.arm("stream", stream_period);
+			} else if (!streaming) {
+				timers.cancel("stream");
+			}
+			state.streaming = streaming;
+		}
+
+		update_state();
+	}
+
+	/// Function used to decide precedence between internal and external transitions when both are scheduled simultaneously.
+	void confluence_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		internal_transition();
+		external_transition(TIME(), std::move(mbs));
+	}
+
+	/// Function for generating output from the model before internal transitions.
+	[[nodiscard]] typename cadmium::make_message_bags<output_ports>::type output() const {
+		typename cadmium::make_message_bags<output_ports>::type bags;
+
+		// The aircraft is flown to the time of the output without changing the model.
+		TIME next_internal = time_advance();
+		bool stream_due = state.streaming && !(next_internal < timers.remaining("stream"));
+		if (state.current_state == States::SEND || stream_due) {
+			Point_Mass_Model next_aircraft = aircraft;
+			fly(next_aircraft, next_internal);
+			cadmium::get_messages<typename defs::o_message>(bags).push_back(next_aircraft.aircraft_state());
+		}
+
+		if (state.current_state == States::LANDING_ACHIEVED) {
+			cadmium::get_messages<typename defs::o_landing_achieved>(bags).push_back(true);
+		}
+		return bags;
+	}
+
+	/// Function to declare the time advance value for each state of the model.
+	TIME time_advance() const {
+		switch (state.current_state) {
+			case States::HOVER:
+			case States::FLYING:
+			case States::LANDED:
+				return timers.next_expiry();
+			case States::SEND:
+			case States::LANDING_ACHIEVED:
+				return TIME(TA_ZERO);
+			default:
+				assert(false && "Unhandled state time advance.");
+		}
+	}
+
+	/**
+	 *  \brief 		Operator for defining how the model state will be represented as a string.
+	 * 	\warning 	Prepended "State: " is required for log parsing, do not remove.
+	 */
+	friend std::ostringstream& operator<<(std::ostringstream& os, const typename FCC_Emulator<TIME>::state_type& i) {
+		os << "State: " << enumToString(i.current_state);
+		return os;
+	}
+
+	/**
+	 * \brief 	Function decode is used to reverse the byte swapping done by Packet_Builder_Fcc.
+	 * \param	packet		std::vector<char> packet received from Packet_Builder_Fcc.
+	 * \param	fcc_command	message_fcc_command_t decoded command.
+	 * \return	true if the packet is the size of an FCC command, false otherwise.
+	 */
+	static bool decode(const std::vector<char>& packet, message_fcc_command_t& fcc_command) {
+		if (packet.size() != sizeof(message_fcc_command_t)) {
+			return false;
+		}
+		std::memcpy((void *)&fcc_command, packet.data(), sizeof(message_fcc_command_t));
+		Swap_Double(&fcc_command.supervisor_gps_time);
+		Struct_ntohl((void *)&fcc_command, sizeof(fcc_command));
+		return true;
+	}
+
+private:
+	/// Variable for the aircraft flying the FCC commands.
+	Point_Mass_Model aircraft;
+	/// Variable for storing the height above the ground in feet that the aircraft is considered landed below.
+	float landing_height_ft;
+	/// Variable for storing the period between integration steps while the aircraft is moving.
+	TIME step_period;
+	/// Variable for storing the period between aircraft state outputs while streaming.
+	TIME stream_period;
+	/// Variable for storing whether an aircraft state has been requested.
+	bool request;
+	/// Variable for tracking the ("step" and "stream") timers.
+	Timer_Wheel<TIME> timers;
+
+	/// Function for flying an aircraft forward in steps no longer than the step period.
+	void fly(Point_Mass_Model& flown, TIME elapsed) const {
+		double remaining = time_to_seconds(elapsed);
+		double step = time_to_seconds(step_period);
+		if (std::isinf(remaining)) {
+			return;
+		}
+		while (remaining > 0.0) {
+			double dt = std::min(remaining, step);
+			flown.step(static_cast<float>(dt));
+			remaining -= dt;
+		}
+	}
+
+	/// Function for choosing the next state from the pending outputs and whether the aircraft is moving.
+	void update_state() {
+		message_aircraft_state_t aircraft_state = aircraft.aircraft_state();
+
+		if (aircraft.settled()) {
+			timers.cancel("step");
+		} else if (!timers.armed("step")) {
+			timers.arm("step", step_period);
+		}
+
+		if (request) {
+			state.current_state = States::SEND;
+		} else if (aircraft.landing() && !state.landing_reported && aircraft_state.alt_AGL < landing_height_ft) {
+			state.current_state = States::LANDING_ACHIEVED;
+		} else if (aircraft.landed()) {
+			state.current_state = States::LANDED;
+		} else if (aircraft.settled()) {
+			state.current_state = States::HOVER;
+		} else {
+			state.current_state = States::FLYING;
+		}
+	}
+};
+
+#endif // FCC_EMULATOR_HPP
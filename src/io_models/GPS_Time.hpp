@@ -13,10 +13,10 @@
 
 // Utility functions
 #include "../enum_string_conversion.hpp"
+#include "../shared_memory.hpp"
 
 // Cadmium Simulator Headers
 #include <cadmium/modeling/message_bag.hpp>
-#include <sharedmemorymodel/SharedMemoryModel.h>
 
 // System libraries
 #include <iostream>
@@ -67,17 +67,6 @@ public:
 	 */
     GPS_Time() {
         state.current_state = States::GPS_TIME;
-        model.connectSharedMem();
-        if (!model.isConnected()) {
-            throw(std::runtime_error("Could not connect to shared memory."));
-        }
-    }
-
-	/**
-	 * \brief 	Destructor for disconnecting from shared memory.
-	 */
-    ~GPS_Time() {
-        model.disconnectSharedMem();
     }
 
 	/// Internal transitions of the model
@@ -102,16 +91,17 @@ public:
 	/**
 	 *  \brief 		Operator for defining how the model state will be represented as a string.
 	 * 	\warning 	Prepended "State: " is required for log parsing, do not remove.
+	 * 	\note 		Until shared memory is connected the GPS time is logged as WAIT_FOR_DEPENDENCY.
 	 */
     friend std::ostringstream& operator<<(std::ostringstream& os, const typename GPS_Time<TIME>::state_type& i) {
-        os << (std::string("State: ") + std::to_string(model.sharedMemoryStruct->hg1700.time));
+        const Shared_Memory& shared_memory = Shared_Memory::instance();
+        if (shared_memory.connected()) {
+            os << (std::string("State: ") + std::to_string(shared_memory.model().sharedMemoryStruct->hg1700.time));
+        } else {
+            os << "State: WAIT_FOR_DEPENDENCY";
+        }
         return os;
     }
-
-private:
-	/// Manages the connection to shared memory
-    inline static SharedMemoryModel model{};
-
 };
 
 #endif // GPS_TIME_H
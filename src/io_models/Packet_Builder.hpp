@@ -16,9 +16,11 @@
 #include "../message_structures/message_fcc_command_t.hpp"
 #include "../message_structures/message_boss_mission_update_t.hpp"
 #include "../message_structures/message_landing_point_t.hpp"
+#include "../message_structures/shared_message_t.hpp"
 
 // Utility Functions
 #include "../enum_string_conversion.hpp"
+#include "../component_macros.hpp"
 #include <mavNRC/endian.hpp>
 
 // Constants
@@ -32,9 +34,11 @@
 #include <boost/container/vector.hpp>
 
 // System libraries
+#include <algorithm>
 #include <limits>
 #include <cstring>
 #include <cassert>
+#include <string_view>
 
 /**
  *	\class		Packet_Builder
@@ -132,10 +136,11 @@ public:
 			case States::IDLE: {
 				bool received_data = !cadmium::get_messages<typename Packet_Builder::defs::i_data>(mbs).empty();
 				if (received_data) {
-					std::vector<TYPE> temp = cadmium::get_messages<typename Packet_Builder::defs::i_data>(mbs);
-					for (int i = 0; i < temp.size(); i++) {
-						data.push_back(temp[i]);
-						preprocess_data(&data[i]);
+					// The message bag is owned by the transition, so the data is moved rather than copied.
+					// Forwarding references also bind the proxies of a std::vector<bool> bag.
+					for (auto&& data_point : cadmium::get_messages<typename Packet_Builder::defs::i_data>(mbs)) {
+						data.push_back(std::move(data_point));
+						preprocess_data(&data.back());
 					}
 					state.current_state = States::GENERATE_PACKET;
 				}
@@ -155,16 +160,18 @@ public:
 	/// Function for generating output from the model before internal transitions.
 	[[nodiscard]] typename cadmium::make_message_bags<output_ports>::type output() const {
 		typename cadmium::make_message_bags<output_ports>::type bags;
-		std::vector<std::vector<char>> packets;
 
 		switch (state.current_state) {
-			case States::GENERATE_PACKET:
-                for (int i = 0; i < data.size(); i++) {
-                    packets.push_back(generate_packet(&data[i]));
-                }
-                cadmium::get_messages<typename Packet_Builder::defs::o_packet>(bags) = packets;
-                data.clear();
+			case States::GENERATE_PACKET: {
+				// The packets are generated directly into the output bag.
+				std::vector<std::vector<char>>& packets = cadmium::get_messages<typename Packet_Builder::defs::o_packet>(bags);
+				packets.reserve(data.size());
+				for (TYPE& data_point : data) {
+					generate_packets(&data_point, packets);
+				}
+				data.clear();
 				break;
+			}
 			default:
 				break;
 		}
@@ -212,6 +219,11 @@ private:
         std::memcpy(packet.data(), (char *)data_point, sizeof(*data_point));
         return packet;
     }
+
+	/// Generates the packets for a data point - can be overloaded when a data point is split over several packets.
+	virtual void generate_packets(TYPE * data_point, std::vector<std::vector<char>>& packets) const {
+		packets.push_back(generate_packet(data_point));
+	}
 };
 
 /**
@@ -221,9 +233,16 @@ private:
 				simulation software. This model converts message_fcc_command_t messages into char buffers.
  */
 template<typename TIME>
-class Packet_Builder_Boss : public Packet_Builder<message_boss_mission_update_t, TIME> {
+class Packet_Builder_Boss : public Packet_Builder<shared_message_t<message_boss_mission_update_t>, TIME> {
 public:
 	Packet_Builder_Boss() = default;
+
+private:
+	[[nodiscard]] std::vector<char> generate_packet(shared_message_t<message_boss_mission_update_t> * data_point) const {
+		std::vector<char> packet(sizeof(message_boss_mission_update_t));
+		std::memcpy(packet.data(), (const char *)&**data_point, sizeof(message_boss_mission_update_t));
+		return packet;
+	}
 };
 
 /**
@@ -323,6 +342,51 @@ public:
     }
 };
 
+/**
+ *	\class		Packet_Builder_Perception_LP
+ *	\brief		Definition of the Packet Builder Perception LP atomic model.
+ *	\details	This class defines the Packet Builder Perception LP atomic model for use in the Cadmium DEVS
+				simulation software. This model converts message_landing_point_t messages into char buffers
+				sent by the perception system, in the format received by Supervisor_UDP_Input.
+ */
+template<typename TIME>
+class Packet_Builder_Perception_LP : public Packet_Builder<message_landing_point_t, TIME> {
+public:
+    Packet_Builder_Perception_LP() = default;
+
+    [[nodiscard]] virtual std::vector<char> generate_packet(message_landing_point_t * data_point) const {
+        std::vector<char> packet(sizeof(*data_point) + 3);
+        packet[0] = MY_MAV_SYS_ID;
+        packet[1] = COMP_ID_PERCEPTION_SYSTEM;
+        packet[2] = SUPERVISOR_SIG_ID_LP_RECEIVE;
+        std::memcpy(&packet[3], (char *)data_point, sizeof(*data_point));
+        return packet;
+    }
+};
+
+/**
+ *	\class		Packet_Builder_Mission_Manager_PLP
+ *	\brief		Definition of the Packet Builder Mission Manager PLP atomic model.
+ *	\details	This class defines the Packet Builder Mission Manager PLP atomic model for use in the Cadmium DEVS
+				simulation software. This model converts message_landing_point_t messages into char buffers
+				sent by the mission manager over mavNRC when a planned landing point is achieved, in the format
+				received by Supervisor_UDP_Input.
+ */
+template<typename TIME>
+class Packet_Builder_Mission_Manager_PLP : public Packet_Builder<message_landing_point_t, TIME> {
+public:
+    Packet_Builder_Mission_Manager_PLP() = default;
+
+    [[nodiscard]] virtual std::vector<char> generate_packet(message_landing_point_t * data_point) const {
+        std::vector<char> packet(sizeof(*data_point) + 3);
+        packet[0] = MY_MAV_SYS_ID;
+        packet[1] = COMP_ID_MISSION_MANAGER;
+        packet[2] = SUPERVISOR_SIG_ID_PLP_ACHIEVED;
+        std::memcpy(&packet[3], (char *)data_point, sizeof(*data_point));
+        return packet;
+    }
+};
+
 /**
  *	\class		Packet_Builder_Fcc
  *	\brief		Definition of the Packet Builder Fcc atomic model.
@@ -346,6 +410,7 @@ private:
  *	\brief		Definition of the Packet Builder GCS atomic model.
  *	\details	This class defines the Packet Builder GCS atomic model for use in the Cadmium DEVS
 				simulation software. This model converts message_update_gcs_t messages into char buffers.
+				Texts longer than one STATUSTEXT are sent as several chunks.
  */
 template<typename TIME>
 class Packet_Builder_GCS : public Packet_Builder<message_update_gcs_t, TIME> {
@@ -366,13 +431,20 @@ private:
 		uint64_t payload64[(MAVLINK_MAX_PAYLOAD_LEN+MAVLINK_NUM_CHECKSUM_BYTES+7)/8];
 	};
 
-	/// Mavlink compatible structure
+	/// Mavlink compatible structure, packed to match the field order on the wire
+#pragma pack(push, 1)
 	struct mavlink_statustext_t {
 		uint8_t severity;
-		char text[50];
+		char text[MAVLINK_MSG_STATUSTEXT_TEXT_LEN];
 		uint16_t id;
 		uint8_t chunk_seq;
 	};
+#pragma pack(pop)
+
+	/// Id of the last text split into chunks, 0 is reserved for texts sent in a single chunk
+	mutable uint16_t statustext_id{};
+	/// Sequence of the next packet, counted per packet since a text can be sent as several chunks
+	mutable uint8_t mavlink_sequence{};
 
 	/// Helper that generates the crc checksum
 	void crc_accumulate_CUSTOM(uint8_t data, uint16_t *crcAccum) const
@@ -418,32 +490,59 @@ private:
 	}
 
 	/// Used to craft mavlink packages
-	void create_message(mavlink_message_t * msg, message_update_gcs_t * data_point) const {
+	void create_message(mavlink_message_t * msg, uint8_t severity, std::string_view text, uint16_t id, uint8_t chunk_seq) const {
 		mavlink_statustext_t status_text{};
-		status_text.severity = data_point->severity;
-		status_text.id = 0;
-		status_text.chunk_seq = 0;
-	    std::memcpy(status_text.text, data_point->text.c_str(), sizeof(char) * 50);
-	    std::memcpy((char *)msg->payload64, &status_text, MAVLINK_MSG_ID_STATUSTEXT_LEN);
+		status_text.severity = severity;
+		status_text.id = id;
+		status_text.chunk_seq = chunk_seq;
+		std::memcpy(status_text.text, text.data(), text.size());
+		std::memcpy((char *)msg->payload64, &status_text, MAVLINK_MSG_ID_STATUSTEXT_LEN);
 		msg->msgid = MAVLINK_MSG_ID_STATUSTEXT;
 		msg->magic = MAVLINK_STX;
-		msg->len = strlen((char *)msg->payload64);
+		// Mavlink 2 drops the zeros at the end of the payload.
+		msg->len = MAVLINK_MSG_ID_STATUSTEXT_LEN;
+		while (msg->len > 1 && ((const uint8_t *)msg->payload64)[msg->len - 1] == 0) {
+			msg->len--;
+		}
 		msg->sysid = MY_MAV_SYS_ID;
 		msg->compid = MY_MAV_COMP_ID;
 		msg->incompat_flags = 0;
 		msg->compat_flags = 0;
-		msg->seq = this->packet_sequence;
+		msg->seq = mavlink_sequence++;
 	}
 
-	[[nodiscard]] std::vector<char> generate_packet(message_update_gcs_t * data_point) const {
+	/// Generates the packet for one chunk of the text, at most MAVLINK_MSG_STATUSTEXT_TEXT_LEN long.
+	[[nodiscard]] std::vector<char> generate_chunk(uint8_t severity, std::string_view text, uint16_t id, uint8_t chunk_seq) const {
 		mavlink_message_t msg{};
-		create_message(&msg, data_point);
+		create_message(&msg, severity, text, id, chunk_seq);
 
         std::vector<char> packet(MAVLINK_CORE_HEADER_LEN + msg.len + 3); // 3 = checksum(2 bytes) + magic(1 byte)
 		create_packet((uint8_t *)packet.data(), &msg);
 
 		return packet;
 	}
+
+	/// Splits texts longer than one STATUSTEXT into chunks with the same id, which is 0 for a single chunk.
+	void generate_packets(message_update_gcs_t * data_point, std::vector<std::vector<char>>& packets) const {
+		std::string_view text = data_point->str();
+		uint8_t severity = data_point->severity;
+		uint16_t id = 0;
+		if (text.size() > MAVLINK_MSG_STATUSTEXT_TEXT_LEN) {
+			if (++statustext_id == 0) {
+				statustext_id = 1;
+			}
+			id = statustext_id;
+		}
+
+		// A null in the text marks the last chunk, so a text filling its last chunk is followed by an empty one.
+		uint8_t chunk_seq = 0;
+		for (size_t offset = 0; ; offset += MAVLINK_MSG_STATUSTEXT_TEXT_LEN) {
+			packets.push_back(generate_chunk(severity, text.substr(std::min(offset, text.size()), MAVLINK_MSG_STATUSTEXT_TEXT_LEN), id, chunk_seq++));
+			if (id == 0 || offset + MAVLINK_MSG_STATUSTEXT_TEXT_LEN > text.size()) {
+				break;
+			}
+		}
+	}
 };
 
 #endif // PACKET_BUILDER_HPP
@@ -0,0 +1,278 @@
+/**
+ * 	\file		Perception_Load_Generator.hpp
+ *	\brief		Definition of the Perception Load Generator atomic model.
+ *	\details	This header file defines the Perception Load Generator atomic model for use in the Cadmium DEVS
+				simulation software. The model stands in for the perception system, sending landing points
+				at a set rate so that the landing point ingress path can be stress tested.
+ */
+
+#ifndef PERCEPTION_LOAD_GENERATOR_HPP
+#define PERCEPTION_LOAD_GENERATOR_HPP
+
+// Messages structures
+#include "../message_structures/message_landing_point_t.hpp"
+
+// Utility functions
+#include "../enum_string_conversion.hpp"
+#include "../ingress_statistics.hpp"
+#include "../lp_load_pattern.hpp"
+#include "../time_conversion.hpp"
+#include "../timer_wheel.hpp"
+
+// Constants
+#include "../Constants.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+
+// System libraries
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ *	\class		Perception_Load_Generator
+ *	\brief		Definition of the Perception Load Generator atomic model.
+ *	\details	This class defines the Perception Load Generator atomic model for use in the Cadmium DEVS
+				simulation software. Landing points from an LP_Load_Pattern are sent in batches, one batch
+				every PERCEPTION_LOAD_MIN_PERIOD or slower, so that rates of up to 10 kHz do not need a
+				transition for every landing point. The landing points coming out of the ingress path are
+				fed back to the model, which reports the throughput, the drop rate, the number of landing points
+				in flight and the latency through the path once the load has drained, then asks the ingress
+				path to quit.
+ */
+template<typename TIME>
+class Perception_Load_Generator {
+public:
+	/**
+	 *	\par	States
+	 * 	Declaration of the states of the atomic model.
+	 */
+	DEFINE_ENUM_WITH_STRING_CONVERSIONS(States,
+		(GENERATE)
+		(DRAIN)
+		(REPORT)
+		(DONE)
+	);
+
+	/**
+	 *	\brief	For definition of the input and output ports see:
+	*	\ref 	Perception_Load_Generator_input_ports "Input Ports" and
+	*	\ref 	Perception_Load_Generator_output_ports "Output Ports"
+	* 	\note 	All input and output ports must be listed in this struct.
+	*/
+	struct defs {
+		struct i_lp_recv : public cadmium::in_port<message_landing_point_t> { };
+		struct o_lp : public cadmium::out_port<message_landing_point_t> { };
+		struct o_quit : public cadmium::out_port<bool> { };
+	};
+
+	/**
+	 * 	\anchor	Perception_Load_Generator_input_ports
+	 *	\par	Input Ports
+	 * 	Definition of the input ports for the model.
+	 * 	\param 	i_lp_recv	Port for receiving the landing points coming out of the ingress path.
+	 */
+	using input_ports = std::tuple<typename defs::i_lp_recv>;
+
+	/**
+	 *	\anchor	Perception_Load_Generator_output_ports
+	 * 	\par 	Output Ports
+	 * 	Definition of the output ports for the model.
+	 * 	\param	o_lp	Port for sending the generated landing points into the ingress path.
+	 * 	\param	o_quit	Port for telling the ingress path to stop once the load has been reported.
+	 */
+	using output_ports = std::tuple<
+		typename defs::o_lp,
+		typename defs::o_quit
+	>;
+
+	/**
+	 *	\anchor	Perception_Load_Generator_state_type
+	 *	\par	State
+	 * 	Definition of the states of the atomic model.
+	 * 	\param 	current_state 	Current state of atomic model.
+	 * 	\param 	sent 			Number of landing points sent.
+	 * 	\param 	received 		Number of landing points that came out of the ingress path.
+	 */
+	struct state_type {
+		States current_state;
+		size_t sent;
+		size_t received;
+	} state;
+
+	/**
+	 * \brief 	Default constructor for the model.
+	 */
+	Perception_Load_Generator() : Perception_Load_Generator(10.0, TIME("00:00:10:000"), LP_Load_Pattern()) {}
+
+	/**
+	 * \brief 	Constructor for the model with the rate, duration and pattern of the load.
+	 * \param	i_rate_hz	double number of landing points sent each second.
+	 * \param	duration	TIME for which landing points are sent.
+	 * \param	i_pattern	LP_Load_Pattern pattern the landing points are generated from.
+	 */
+	Perception_Load_Generator(double i_rate_hz, TIME duration, LP_Load_Pattern i_pattern) : pattern(i_pattern) {
+		state.current_state = States::GENERATE;
+		state.sent = 0;
+		state.received = 0;
+		rate_hz = std::max(i_rate_hz, 0.0);
+		duration_seconds = time_to_seconds(duration);
+		current_time = TIME();
+		credit = 0.0;
+
+		// Slow loads get a batch per landing point, fast loads are batched at the shortest period.
+		period = TIME(PERCEPTION_LOAD_MIN_PERIOD);
+		batch_size = rate_hz * time_to_seconds(period);
+		if (rate_hz > 0.0 && batch_size < 1.0) {
+			period = seconds_to_time<TIME>(1.0 / rate_hz);
+			batch_size = 1.0;
+		}
+
+		timers.arm("duration", duration);
+		timers.arm("batch", period);
+		fill_batch();
+	}
+
+	/// Internal transitions of the model
+	void internal_transition() {
+		TIME elapsed = time_advance();
+		timers.advance(elapsed);
+		current_time = current_time + elapsed;
+
+		switch (state.current_state) {
+			case States::GENERATE:
+				if (timers.expired("batch")) {
+					// The batch was output this step.
+					for (const auto& lp : batch) {
+						statistics.sent(lp.id, time_to_seconds(current_time));
+					}
+					state.sent += batch.size();
+					statistics.sample_depth();
+					timers.arm("batch", period);
+					fill_batch();
+				}
+				if (timers.expired("duration")) {
+					timers.cancel("batch");
+					timers.arm("drain", TIME(PERCEPTION_LOAD_DRAIN_TIME));
+					state.current_state = States::DRAIN;
+				}
+				break;
+			case States::DRAIN:
+				if (timers.expired("drain")) {
+					state.current_state = States::REPORT;
+				}
+				break;
+			case States::REPORT:
+				std::cout << "[Perception Load Generator] Rate: " << rate_hz << " Hz Throughput: " << throughput() << " Hz " << statistics << std::endl;
+				state.current_state = States::DONE;
+				break;
+			default:
+				break;
+		}
+	}
+
+	/// External transitions of the model
+	void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		timers.advance(e);
+		current_time = current_time + e;
+
+		for (const auto& lp : cadmium::get_messages<typename defs::i_lp_recv>(mbs)) {
+			statistics.received(lp.id, time_to_seconds(current_time));
+		}
+		state.received = statistics.received_messages();
+	}
+
+	/// Function used to decide precedence between internal and external transitions when both are scheduled simultaneously.
+	void confluence_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		internal_transition();
+		external_transition(TIME(), std::move(mbs));
+	}
+
+	/// Function for generating output from the model before internal transitions.
+	[[nodiscard]] typename cadmium::make_message_bags<output_ports>::type output() const {
+		typename cadmium::make_message_bags<output_ports>::type bags;
+
+		switch (state.current_state) {
+			case States::GENERATE:
+				if (!(time_advance() < timers.remaining("batch"))) {
+					cadmium::get_messages<typename defs::o_lp>(bags) = batch;
+				}
+				break;
+			case States::REPORT:
+				cadmium::get_messages<typename defs::o_quit>(bags).push_back(true);
+				break;
+			default:
+				break;
+		}
+		return bags;
+	}
+
+	/// Function to declare the time advance value for each state of the model.
+	TIME time_advance() const {
+		switch (state.current_state) {
+			case States::GENERATE:
+			case States::DRAIN:
+				return timers.next_expiry();
+			case States::REPORT:
+				return TIME(TA_ZERO);
+			case States::DONE:
+				return std::numeric_limits<TIME>::infinity();
+			default:
+				assert(false && "Unhandled state time advance.");
+		}
+	}
+
+	/**
+	 *  \brief 		Operator for defining how the model state will be represented as a string.
+	 * 	\warning 	Prepended "State: " is required for log parsing, do not remove.
+	 */
+	friend std::ostringstream& operator<<(std::ostringstream& os, const typename Perception_Load_Generator<TIME>::state_type& i) {
+		os << "State: " << enumToString(i.current_state) << "-" << i.sent << "-" << i.received;
+		return os;
+	}
+
+private:
+	/// Variable for the pattern the landing points are generated from.
+	LP_Load_Pattern pattern;
+	/// Variable for storing the number of landing points sent each second.
+	double rate_hz;
+	/// Variable for storing the number of seconds landing points are sent for.
+	double duration_seconds;
+	/// Variable for storing the period between batches of landing points.
+	TIME period;
+	/// Variable for tracking the simulation time used to timestamp the landing points.
+	TIME current_time;
+	/// Variable for storing the mean number of landing points in each batch.
+	double batch_size;
+	/// Variable for storing the fraction of a landing point carried over to the next batch.
+	double credit;
+	/// Variable for storing the landing points sent in the next batch.
+	std::vector<message_landing_point_t> batch;
+	/// Variable for the statistics of the landing points sent and received.
+	Ingress_Statistics statistics;
+	/// Variable for tracking the ("batch", "duration" and "drain") timers.
+	Timer_Wheel<TIME> timers;
+
+	/// @return	Number of landing points that came out of the ingress path for each second they were sent for.
+	[[nodiscard]] double throughput() const {
+		return (duration_seconds > 0.0) ? statistics.received_messages() / duration_seconds : 0.0;
+	}
+
+	/// Function for generating the landing points of the next batch.
+	void fill_batch() {
+		credit += batch_size;
+		size_t count = static_cast<size_t>(credit);
+		credit -= count;
+		batch.clear();
+		for (size_t i = 0; i < count; i++) {
+			batch.push_back(pattern.next());
+		}
+	}
+};
+
+#endif // PERCEPTION_LOAD_GENERATOR_HPP
@@ -13,6 +13,8 @@
 
 // Utility functions
 #include "../enum_string_conversion.hpp"
+#include "../timer_wheel.hpp"
+#include "../aircraft_state_source.hpp"
 
 // Constants
 #include "../Constants.hpp"
@@ -21,11 +23,9 @@
 #include <cadmium/modeling/ports.hpp>
 #include <cadmium/modeling/message_bag.hpp>
 
-// Shared Memory Model
-#include <sharedmemorymodel/SharedMemoryModel.h>
-
 // System libraries
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -115,31 +115,21 @@ public:
 
 	/// Internal transitions of the model
 	void internal_transition() {
-		if (state.condition_met) {
-			state.current_state = States::IDLE;
-			state.condition_met = false;
-		}
-		else if (state.current_state == States::POLL && check_condition()) {
-			state.condition_met = true;
-		}
+		timers.advance(time_advance());
+		poll();
 	}
 
 	/// External transitions of the model
-	void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
-		bool received_quit = !cadmium::get_messages<typename defs::i_quit>(mbs).empty();
-		bool received_start = !cadmium::get_messages<typename defs::i_start>(mbs).empty();
-
-		if (received_quit) {
-			state.current_state = States::IDLE;
-		} else if (received_start) {
-			state.current_state = States::POLL;
-		}
+	void external_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		timers.advance(e);
+		handle_inputs(mbs);
 	}
 
 	/// Function used to decide precedence between internal and external transitions when both are scheduled simultaneously.
-	void confluence_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
-		external_transition(TIME(), std::move(mbs));
-		internal_transition();
+	void confluence_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		timers.advance(e);
+		handle_inputs(mbs);
+		poll();
 	}
 
 	/// Function for generating output from the model before internal transitions.
@@ -161,7 +151,7 @@ public:
 					return TIME(TA_ZERO);
 				}
 				else {
-					return polling_rate;
+					return timers.remaining("poll");
 				}
 			default:
 				return TIME(TA_ZERO);
@@ -183,6 +173,41 @@ protected:
 	/// Used to verify the shared memory is accessible.
 	virtual bool check_condition() {return false;};
 	TIME polling_rate;
+	/// Used to track the time until the next poll ("poll").
+	Timer_Wheel<TIME> timers;
+
+private:
+	/// Function for handling the start and quit inputs.
+	void handle_inputs(const typename cadmium::make_message_bags<input_ports>::type& mbs) {
+		bool received_quit = !cadmium::get_messages<typename defs::i_quit>(mbs).empty();
+		bool received_start = !cadmium::get_messages<typename defs::i_start>(mbs).empty();
+
+		if (received_quit) {
+			timers.cancel("poll");
+			state.current_state = States::IDLE;
+		} else if (received_start) {
+			// Keep the polling cadence if already polling.
+			if (!timers.armed("poll")) {
+				timers.arm("poll", polling_rate);
+			}
+			state.current_state = States::POLL;
+		}
+	}
+
+	/// Function for checking the condition when the poll timer expires.
+	void poll() {
+		if (state.condition_met) {
+			state.current_state = States::IDLE;
+			state.condition_met = false;
+		}
+		else if (state.current_state == States::POLL && timers.expired("poll")) {
+			if (check_condition()) {
+				state.condition_met = true;
+			} else {
+				timers.arm("poll", polling_rate);
+			}
+		}
+	}
 };
 
 /**
@@ -227,7 +252,8 @@ private:
  *	\class		Polling_Condition_Input
  *	\brief		Definition of the Polling Condition Input atomic model.
  *	\details	This class defines the Polling Condition Input atomic model for use in the Cadmium DEVS
-				simulation software. The model polls shared memory for aircraft height when requested.
+				simulation software. The model polls the aircraft state source, the shared memory by default,
+				for aircraft height when requested.
  */
 template<typename TIME>
 class Polling_Condition_Input_Landing_Achieved : public Polling_Condition_Input<message_fcc_command_t, bool, TIME> {
@@ -244,38 +270,35 @@ public:
 		}
 	}
 
-    Polling_Condition_Input_Landing_Achieved(TIME rate, float landing_height_ft) :
+    Polling_Condition_Input_Landing_Achieved(TIME rate, float landing_height_ft, std::shared_ptr<Aircraft_State_Source> source = Shared_Memory_State_Source::instance()) :
 		Polling_Condition_Input<message_fcc_command_t, bool, TIME>(rate),
-		landing_height_ft(landing_height_ft) {
+		landing_height_ft(landing_height_ft),
+		source(std::move(source)) {
 		if (!setup()) {
 			throw(std::runtime_error("Could not set up polling condition input for landing achieved."));
 		}
 	}
 
-	~Polling_Condition_Input_Landing_Achieved() {
-		model.disconnectSharedMem();
-	}
-
+	/// The source connects in the background, the landing is not achieved until it has connected.
 	bool setup() {
-		model = SharedMemoryModel();
-		model.connectSharedMem();
-		return model.isConnected();
+		return source != nullptr;
 	}
 
 	bool check_condition() {
-		return (model.sharedMemoryStruct->hg1700.mixedhgt < landing_height_ft);
+		return source->connected() && (source->aircraft_state().alt_AGL < landing_height_ft);
 	}
 
 private:
-	SharedMemoryModel model;
 	float landing_height_ft{};
+	std::shared_ptr<Aircraft_State_Source> source = Shared_Memory_State_Source::instance();
 };
 
 /**
  *	\class		Polling_Condition_Input
  *	\brief		Definition of the Polling Condition Input atomic model.
  *	\details	This class defines the Polling Condition Input atomic model for use in the Cadmium DEVS
-				simulation software. The model polls shared memory for safety status when requested.
+				simulation software. The model polls the aircraft state source, the shared memory by default,
+				for safety status when requested.
  */
 template<typename TIME>
 class Polling_Condition_Input_Pilot_Takeover : public Polling_Condition_Input<message_start_supervisor_t, bool, TIME> {
@@ -286,27 +309,26 @@ public:
 		}
 	}
 
-    explicit Polling_Condition_Input_Pilot_Takeover(TIME rate) :
-		Polling_Condition_Input<message_start_supervisor_t, bool, TIME>(rate) {
+    explicit Polling_Condition_Input_Pilot_Takeover(TIME rate, std::shared_ptr<Aircraft_State_Source> source = Shared_Memory_State_Source::instance()) :
+		Polling_Condition_Input<message_start_supervisor_t, bool, TIME>(rate),
+		source(std::move(source)) {
 		if (!setup()) {
 			throw(std::runtime_error("Could not set up polling condition input for pilot takeover."));
 		}
 	}
 
-	~Polling_Condition_Input_Pilot_Takeover() {
-		model.disconnectSharedMem();
-	}
-
+	/// The source connects in the background, the pilot has not taken over until it has connected.
 	bool setup() {
-		engaged = ((1 << 0) | (1 << 1));
-		model = SharedMemoryModel();
-		model.connectSharedMem();
-		return model.isConnected();
+		engaged = FCC_ENGAGED_BITS;
+		return source != nullptr;
 	}
 
 	bool check_condition() {
+		if (!source->connected()) {
+			return false;
+		}
 		// Store the status bits
-		uint32_t status = model.sharedMemoryStruct->hmu_safety.safety_status;
+		uint32_t status = source->safety_status();
 		// Clear all but the FCC engaged bits
 		status &= engaged;
 		// If both FCC engaged bits are set, return true
@@ -314,8 +336,8 @@ public:
 	}
 
 private:
-	SharedMemoryModel model;
 	uint32_t engaged{};
+	std::shared_ptr<Aircraft_State_Source> source = Shared_Memory_State_Source::instance();
 };
 
 #endif /* POLLING_CONDITION_INPUT_HPP */
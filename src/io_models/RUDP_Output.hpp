@@ -15,6 +15,7 @@
 // Utility functions
 #include "../enum_string_conversion.hpp"
 #include "../Constants.hpp"
+#include "../tracepoints.hpp"
 
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
@@ -132,8 +133,9 @@ public:
 		bool received_message = !cadmium::get_messages<typename defs::i_message>(mbs).empty();
 		if (received_message){
 			state.current_state = States::SENDING;
-			for (std::vector<char> m : cadmium::get_messages<typename defs::i_message>(mbs)) {
-				state.messages.push_back(m);
+			// The message bag is owned by the transition, so the packets are moved rather than copied.
+			for (std::vector<char>& m : cadmium::get_messages<typename defs::i_message>(mbs)) {
+				state.messages.push_back(std::move(m));
 			}
 		}
     }
@@ -184,11 +186,13 @@ protected:
 private:
     /// Function send_packets is used to send all the packets in the message queue to the destination via the RUDP connection.
     void send_packets() const {
-        for (std::vector<char> m : state.messages) {
+        for (const std::vector<char>& m : state.messages) {
 			try {
             	connection->send(m.data(), m.size());
+				SUPERVISOR_TRACE(packet_send, "rudp", static_cast<uint64_t>(m.size()), 0);
 			}
             catch (std::runtime_error& error) {
+				SUPERVISOR_TRACE(packet_send, "rudp", static_cast<uint64_t>(m.size()), 1);
                 std::cout << "[RUDP Output] (ERROR) Error sending packet using RUDP Output model: " << error.what() << std::endl;
             }
         }
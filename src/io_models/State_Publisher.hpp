@@ -0,0 +1,133 @@
+/**
+ * 	\file		State_Publisher.hpp
+ *	\brief		Definition of the State Publisher atomic model.
+ *	\details	This header file defines the State Publisher atomic model for use in the Cadmium DEVS
+				simulation software. The model stores each aircraft state it receives in an aircraft state
+				source, so that the input models of a vehicle read the state of an emulated aircraft as they
+				would read the shared memory.
+ */
+
+#ifndef STATE_PUBLISHER_HPP
+#define STATE_PUBLISHER_HPP
+
+// Messages structures
+#include "../message_structures/message_aircraft_state_t.hpp"
+
+// Utility functions
+#include "../aircraft_state_source.hpp"
+#include "../enum_string_conversion.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+
+// System libraries
+#include <limits>
+#include <memory>
+#include <sstream>
+
+/**
+ *	\class		State_Publisher
+ *	\brief		Definition of the State Publisher atomic model.
+ *	\details	This class defines the State Publisher atomic model for use in the Cadmium DEVS
+				simulation software. The latest aircraft state received is set in the source, which can be
+				read from the other models of the process.
+ */
+template<typename TIME>
+class State_Publisher {
+public:
+	/**
+	 *	\par	States
+	 * 	Declaration of the states of the atomic model.
+	 */
+	DEFINE_ENUM_WITH_STRING_CONVERSIONS(States, (PUBLISH));
+
+	/**
+	 *	\brief	For definition of the input and output ports see:
+	 *	\ref 	State_Publisher_input_ports "Input Ports" and
+	 *	\ref 	State_Publisher_output_ports "Output Ports"
+	 * 	\note 	All input and output ports must be listed in this struct.
+	 */
+	struct defs {
+		struct i_aircraft_state : public cadmium::in_port<message_aircraft_state_t> { };
+	};
+
+	/**
+	 * 	\anchor	State_Publisher_input_ports
+	 *	\par	Input Ports
+	 * 	Definition of the input ports for the model.
+	 * 	\param 	i_aircraft_state	Port for receiving the aircraft state to publish.
+	 */
+	using input_ports = std::tuple<typename defs::i_aircraft_state>;
+
+	/**
+	 *	\anchor	State_Publisher_output_ports
+	 * 	\par 	Output Ports
+	 * 	Definition of the output ports for the model.
+	 */
+	using output_ports = std::tuple<>;
+
+	/**
+	 *	\anchor	State_Publisher_state_type
+	 *	\par	State
+	 * 	Definition of the states of the atomic model.
+	 * 	\param 	current_state 	Current state of atomic model.
+	 */
+	struct state_type {
+		States current_state;
+	} state;
+
+	/**
+	 * \brief 	Default constructor for the model, publishing to a source of its own.
+	 */
+	State_Publisher() : State_Publisher(std::make_shared<Stored_State_Source>()) {}
+
+	/**
+	 * \brief 	Constructor for the model with the source the aircraft state is published to.
+	 * \param	i_state_source	std::shared_ptr<Stored_State_Source> source read by the input models of the vehicle.
+	 */
+	explicit State_Publisher(std::shared_ptr<Stored_State_Source> i_state_source) : state_source(std::move(i_state_source)) {
+		state.current_state = States::PUBLISH;
+	}
+
+	/// Internal transitions of the model
+	void internal_transition() {}
+
+	/// External transitions of the model
+	void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		if (!cadmium::get_messages<typename defs::i_aircraft_state>(mbs).empty()) {
+			state_source->set(cadmium::get_messages<typename defs::i_aircraft_state>(mbs).back());
+		}
+	}
+
+	/// Function used to decide precedence between internal and external transitions when both are scheduled simultaneously.
+	void confluence_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		internal_transition();
+		external_transition(TIME(), std::move(mbs));
+	}
+
+	/// Function for generating output from the model before internal transitions.
+	[[nodiscard]] typename cadmium::make_message_bags<output_ports>::type output() const {
+		return {};
+	}
+
+	/// Function to declare the time advance value for each state of the model.
+	TIME time_advance() const {
+		return std::numeric_limits<TIME>::infinity();
+	}
+
+	/**
+	 *  \brief 		Operator for defining how the model state will be represented as a string.
+	 * 	\warning 	Prepended "State: " is required for log parsing, do not remove.
+	 */
+	friend std::ostringstream& operator<<(std::ostringstream& os, const typename State_Publisher<TIME>::state_type& i) {
+		os << "State: " << enumToString(i.current_state);
+		return os;
+	}
+
+private:
+	/// Variable for storing the source the aircraft state is published to.
+	std::shared_ptr<Stored_State_Source> state_source;
+};
+
+#endif // STATE_PUBLISHER_HPP
@@ -16,11 +16,16 @@
 #include "../message_structures/message_landing_point_t.hpp"
 #include "../message_structures/message_fcc_command_t.hpp"
 #include "../message_structures/message_start_supervisor_t.hpp"
+#include "../message_structures/message_waypoint_update_t.hpp"
 
 // Utility functions
 #include "../enum_string_conversion.hpp"
 #include "../Constants.hpp"
 #include "../component_macros.hpp"
+#include "../dependency.hpp"
+#include "../io_thread.hpp"
+#include "../loop_monitor.hpp"
+#include "../tracepoints.hpp"
 
 // RUDP Library
 #include <RUDP/src/ConnectionController.hpp>
@@ -32,10 +37,12 @@
 #include <cadmium/modeling/dynamic_model.hpp>
 
 // System libraries
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <csignal>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <cstring>
@@ -76,6 +83,7 @@ public:
 		struct o_start_supervisor 	: public cadmium::out_port<message_start_supervisor_t> { };
 		struct o_perception_status	: public cadmium::out_port<bool> { };
 		struct o_waypoint 			: public cadmium::out_port<message_fcc_command_t> { };
+		struct o_waypoint_update 	: public cadmium::out_port<message_waypoint_update_t> { };
 		struct o_lp_recv			: public cadmium::out_port<message_landing_point_t> { };
 		struct o_plp_ach 			: public cadmium::out_port<message_landing_point_t> { };
 		struct i_quit 				: public cadmium::in_port<bool> { };
@@ -96,6 +104,7 @@ public:
 	 * 	\param 	o_start_supervisor	Port to forward any start supervisor messages to the Supervisor.
 	 * 	\param 	o_perception_status	Port to forward any perception status messages to the Supervisor.
 	 * 	\param 	o_waypoint			Port to forward any waypoint messages to the Supervisor.
+	 * 	\param 	o_waypoint_update	Port to forward any waypoint update messages to the Supervisor.
 	 * 	\param 	o_lp_recv			Port to forward any landing point messages to the Supervisor.
 	 * 	\param 	o_plp_ach			Port to forward any planned landing point messages to the Supervisor.
 	 */
@@ -103,6 +112,7 @@ public:
 		typename defs::o_start_supervisor,
 		typename defs::o_perception_status,
 		typename defs::o_waypoint,
+		typename defs::o_waypoint_update,
 		typename defs::o_lp_recv,
 		typename defs::o_plp_ach
 	>;
@@ -126,15 +136,12 @@ public:
 		state.current_state = States::INPUT;
 		state.has_messages = false;
 		polling_rate = TIME("00:00:00:100");
-		stop = false;
 
-		//Create the network endpoint
-		connection_number = rudp::ConnectionController::addConnection(DEFAULT_TIMEOUT_MS);
-		connection = rudp::ConnectionController::getConnection(connection_number);
-		connection->setEndpointLocal(2300);
+		//Create the network endpoint, which is bound to the local port by the user input thread.
+		receiver_state = std::make_shared<receiver_t>(2300);
 
-		//Start the user input thread.
-		std::thread(&Supervisor_UDP_Input::receive_packet_thread, this).detach();
+		//Start the user input thread, which shares what it uses so that it can outlive the model.
+		receiver.start("Supervisor UDP Input", [r = receiver_state] { receive_packet_thread(*r); }, true);
 	}
 
 	/**
@@ -146,38 +153,29 @@ public:
 		state.current_state = States::INPUT;
 		state.has_messages = false;
 		polling_rate = rate;
-		stop = false;
 
-		//Create the network endpoint
-		connection_number = rudp::ConnectionController::addConnection(DEFAULT_TIMEOUT_MS);
-		connection = rudp::ConnectionController::getConnection(connection_number);
-		connection->setEndpointLocal(port);
+		//Create the network endpoint, which is bound to the local port by the user input thread.
+		receiver_state = std::make_shared<receiver_t>(port);
 
-		//Start the user input thread.
-		std::thread(&Supervisor_UDP_Input::receive_packet_thread, this).detach();
+		//Start the user input thread, which shares what it uses so that it can outlive the model.
+		receiver.start("Supervisor UDP Input", [r = receiver_state] { receive_packet_thread(*r); }, true);
 	}
 
 	/**
 	 * \brief 	Destructor for the model.
 	 */
 	~Supervisor_UDP_Input() {
-		stop = true;
-		rudp::ConnectionController::removeConnection(connection_number);
+		// The connection is removed by the last of the model and the thread to let go of it.
+		receiver.stop([r = receiver_state] { r->stop(); });
 	}
 
 	/// Internal transitions of the model
 	void internal_transition() {
 		if (state.current_state == States::INPUT) {
-			std::unique_lock<std::mutex> mutexLock(input_mutex, std::defer_lock);
+			std::unique_lock<std::mutex> mutexLock(receiver_state->input_mutex, std::defer_lock);
 			//If the thread has finished receiving input, change state if there are messages.
 			if (mutexLock.try_lock()) {
-				state.has_messages = (
-					!message_start_supervisor.empty() ||
-					!message_perception_status.empty() ||
-					!message_waypoint.empty() ||
-					!message_lp_recv.empty() ||
-					!message_plp_ach.empty()
-				);
+				state.has_messages = receiver_state->pending_messages() > 0;
 			}
 		}
 	}
@@ -187,6 +185,8 @@ public:
         bool received_quit = !cadmium::get_messages<typename defs::i_quit>(mbs).empty();
 		if (received_quit) {
 			state.current_state = States::IDLE;
+			receiver.request_stop();
+			receiver_state->stop();
 		}
 	}
 
@@ -202,32 +202,38 @@ public:
 
 		if (state.current_state == States::INPUT) {
 			//If the lock is free and there are messages, send the messages.
-			std::unique_lock<std::mutex> mutexLock(input_mutex, std::defer_lock);
+			std::unique_lock<std::mutex> mutexLock(receiver_state->input_mutex, std::defer_lock);
 			if (state.has_messages && mutexLock.try_lock()) {
-				if (!message_start_supervisor.empty()) {
-					cadmium::get_messages<typename defs::o_start_supervisor>(bags) = message_start_supervisor;
-					message_start_supervisor.clear();
+				if (!receiver_state->message_start_supervisor.empty()) {
+					cadmium::get_messages<typename defs::o_start_supervisor>(bags) = receiver_state->message_start_supervisor;
+					receiver_state->message_start_supervisor.clear();
 				}
 
-				if (!message_perception_status.empty()) {
-					cadmium::get_messages<typename defs::o_perception_status>(bags) = message_perception_status;
-					message_perception_status.clear();
+				if (!receiver_state->message_perception_status.empty()) {
+					cadmium::get_messages<typename defs::o_perception_status>(bags) = receiver_state->message_perception_status;
+					receiver_state->message_perception_status.clear();
 				}
 
-				if (!message_waypoint.empty()) {
-					cadmium::get_messages<typename defs::o_waypoint>(bags) = message_waypoint;
-					message_waypoint.clear();
+				if (!receiver_state->message_waypoint.empty()) {
+					cadmium::get_messages<typename defs::o_waypoint>(bags) = receiver_state->message_waypoint;
+					receiver_state->message_waypoint.clear();
 				}
 
-				if (!message_lp_recv.empty()) {
-					cadmium::get_messages<typename defs::o_lp_recv>(bags) = message_lp_recv;
-					message_lp_recv.clear();
+				if (!receiver_state->message_waypoint_update.empty()) {
+					cadmium::get_messages<typename defs::o_waypoint_update>(bags) = receiver_state->message_waypoint_update;
+					receiver_state->message_waypoint_update.clear();
 				}
 
-				if (!message_plp_ach.empty()) {
-					cadmium::get_messages<typename defs::o_plp_ach>(bags) = message_plp_ach;
-					message_plp_ach.clear();
+				if (!receiver_state->message_lp_recv.empty()) {
+					cadmium::get_messages<typename defs::o_lp_recv>(bags) = receiver_state->message_lp_recv;
+					receiver_state->message_lp_recv.clear();
 				}
+
+				if (!receiver_state->message_plp_ach.empty()) {
+					cadmium::get_messages<typename defs::o_plp_ach>(bags) = receiver_state->message_plp_ach;
+					receiver_state->message_plp_ach.clear();
+				}
+				Loop_Monitor::queue_depth(receiver_state->loop_queue, 0);
 			}
 		}
 		return bags;
@@ -259,37 +265,104 @@ public:
 	}
 
 private:
-    /// Variable for the mutex for thread synchronization using unique locks.
-    mutable std::mutex input_mutex;
-    /// Queues to store the start supervisor packets that have been received by the child thread until they can be forwarded.
-    mutable std::vector<message_start_supervisor_t> message_start_supervisor;
-	/// Queues to store the perception_status packets that have been received by the child thread until they can be forwarded.
-    mutable std::vector<bool> message_perception_status;
-	/// Queues to store the waypoint packets that have been received by the child thread until they can be forwarded.
-    mutable std::vector<message_fcc_command_t> message_waypoint;
-	/// Queues to store the landing point packets that have been received by the child thread until they can be forwarded.
-    mutable std::vector<message_landing_point_t> message_lp_recv;
-	/// Queues to store the planned landing point packets that have been received by the child thread until they can be forwarded.
-    mutable std::vector<message_landing_point_t> message_plp_ach;
-
-    /// Variable to store a pointer to the RUDP connection that will be used to receive the packets.
-    rudp::Connection * connection;
-	/// Variable to store the number of the RUDP connection that will be used to receive the packets.
-    int connection_number;
-    /// Buffer to hold the bytes received by RUDP until they can be parsed.
-    char recv_buffer[MAX_SER_BUFFER_CHARS]{};
+	/**
+	 *	\struct	receiver_t
+	 *	\brief	Definition of everything the receive thread uses.
+	 *	\details	The model and the thread share ownership of the receiver, so that a thread still blocked in
+	 *				the RUDP receive when the model is destroyed can be detached without using freed memory.
+	 *				The RUDP connection is removed once neither of them uses it.
+	 */
+	struct receiver_t {
+		/**
+		 * \brief 	Constructor for the receiver with the port it receives the packets on.
+		 * \param	port	unsigned short port number that the connection should be bound to.
+		 */
+		explicit receiver_t(unsigned short port) : local_port(port) {
+			connection_number = rudp::ConnectionController::addConnection(DEFAULT_TIMEOUT_MS);
+			connection = rudp::ConnectionController::getConnection(connection_number);
+			loop_queue = Loop_Monitor::add_queue();
+		}
+
+		~receiver_t() {
+			rudp::ConnectionController::removeConnection(connection_number);
+		}
+
+		receiver_t(const receiver_t&) = delete;
+		receiver_t& operator=(const receiver_t&) = delete;
+
+		/// Variable for the mutex for thread synchronization using unique locks.
+		std::mutex input_mutex;
+		/// Queues to store the start supervisor packets that have been received by the child thread until they can be forwarded.
+		std::vector<message_start_supervisor_t> message_start_supervisor;
+		/// Queues to store the perception_status packets that have been received by the child thread until they can be forwarded.
+		std::vector<bool> message_perception_status;
+		/// Queues to store the waypoint packets that have been received by the child thread until they can be forwarded.
+		std::vector<message_fcc_command_t> message_waypoint;
+		std::vector<message_waypoint_update_t> message_waypoint_update;
+		/// Queues to store the landing point packets that have been received by the child thread until they can be forwarded.
+		std::vector<message_landing_point_t> message_lp_recv;
+		/// Queues to store the planned landing point packets that have been received by the child thread until they can be forwarded.
+		std::vector<message_landing_point_t> message_plp_ach;
+
+		/// Variable to store a pointer to the RUDP connection that will be used to receive the packets.
+		rudp::Connection * connection;
+		/// Variable to store the number of the RUDP connection that will be used to receive the packets.
+		int connection_number;
+		/// Variable to store the local port that the RUDP connection receives the packets on.
+		unsigned short local_port;
+		/// Buffer to hold the bytes received by RUDP until they can be parsed.
+		char recv_buffer[MAX_SER_BUFFER_CHARS]{};
+		/// Index of the queue depth reported in the loop watchdog heartbeat.
+		size_t loop_queue;
+		/// Whether the thread has been asked to stop, read by the thread instead of the state of the model.
+		std::atomic<bool> stopping{false};
+
+		/**
+		 * \brief	Function stop is used to ask the thread to stop and interrupt its receive.
+		 * \details	The receive is interrupted by sending a packet to the local port through an RUDP connection
+		 *			of its own, so that the packet is framed and acknowledged like any other the library receives.
+		 */
+		void stop() {
+			// Only the first stop wakes the thread, which may have returned since.
+			if (stopping.exchange(true, std::memory_order_acq_rel)) {
+				return;
+			}
+			int wake_number = rudp::ConnectionController::addConnection(RUDP_WAKE_TIMEOUT_MS);
+			try {
+				rudp::Connection * wake_connection = rudp::ConnectionController::getConnection(wake_number);
+				wake_connection->setEndpointRemote(LOCALHOST, local_port);
+				wake_connection->setSendRetriesLimit(1);
+				char wake = 0;
+				wake_connection->send(&wake, sizeof(wake));
+			}
+			catch (std::runtime_error& error) {
+				std::cout << "[Supervisor UDP Input] (ERROR) Could not wake the receive thread: " << error.what() << std::endl;
+			}
+			rudp::ConnectionController::removeConnection(wake_number);
+		}
+
+		/// @return	Number of received packets waiting to be forwarded, input_mutex must be held.
+		[[nodiscard]] size_t pending_messages() const {
+			return message_start_supervisor.size() + message_perception_status.size() + message_waypoint.size() +
+				   message_waypoint_update.size() + message_lp_recv.size() + message_plp_ach.size();
+		}
+	};
+
+	/// Variable for the receiver shared with the receive thread.
+	std::shared_ptr<receiver_t> receiver_state;
 
     /// Variable for rate at which the message queues should be polled by the model.
     TIME polling_rate;
 
-    /// Variable for thread synchronization.
-    bool stop;
+	/// Thread receiving the packets, declared last so that it is stopped before the members it uses are destroyed.
+	IO_Thread receiver;
 
 	/**
 	 * 	\anchor		Supervisor_UDP_Input_child_thread
 	 *	\brief		Function receive_packet_thread is used as a child thread for receiving UDP packets via RUDP.
-	 * 	\details	The thread is started in the model constructor and constantly receives packets via RUDP until
-	 * 				the model is passivated. The packets received by the thread are expected to follow a predefined
+	 * 	\details	The thread is started in the model constructor and stopped by the destructor. It binds the
+	 * 				connection to the local port, retrying with a backoff while the port is unavailable, and then
+	 * 				constantly receives packets via RUDP until the model is passivated or the thread is stopped. The packets received by the thread are expected to follow a predefined
 	 * 				protocol in order to be parsed and forwarded onto the Supervisor.
 	 *	\par		Interface Details
 	 * 				The model only accepts RUDP packets sent with a Mavlink-like structure:
@@ -303,13 +376,40 @@ private:
 	 *	\param 		waypoint			System ID: Helicopter (1),	Component ID: Mission Manager 	(3),	Signal ID: waypoint 			(3),	Payload: message_fcc_command_t
 	 *	\param 		lp_recv				System ID: Helicopter (1),	Component ID: Perception System	(2),	Signal ID: lp_recv 				(4),	Payload: message_landing_point_t
 	 *	\param 		plp_ach				System ID: Helicopter (1),	Component ID: Mission Manager	(3),	Signal ID: plp_ach 				(5),	Payload: message_landing_point_t
+	 *	\param 		waypoint_update		System ID: Helicopter (1),	Component ID: Mission Manager	(3),	Signal ID: waypoint_update		(6),	Payload: message_waypoint_update_t
 	 */
-	void receive_packet_thread() {
+	static void receive_packet_thread(receiver_t& r) {
+		//Bind to the local port without holding up the startup of the other models.
+		bool listening = retry_with_backoff("Supervisor UDP input on port " + std::to_string(r.local_port),
+			[&r] {
+				r.connection->setEndpointLocal(r.local_port);
+				return true;
+			},
+			[&r] { return r.stopping.load(std::memory_order_acquire); },
+			[&r](std::chrono::milliseconds delay) {
+				// Wait in short steps so that stopping the thread is not held up by the backoff.
+				auto until = std::chrono::steady_clock::now() + delay;
+				while (!r.stopping.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < until) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+			});
+		if (!listening) {
+			return;
+		}
+
 		//While the model is not passivated,
-		while (state.current_state != States::IDLE && !stop) {
-			char* sender_address = new char[IPV4_ADDRESS_LENGTH_BYTES];
+		while (!r.stopping.load(std::memory_order_acquire)) {
+			char sender_address[IPV4_ADDRESS_LENGTH_BYTES]{};
 			int sender_port;
-			int bytes_received = connection->receive(recv_buffer, MAX_SER_BUFFER_CHARS, sender_address, &sender_port);
+			int bytes_received = r.connection->receive(r.recv_buffer, MAX_SER_BUFFER_CHARS, sender_address, &sender_port);
+			// The packet that woke the thread to stop is not parsed.
+			if (r.stopping.load(std::memory_order_acquire)) {
+				break;
+			}
+			// The component and signal IDs follow the system ID at the start of every packet.
+			SUPERVISOR_TRACE(packet_receive, bytes_received,
+				(bytes_received >= 3) ? static_cast<int>(static_cast<uint8_t>(r.recv_buffer[1])) : -1,
+				(bytes_received >= 3) ? static_cast<int>(static_cast<uint8_t>(r.recv_buffer[2])) : -1);
 
 			bool error_occured = false;
 			uint8_t sysid;
@@ -323,7 +423,7 @@ private:
             byte_cache = std::vector<char>(sizeof(sysid));
             for (int i = 0; i < sizeof(sysid); i++)
             {
-                byte_cache[i] = (char)recv_buffer[i + offset];
+                byte_cache[i] = (char)r.recv_buffer[i + offset];
             }
             offset += sizeof(sysid);
             if (!std::memcpy(&sysid, byte_cache.data(), sizeof(sysid))) {
@@ -337,7 +437,7 @@ private:
 				byte_cache = std::vector<char>(sizeof(compid));
 				for (int i = 0; i < sizeof(compid); i++)
 				{
-					byte_cache[i] = (char)recv_buffer[i + offset];
+					byte_cache[i] = (char)r.recv_buffer[i + offset];
 				}
 				offset += sizeof(compid);
 				if (!std::memcpy(&compid, byte_cache.data(), sizeof(compid))) {
@@ -352,7 +452,7 @@ private:
 				byte_cache = std::vector<char>(sizeof(sigid));
 				for (int i = 0; i < sizeof(sigid); i++)
 				{
-					byte_cache[i] = (char)recv_buffer[i + offset];
+					byte_cache[i] = (char)r.recv_buffer[i + offset];
 				}
 				offset += sizeof(sigid);
 				if (!std::memcpy(&sigid, byte_cache.data(), sizeof(sigid))) {
@@ -367,41 +467,42 @@ private:
 				byte_cache = std::vector<char>(data_length);
 				for (int i = 0; i < data_length; i++)
 				{
-					byte_cache[i] = (char)recv_buffer[i + offset];
+					byte_cache[i] = (char)r.recv_buffer[i + offset];
 				}
 
 				message_start_supervisor_t temp_start_supervisor;
 				bool temp_bool;
 				message_landing_point_t temp_landing_point;
 				message_fcc_command_t temp_fcc_command_waypoint;
-				std::unique_lock<std::mutex> mutexLock(input_mutex);
+				message_waypoint_update_t temp_waypoint_update;
+				std::unique_lock<std::mutex> mutexLock(r.input_mutex);
 
                 // std::cout << "SYS: " << sysid << "\tCOMP: " << compid << "\tSIG: " << sigid << std::endl;
                 if (sigid == SUPERVISOR_SIG_ID_PLP_ACHIEVED && compid == COMP_ID_MISSION_MANAGER) {
                     std::memcpy(&temp_landing_point, byte_cache.data(), sizeof(temp_landing_point));
-                    message_plp_ach.push_back(temp_landing_point);
-                    state.has_messages = true;
+                    r.message_plp_ach.push_back(temp_landing_point);
                 }
                 if (sigid == SUPERVISOR_SIG_ID_WAYPOINT && compid == COMP_ID_MISSION_MANAGER) {
                     std::memcpy(&temp_fcc_command_waypoint, byte_cache.data(), sizeof(temp_fcc_command_waypoint));
-                    message_waypoint.push_back(temp_fcc_command_waypoint);
-                    state.has_messages = true;
+                    r.message_waypoint.push_back(temp_fcc_command_waypoint);
+                }
+                if (sigid == SUPERVISOR_SIG_ID_WAYPOINT_UPDATE && compid == COMP_ID_MISSION_MANAGER) {
+                    std::memcpy(&temp_waypoint_update, byte_cache.data(), sizeof(temp_waypoint_update));
+                    r.message_waypoint_update.push_back(temp_waypoint_update);
                 }
                 if (sigid ==  SUPERVISOR_SIG_ID_START_SUPERVISOR && compid == COMP_ID_MISSION_MANAGER) {
                     std::memcpy(&temp_start_supervisor, byte_cache.data(), sizeof(temp_start_supervisor));
-                    message_start_supervisor.push_back(temp_start_supervisor);
-                    state.has_messages = true;
+                    r.message_start_supervisor.push_back(temp_start_supervisor);
                 }
                 if (sigid == SUPERVISOR_SIG_ID_PERCEPTION_STATUS && compid == COMP_ID_PERCEPTION_SYSTEM) {
                     std::memcpy(&temp_bool, byte_cache.data(), sizeof(temp_bool));
-                    message_perception_status.push_back(temp_bool);
-                    state.has_messages = true;
+                    r.message_perception_status.push_back(temp_bool);
                 }
                 if (sigid == SUPERVISOR_SIG_ID_LP_RECEIVE && compid == COMP_ID_PERCEPTION_SYSTEM) {
                     std::memcpy(&temp_landing_point, byte_cache.data(), sizeof(temp_landing_point));
-                    message_lp_recv.push_back(temp_landing_point);
-                    state.has_messages = true;
+                    r.message_lp_recv.push_back(temp_landing_point);
                 }
+				Loop_Monitor::queue_depth(r.loop_queue, r.pending_messages());
 			}
 		}
 	}
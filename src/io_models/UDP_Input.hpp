@@ -18,6 +18,7 @@
 // Utility functions
 #include "../enum_string_conversion.hpp"
 #include "../Constants.hpp"
+#include "../io_thread.hpp"
 
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
@@ -27,6 +28,7 @@
 #include <boost/asio.hpp>
 
 // System Libraries
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <string>
@@ -89,12 +91,10 @@ public:
 	 * 	Definition of the states of the atomic model.
 	 * 	\param 	current_state 	Current state of atomic model.
 	 * 	\param	has_messages	State variable indicating if any packets have been received since the last poll.
-	 * 	\param	message			Queue of messages that have been received by the child thread.
 	 */
 	struct state_type {
 		States current_state;
 		bool has_messages;
-		mutable std::vector<MSG> message;
 	};
 	state_type state;
 
@@ -108,7 +108,6 @@ public:
 
 		polling_rate = TIME("00:00:00:100");
 		send_ack = false;
-		stop = false;
 
 		//Create the network endpoint using a default address and port.
 		unsigned short port_num = MAVLINK_OVER_UDP_PORT;
@@ -119,7 +118,7 @@ public:
 		// std::signal(SIGTERM, UDP_Input::handle_signal);
 
 		//Start the user input thread.
-		std::thread(&UDP_Input::receive_packet_thread, this).detach();
+		receiver.start("UDP Input", [this] { receive_packet_thread(); });
 	}
 
 	/**
@@ -135,7 +134,6 @@ public:
 
 		polling_rate = rate;
 		send_ack = ack_required;
-		stop = false;
 
 		//Create the network endpoint using the supplied address and port.
 		auto port_num = (unsigned short)strtoul(port.c_str(), nullptr, 0);
@@ -146,7 +144,7 @@ public:
 		// std::signal(SIGTERM, UDP_Input::handle_signal);
 
 		//Start the user input thread.
-		std::thread(&UDP_Input::receive_packet_thread, this).detach();
+		receiver.start("UDP Input", [this] { receive_packet_thread(); });
 	}
 
 	/**
@@ -161,13 +159,10 @@ public:
 		shutdown();
 	}
 
-	/// Member for shutting down the thread and IO services gracefully.
+	/// Member for shutting down the thread and IO services gracefully, the socket is closed by the thread.
 	void shutdown() {
-		//Before exiting stop the Boost IO service to interrupt the receipt handler.
-		stop = true;
-		io_service.stop();
-		if (socket.is_open())
-			socket.close();
+		//Stopping the Boost IO service interrupts the receipt handler, which the thread is waiting on.
+		receiver.stop([this] { io_service.stop(); });
 	}
 
 	/// Internal transitions of the model
@@ -185,6 +180,9 @@ public:
 	void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
 		if (cadmium::get_messages<typename defs::i_quit>(mbs).size() >= 1) {
 			state.current_state = States::IDLE;
+			//Stop listening without waiting for another packet.
+			receiver.request_stop();
+			io_service.stop();
 		}
 	}
 
@@ -201,10 +199,9 @@ public:
 			case States::INPUT:
 				std::unique_lock<std::mutex> mutexLock(input_mutex, std::defer_lock);
 				if (state.has_messages && mutexLock.try_lock()) {
-					for (auto msg: state.message) {
-						cadmium::get_messages<typename defs::o_message>(bags).push_back(msg);
-					}
-					state.message.clear();
+					// The messages are forwarded in the order they were received.
+					cadmium::get_messages<typename defs::o_message>(bags) = std::move(message);
+					message.clear();
 				}
 				break;
 		}
@@ -239,7 +236,7 @@ public:
 private:
     /// Variable for the mutex for thread synchronization using unique locks.
 	mutable std::mutex input_mutex;
-	/// Stores multiple messages
+	/// Queue of the messages received by the child thread until they are forwarded, guarded by input_mutex.
 	mutable std::vector<MSG> message;
 	/// Variable to store the endpoint that the model for listen for packets on.
 	boost::asio::ip::udp::endpoint endpoint_local;
@@ -257,8 +254,8 @@ private:
     /// Variable for rate at which the message queues should be polled by the model.
 	TIME polling_rate;
 
-    /// Variable for thread synchronization.
-	bool stop;
+	/// Thread receiving the packets, declared last so that it is stopped before the members it uses are destroyed.
+	IO_Thread receiver;
 
 	/**
 	 * 	\anchor		UDP_Input_child_thread
@@ -272,37 +269,37 @@ private:
 		socket.open(boost::asio::ip::udp::v4());
 		socket.bind(endpoint_local);
 
-		//While the model is not passivated,
-		while (state.current_state != States::IDLE && !stop) {
-			//Reset the io service then asynchronously receive a packet and
-			//use the handler to add it to the message vector.
-			io_service.restart();
-			socket.async_receive_from(
-				boost::asio::buffer(recv_buffer),
-				endpoint_remote,
-				bind(
-					&UDP_Input::receive_packet,
-					this,
-					boost::asio::placeholders::error,
-					boost::asio::placeholders::bytes_transferred));
-
-			//Receive one packet then loop.
-			io_service.run_one();
-		}
+		//Receive packets until the model is passivated or the thread is stopped, which stops the IO service.
+		start_receive();
+		io_service.run();
 		//Once done, close the socket.
 		socket.close();
 	}
 
+	/// Function for receiving the next packet, the handler adds it to the message vector then receives the next one.
+	void start_receive() {
+		if (receiver.stopping()) {
+			return;
+		}
+		socket.async_receive_from(
+			boost::asio::buffer(recv_buffer),
+			endpoint_remote,
+			[this](const boost::system::error_code& error, size_t bytes_transferred) {
+				receive_packet(error, bytes_transferred);
+				start_receive();
+			});
+	}
+
 	/// Handler that is called on UDP packet receipt by Boost.
 	void receive_packet(const boost::system::error_code& error, size_t bytes_transferred) {
 		// Acquire the unique lock for the message vector.
 		std::unique_lock<std::mutex> mutexLock(input_mutex);
 		if (error) return;
 
-		//Add the message to the vector.
+		//Add the message to the vector, ignoring any bytes past the end of the message.
 		MSG recv = MSG();
-		memcpy(&recv, &recv_buffer, bytes_transferred);
-		state.message.insert(message.begin(), recv);
+		memcpy(&recv, &recv_buffer, std::min(bytes_transferred, sizeof(MSG)));
+		message.push_back(recv);
 
 		// If an ack is required,
 		if (send_ack) {
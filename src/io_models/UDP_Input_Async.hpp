@@ -18,6 +18,7 @@
 // Utility functions
 #include "../enum_string_conversion.hpp"
 #include "../Constants.hpp"
+#include "../io_thread.hpp"
 
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
@@ -106,7 +107,6 @@ public:
 		state.has_messages = !state.message.empty();
 
 		send_ack = false;
-		stop = false;
 
 		//Create the network endpoint using a default address and port.
 		unsigned short port_num = MAVLINK_OVER_UDP_PORT;
@@ -117,7 +117,7 @@ public:
 		// std::signal(SIGTERM, UDP_Input_Async::handle_signal);
 
 		//Start the user input thread.
-		std::thread(&UDP_Input_Async::receive_packet_thread, this).detach();
+		receiver.start("UDP Input Async", [this] { receive_packet_thread(); });
 	}
 
 	/**
@@ -132,7 +132,6 @@ public:
 		_sub = sub;
 
 		send_ack = ack_required;
-		stop = false;
 
 		//Create the network endpoint using the supplied address and port.
 		unsigned short port_num = strtoul(port.c_str(), nullptr, 0);
@@ -143,7 +142,7 @@ public:
 		// std::signal(SIGTERM, UDP_Input_Async::handle_signal);
 
 		//Start the user input thread.
-		std::thread(&UDP_Input_Async::receive_packet_thread, this).detach();
+		receiver.start("UDP Input Async", [this] { receive_packet_thread(); });
 	}
 
 	/**
@@ -158,13 +157,10 @@ public:
 		shutdown();
 	}
 
-	/// Member for shutting down the thread and IO services gracefully.
+	/// Member for shutting down the thread and IO services gracefully, the socket is closed by the thread.
 	void shutdown() {
-		//Before exiting stop the Boost IO service to interrupt the receipt handler.
-		stop = true;
-		io_service.stop();
-		if (socket.is_open())
-			socket.close();
+		//Stopping the Boost IO service interrupts the receipt handler, which the thread is waiting on.
+		receiver.stop([this] { io_service.stop(); });
 	}
 
 	/// Internal transitions of the model
@@ -186,6 +182,9 @@ public:
 
 		if (cadmium::get_messages<typename defs::i_quit>(mbs).size() >= 1) {
 			state.current_state = States::IDLE;
+			//Stop listening without waiting for another packet.
+			receiver.request_stop();
+			io_service.stop();
 		}
 	}
 
@@ -252,8 +251,8 @@ private:
 	/// Variable to indicate if an acknowledgement should be sent back to the sender on packet receipt.
 	bool send_ack;
 
-    /// Variable for thread synchronization.
-	bool stop;
+	/// Thread receiving the packets, declared last so that it is stopped before the members it uses are destroyed.
+	IO_Thread receiver;
 
 	/**
 	 * 	\anchor		UDP_Input_Async_child_thread
@@ -267,27 +266,27 @@ private:
 		socket.open(boost::asio::ip::udp::v4());
 		socket.bind(network_endpoint);
 
-		//While the model is not passivated,
-		while (state.current_state != States::IDLE && !stop) {
-			//Reset the io service then asynchronously receive a packet and
-			//use the handler to add it to the state.message vector.
-			io_service.reset();
-			socket.async_receive_from(
-				boost::asio::buffer(recv_buffer),
-				remote_endpoint,
-				bind(
-				&UDP_Input_Async::receive_packet,
-				this,
-				boost::asio::placeholders::error,
-				boost::asio::placeholders::bytes_transferred));
-
-			//Receive one packet then loop.
-			io_service.run_one();
-		}
+		//Receive packets until the model is passivated or the thread is stopped, which stops the IO service.
+		start_receive();
+		io_service.run();
 		//Once done, close the socket.
 		socket.close();
 	}
 
+	/// Function for receiving the next packet, the handler adds it to the message vector then receives the next one.
+	void start_receive() {
+		if (receiver.stopping()) {
+			return;
+		}
+		socket.async_receive_from(
+			boost::asio::buffer(recv_buffer),
+			remote_endpoint,
+			[this](const boost::system::error_code& error, size_t bytes_transferred) {
+				receive_packet(error, bytes_transferred);
+				start_receive();
+			});
+	}
+
 	/// Handler that is called on UDP packet receipt by Boost.
 	void receive_packet(const boost::system::error_code& error, size_t bytes_transferred) {
 		// Acquire the unique lock for the state.message vector.
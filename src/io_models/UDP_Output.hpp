@@ -15,6 +15,7 @@
 // Utility functions
 #include "../enum_string_conversion.hpp"
 #include "../Constants.hpp"
+#include "../tracepoints.hpp"
 
 // Cadmium Simulator Headers
 #include <cadmium/modeling/ports.hpp>
@@ -118,8 +119,9 @@ public:
 		bool received_message = !cadmium::get_messages<typename defs::i_message>(mbs).empty();
 		if (received_message){
 			state.current_state = States::SENDING;
-			for (std::vector<char> m : cadmium::get_messages<typename defs::i_message>(mbs)) {
-				state.messages.push_back(m);
+			// The message bag is owned by the transition, so the packets are moved rather than copied.
+			for (std::vector<char>& m : cadmium::get_messages<typename defs::i_message>(mbs)) {
+				state.messages.push_back(std::move(m));
 			}
 		}
     }
@@ -188,8 +190,9 @@ private:
 				std::cout << "[UDP Output] (ERROR) Error setting socket option in UDP Output model: " << err.message() << std::endl;
 			}
 		}
-        for (std::vector<char> m : state.messages) {
+        for (const std::vector<char>& m : state.messages) {
             socket.send_to(boost::asio::buffer(m.data(), m.size()), network_endpoint, 0, err);
+			SUPERVISOR_TRACE(packet_send, "udp", static_cast<uint64_t>(m.size()), err ? 1 : 0);
 			if (err) {
                 std::cout << "[UDP Output] (ERROR) Error sending packet using UDP Output model: " << err.message() << std::endl;
             }
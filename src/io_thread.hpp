@@ -0,0 +1,124 @@
+/**
+ * 	\file		io_thread.hpp
+ *	\brief		Definition of the I/O threads owned by the input models.
+ *	\details	This header file defines a worker thread that is owned by a model instead of being detached,
+				so that the model can stop it and wait for it before the members the thread uses are destroyed.
+ */
+
+#ifndef IO_THREAD_HPP
+#define IO_THREAD_HPP
+
+// Constants
+#include "Constants.hpp"
+
+// System Libraries
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+/**
+ * 	\class		IO_Thread
+ *	\brief		Definition of an I/O thread owned by a model.
+ *	\details	The thread runs a body until the body returns, which it must do soon after stop is requested.
+				Stopping sets the atomic stop flag, calls a wake function that interrupts whatever the body is
+				blocked on, and waits up to IO_THREAD_SHUTDOWN_MS for the body to return before joining the
+				thread. A thread that misses the deadline is reported. If its body was started as detachable,
+				holding shared ownership of everything it uses, it is detached and left to return on its own,
+				so that shutting down stays bounded even when a library call cannot be interrupted. Otherwise
+				the body uses the members of its owner, so the owner keeps waiting for it rather than
+				destroying them under it.
+ */
+class IO_Thread {
+public:
+	IO_Thread() = default;
+	IO_Thread(const IO_Thread&) = delete;
+	IO_Thread& operator=(const IO_Thread&) = delete;
+
+	/// Destructor which stops the thread if its owner has not, without a way to wake it.
+	~IO_Thread() {
+		stop([] {});
+	}
+
+	/**
+	 * \brief 	Function start is used to start running the body in the thread.
+	 * \param	thread_name	Name of the thread for reporting errors.
+	 * \param	body		Function run by the thread, returning once stopping is true.
+	 * \param	detachable	Whether the body holds shared ownership of everything it uses, so that it can outlive
+	 * 						the IO_Thread and its owner if it misses the stop deadline.
+	 */
+	void start(const std::string& thread_name, std::function<void()> body, bool detachable = false) {
+		name = thread_name;
+		can_detach = detachable;
+		stop_flag.store(false, std::memory_order_release);
+		auto finished_promise = std::make_shared<std::promise<void>>();
+		finished = finished_promise->get_future();
+		// The worker only uses what it captures, so that a detached worker does not use the IO_Thread.
+		worker = std::thread([thread_name, body = std::move(body), finished_promise] {
+			try {
+				body();
+			}
+			catch (std::exception& error) {
+				std::cout << "[" << thread_name << "] (ERROR) " << error.what() << std::endl;
+			}
+			finished_promise->set_value();
+		});
+	}
+
+	/**
+	 * \brief 	Function request_stop is used to ask the body to return without waiting for it.
+	 * \details	Models call it from their transitions when they passivate, so that the body only has to check
+	 * 			the atomic stop flag instead of reading the model state that the simulation thread writes.
+	 */
+	void request_stop() {
+		stop_flag.store(true, std::memory_order_release);
+	}
+
+	/// @return	true once the thread has been asked to stop.
+	[[nodiscard]] bool stopping() const {
+		return stop_flag.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * \brief 	Function stop is used to stop the thread and wait for it to finish.
+	 * \param	wake		Function interrupting the body, called once the stop flag is set.
+	 * \param	deadline	Longest time to wait for the body to return before reporting it.
+	 */
+	void stop(const std::function<void()>& wake, std::chrono::milliseconds deadline = std::chrono::milliseconds(IO_THREAD_SHUTDOWN_MS)) {
+		if (!worker.joinable()) {
+			return;
+		}
+		stop_flag.store(true, std::memory_order_release);
+		wake();
+		if (finished.wait_for(deadline) == std::future_status::ready) {
+			worker.join();
+			return;
+		}
+		if (can_detach) {
+			std::cout << "[" << name << "] (ERROR) Thread did not stop within " << deadline.count() << " ms, detaching it." << std::endl;
+			worker.detach();
+			return;
+		}
+		std::cout << "[" << name << "] (ERROR) Thread did not stop within " << deadline.count() << " ms, waiting for it." << std::endl;
+		worker.join();
+	}
+
+private:
+	/// Name of the thread for reporting errors.
+	std::string name;
+	/// Whether the body can outlive the IO_Thread, so the thread can be detached.
+	bool can_detach = false;
+	/// Whether the thread has been asked to stop.
+	std::atomic<bool> stop_flag{false};
+	/// Future that becomes ready once the body has returned.
+	std::future<void> finished;
+	/// Thread running the body.
+	std::thread worker;
+};
+
+#endif // IO_THREAD_HPP
@@ -0,0 +1,152 @@
+/**
+ * 	\file		loop_monitor.hpp
+ *	\brief		Definition of the loop monitor of the Supervisor.
+ *	\details	This header file defines the timestamps of the iterations of the runner and the depths of
+				the message queues, which are written by the runner and the models and read by the loop
+				watchdog.
+ */
+
+#ifndef LOOP_MONITOR_HPP
+#define LOOP_MONITOR_HPP
+
+// Utility functions
+#include "time_conversion.hpp"
+
+// Constants
+#include "Constants.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/logger/common_loggers.hpp>
+
+// System Libraries
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * 	\class		Loop_Monitor
+ *	\brief		Definition of the timestamps and queue depths read by the loop watchdog.
+ *	\details	The runner thread writes the time of each of its iterations, and the time it was scheduled
+				for, to the next slot of a ring, and the watchdog reads every slot newer than the last one it read.
+				Models with a queue that fills while the loop is late register it once and store its depth.
+				Only one runner is expected per process.
+ */
+class Loop_Monitor {
+public:
+	/**
+	 *	\struct	beat_t
+	 * 	\brief 	Definition of an iteration of the runner.
+	 * 	\param 	time		Time of the steady clock in nanoseconds when the iteration ran.
+	 *	\param	scheduled	Time of the runner in nanoseconds the iteration was scheduled for.
+	 */
+	struct beat_t {
+		uint64_t time;
+		uint64_t scheduled;
+	};
+
+	/// @brief 	Function beat is used to timestamp an iteration of the runner.
+	/// @param 	scheduled	uint64_t time of the runner in nanoseconds the iteration was scheduled for.
+	static void beat(uint64_t scheduled) {
+		slot_t& slot = beats[next_beat++ % LOOP_WATCHDOG_BEATS];
+		// The slot is marked empty while it is rewritten, so the watchdog never pairs a time with the wrong schedule.
+		slot.time.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.scheduled.store(scheduled, std::memory_order_relaxed);
+		slot.time.store(now(), std::memory_order_release);
+	}
+
+	/// @return	Index of a new queue watched by the heartbeat, queues past LOOP_WATCHDOG_MAX_QUEUES are ignored.
+	static size_t add_queue() {
+		return queue_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/// @brief 	Function queue_depth is used to store the number of messages waiting in a queue.
+	/// @param 	index	Index of the queue.
+	/// @param 	depth	size_t number of messages waiting.
+	static void queue_depth(size_t index, size_t depth) {
+		if (index < LOOP_WATCHDOG_MAX_QUEUES) {
+			queue_depths[index].store(depth, std::memory_order_relaxed);
+		}
+	}
+
+	/// @return	Time of the steady clock in nanoseconds, never 0 so that 0 marks an empty slot.
+	static uint64_t now() {
+		auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		return std::max<uint64_t>(static_cast<uint64_t>(ns), 1);
+	}
+
+	/// @return	Iterations after a time, oldest first.
+	static std::vector<beat_t> beats_after(uint64_t time) {
+		std::vector<beat_t> stamps;
+		for (const slot_t& slot : beats) {
+			uint64_t stamp = slot.time.load(std::memory_order_acquire);
+			if (stamp <= time) {
+				continue;
+			}
+			uint64_t scheduled = slot.scheduled.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			// A slot rewritten while it was read is skipped, it is read again by the next heartbeat.
+			if (slot.time.load(std::memory_order_relaxed) == stamp) {
+				stamps.push_back(beat_t{stamp, scheduled});
+			}
+		}
+		std::sort(stamps.begin(), stamps.end(), [](const beat_t& a, const beat_t& b) { return a.time < b.time; });
+		return stamps;
+	}
+
+	/// @return	Number of queues registered.
+	static size_t queues() {
+		return std::min<size_t>(queue_count.load(std::memory_order_relaxed), LOOP_WATCHDOG_MAX_QUEUES);
+	}
+
+	/// @return	Number of messages waiting in a queue.
+	static size_t queue_depth(size_t index) {
+		return queue_depths[index].load(std::memory_order_relaxed);
+	}
+
+private:
+	/// Slot of the ring of iterations, the time is 0 while the slot is empty or being written.
+	struct slot_t {
+		std::atomic<uint64_t> time;
+		std::atomic<uint64_t> scheduled;
+	};
+
+	/// Ring of the latest iterations of the runner.
+	inline static std::array<slot_t, LOOP_WATCHDOG_BEATS> beats{};
+	/// Slot the next iteration is written to, only used by the runner thread.
+	inline static uint64_t next_beat = 0;
+	/// Number of queues registered.
+	inline static std::atomic<size_t> queue_count{0};
+	/// Depth of each registered queue.
+	inline static std::array<std::atomic<size_t>, LOOP_WATCHDOG_MAX_QUEUES> queue_depths{};
+};
+
+/**
+ * 	\struct		loop_monitor_logger
+ *	\brief		Logger that timestamps every iteration of the runner.
+ *	\details	The runner logs the global time once per iteration, so adding this logger first to the
+				multilogger of the runner gives the watchdog one beat per iteration. A blocked logger after
+				it delays the next beat, so it shows up in the heartbeat like any other stall. The global time
+				logged is the time the iteration was scheduled for.
+ */
+struct loop_monitor_logger {
+	template<typename DECLARED_SOURCE, typename... PARAMs>
+	static void log(const PARAMs&... params) {
+		if constexpr (std::is_same<DECLARED_SOURCE, cadmium::logger::logger_global_time>::value) {
+			Loop_Monitor::beat(scheduled_ns(params...));
+		}
+	}
+
+	/// @return	Global time of the runner in nanoseconds.
+	template<typename TIME, typename... REST>
+	static uint64_t scheduled_ns(const TIME& time, const REST&...) {
+		return static_cast<uint64_t>(std::llround(time_to_seconds(time) * 1E9));
+	}
+};
+
+#endif // LOOP_MONITOR_HPP
@@ -0,0 +1,240 @@
+/**
+ * 	\file		loop_watchdog.hpp
+ *	\brief		Definition of the loop watchdog of the Supervisor.
+ *	\details	This header file defines the watchdog that times every iteration of the runner and
+				publishes a heartbeat with the period and lateness of the loop, so that the GCS can tell the
+				Supervisor is alive and on time, and is alerted when it is not.
+ */
+
+#ifndef LOOP_WATCHDOG_HPP
+#define LOOP_WATCHDOG_HPP
+
+// Messages structures
+#include "message_structures/message_heartbeat_t.hpp"
+#include "message_structures/message_update_gcs_t.hpp"
+
+// Atomic model headers
+#include "io_models/Packet_Builder.hpp"
+
+// Utility functions
+#include "loop_monitor.hpp"
+
+// Constants
+#include "Constants.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/message_bag.hpp>
+
+// Boost Headers
+#include <boost/asio.hpp>
+
+// System Libraries
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 	\class		Loop_Watchdog
+ *	\brief		Definition of the loop watchdog of the Supervisor.
+ *	\details	This class reads the iterations of the runner in its own thread and sends a
+				message_heartbeat_t over UDP at a fixed rate. The period is the time between consecutive
+				iterations. The lateness of an iteration is how long after its scheduled time it ran, taking
+				the iteration before it as on time, so the mix of long waits and short transient steps of a
+				DEVS loop is not mistaken for jitter. When the 99th percentile of the lateness, or the time
+				since the last iteration beyond the longest period of the last second, exceeds the threshold,
+				the GCS is sent an alert, and is told again once the loop is back on time. The heartbeat and
+				alerts are sent from the watchdog thread, so they still go out while the loop is stalled.
+ */
+template<typename TIME>
+class Loop_Watchdog {
+public:
+	/**
+	 * \brief 	Constructor for the watchdog, which starts sending heartbeats immediately.
+	 * \param	address			const char * address the heartbeats are sent to.
+	 * \param	port			unsigned short port the heartbeats are sent to.
+	 * \param	rate_hz			unsigned int heartbeats sent per second, limited to 1 to 10.
+	 * \param	threshold_ms	unsigned int lateness or stall in milliseconds above which the GCS is alerted.
+	 */
+	explicit Loop_Watchdog(const char * address = IPV4_HEARTBEAT, unsigned short port = PORT_HEARTBEAT,
+						   unsigned int rate_hz = LOOP_WATCHDOG_RATE_HZ, unsigned int threshold_ms = LOOP_WATCHDOG_THRESHOLD_MS)
+			: socket(io_service), threshold_us(threshold_ms * 1000ULL), last_seen(Loop_Monitor::now()) {
+		boost::system::error_code err;
+		heartbeat_endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string(address, err), port);
+		gcs_endpoint = boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string(IPV4_GCS, err), PORT_GCS);
+		socket.open(boost::asio::ip::udp::v4(), err);
+		if (err) {
+			std::cout << "[Loop Watchdog] (ERROR) Could not open the heartbeat socket: " << err.message() << std::endl;
+			return;
+		}
+		rate_hz = std::clamp(rate_hz, 1U, 10U);
+		longest_periods.assign(rate_hz, 0);
+		watchdog = std::thread([this, rate_hz] { run(std::chrono::microseconds(1000000 / rate_hz)); });
+	}
+
+	Loop_Watchdog(const Loop_Watchdog&) = delete;
+	Loop_Watchdog& operator=(const Loop_Watchdog&) = delete;
+
+	/// Destructor which stops the watchdog and waits for its thread to finish.
+	~Loop_Watchdog() {
+		{
+			std::lock_guard<std::mutex> lock(stop_mutex);
+			stop = true;
+		}
+		stop_condition.notify_all();
+		if (watchdog.joinable()) {
+			watchdog.join();
+		}
+	}
+
+private:
+	/// Service owning the socket.
+	boost::asio::io_service io_service;
+	/// Socket the heartbeats and alerts are sent from.
+	boost::asio::ip::udp::socket socket;
+	/// Destination of the heartbeats.
+	boost::asio::ip::udp::endpoint heartbeat_endpoint;
+	/// Destination of the alerts.
+	boost::asio::ip::udp::endpoint gcs_endpoint;
+	/// Packet builder used to turn the alerts into STATUSTEXT packets.
+	Packet_Builder_GCS<TIME> gcs_builder;
+	/// Lateness or stall in microseconds above which the GCS is alerted.
+	uint64_t threshold_us;
+	/// Time of the newest iteration read.
+	uint64_t last_seen;
+	/// Newest iteration read, with a time of 0 before the first iteration.
+	Loop_Monitor::beat_t last_beat{0, 0};
+	/// Median period of the last heartbeat with iterations.
+	uint64_t usual_period = 0;
+	/// Longest period of each of the heartbeats of the last second, the longest wait the loop is expected to make.
+	std::vector<uint64_t> longest_periods;
+	/// Whether the GCS was alerted and not yet told the loop is back on time.
+	bool alerted = false;
+	/// Number of the next heartbeat.
+	uint32_t sequence = 0;
+	/// Variables for stopping the watchdog thread.
+	std::mutex stop_mutex;
+	std::condition_variable stop_condition;
+	bool stop = false;
+	/// Thread reading the iterations and sending the heartbeats.
+	std::thread watchdog;
+
+	/// Function run is used as the watchdog thread, sending a heartbeat every interval until stopped.
+	void run(std::chrono::microseconds interval) {
+		std::unique_lock<std::mutex> lock(stop_mutex);
+		auto next = std::chrono::steady_clock::now() + interval;
+		while (!stop_condition.wait_until(lock, next, [this] { return stop; })) {
+			next += interval;
+			message_heartbeat_t heartbeat = sample();
+			send(heartbeat_endpoint, std::vector<char>((const char *)&heartbeat, (const char *)&heartbeat + sizeof(heartbeat)));
+			if (heartbeat.alert && !alerted) {
+				char alert_text[MAVLINK_MSG_STATUSTEXT_TEXT_LEN + 1];
+				if (heartbeat.late_p99_us > threshold_us) {
+					std::snprintf(alert_text, sizeof(alert_text), "Supervisor loop late by %ums", heartbeat.late_p99_us / 1000);
+				} else {
+					std::snprintf(alert_text, sizeof(alert_text), "Supervisor loop stalled for %ums", heartbeat.stall_us / 1000);
+				}
+				alert_gcs(message_update_gcs_t(alert_text, Mav_Severities_E::MAV_SEVERITY_ALERT));
+			} else if (!heartbeat.alert && alerted) {
+				alert_gcs(message_update_gcs_t(GCS_Text_E::LOOP_ON_TIME, Mav_Severities_E::MAV_SEVERITY_INFO));
+			}
+			alerted = heartbeat.alert;
+		}
+	}
+
+	/// @return	Heartbeat describing the iterations since the last heartbeat.
+	message_heartbeat_t sample() {
+		message_heartbeat_t heartbeat;
+		heartbeat.sequence = sequence++;
+
+		std::vector<Loop_Monitor::beat_t> stamps = Loop_Monitor::beats_after(last_seen);
+		uint64_t now = Loop_Monitor::now();
+		heartbeat.iterations = static_cast<uint32_t>(stamps.size());
+
+		std::vector<uint64_t> periods;
+		std::vector<uint64_t> lateness;
+		for (const Loop_Monitor::beat_t& stamp : stamps) {
+			if (last_beat.time != 0) {
+				uint64_t period = stamp.time - last_beat.time;
+				// The iteration was scheduled for the time the runner advanced by after the previous iteration.
+				uint64_t scheduled_period = (stamp.scheduled > last_beat.scheduled) ? stamp.scheduled - last_beat.scheduled : 0;
+				lateness.push_back((period > scheduled_period) ? period - scheduled_period : 0);
+				periods.push_back(period);
+			}
+			last_beat = stamp;
+		}
+		if (!stamps.empty()) {
+			last_seen = stamps.back().time;
+		}
+
+		std::sort(periods.begin(), periods.end());
+		std::sort(lateness.begin(), lateness.end());
+		if (!periods.empty()) {
+			usual_period = percentile(periods, 50);
+		}
+		longest_periods[heartbeat.sequence % longest_periods.size()] = periods.empty() ? 0 : periods.back();
+		uint64_t longest_period = *std::max_element(longest_periods.begin(), longest_periods.end());
+		heartbeat.period_us = microseconds(usual_period);
+		heartbeat.late_p50_us = microseconds(percentile(lateness, 50));
+		heartbeat.late_p90_us = microseconds(percentile(lateness, 90));
+		heartbeat.late_p99_us = microseconds(percentile(lateness, 99));
+		heartbeat.late_max_us = microseconds(lateness.empty() ? 0 : lateness.back());
+		heartbeat.stall_us = microseconds(now - last_seen);
+
+		// A stall is only late once it is longer than the longest recent period, since the loop waits for its next event,
+		// and is not judged until a second of periods has been seen.
+		// Nothing is late before the first iteration, while the models are still being built.
+		bool stalled = heartbeat.sequence >= longest_periods.size() && heartbeat.stall_us > microseconds(longest_period) + threshold_us;
+		bool late = heartbeat.late_p99_us > threshold_us || stalled;
+		heartbeat.alert = (last_beat.time != 0 && late) ? 1 : 0;
+
+		heartbeat.queue_count = static_cast<uint8_t>(Loop_Monitor::queues());
+		for (size_t i = 0; i < heartbeat.queue_count; i++) {
+			heartbeat.queue_depths[i] = static_cast<uint16_t>(std::min<size_t>(Loop_Monitor::queue_depth(i), UINT16_MAX));
+		}
+		return heartbeat;
+	}
+
+	/// @return	Value at a percentile of sorted values, 0 if there are none.
+	static uint64_t percentile(const std::vector<uint64_t>& sorted, unsigned int percent) {
+		if (sorted.empty()) {
+			return 0;
+		}
+		size_t rank = (sorted.size() * percent + 99) / 100;
+		return sorted[std::max<size_t>(rank, 1) - 1];
+	}
+
+	/// @return	Nanoseconds in whole microseconds, saturated to fit the heartbeat.
+	static uint32_t microseconds(uint64_t ns) {
+		return static_cast<uint32_t>(std::min<uint64_t>(ns / 1000, UINT32_MAX));
+	}
+
+	/// Function alert_gcs is used to send a text to the GCS through the packet builder used by the models.
+	void alert_gcs(const message_update_gcs_t& update) {
+		typename cadmium::make_message_bags<typename Packet_Builder_GCS<TIME>::input_ports>::type bags;
+		cadmium::get_messages<typename Packet_Builder_GCS<TIME>::defs::i_data>(bags).emplace_back(update);
+		gcs_builder.external_transition(TIME(), std::move(bags));
+		auto packets = gcs_builder.output();
+		gcs_builder.internal_transition();
+		for (const std::vector<char>& packet : cadmium::get_messages<typename Packet_Builder_GCS<TIME>::defs::o_packet>(packets)) {
+			send(gcs_endpoint, packet);
+		}
+	}
+
+	/// Function send is used to send a packet, errors are reported but do not stop the watchdog.
+	void send(const boost::asio::ip::udp::endpoint& endpoint, const std::vector<char>& packet) {
+		boost::system::error_code err;
+		socket.send_to(boost::asio::buffer(packet.data(), packet.size()), endpoint, 0, err);
+		if (err) {
+			std::cout << "[Loop Watchdog] (ERROR) Error sending packet: " << err.message() << std::endl;
+		}
+	}
+};
+
+#endif // LOOP_WATCHDOG_HPP
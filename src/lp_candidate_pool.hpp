@@ -0,0 +1,336 @@
+/**
+ * 	\file		lp_candidate_pool.hpp
+ *	\brief		Definition of the landing point candidate pool.
+ *	\details	This header file defines a bounded pool of landing point candidates received from the
+				perception system. Candidates are ranked by their distance to the aircraft, their distance
+				to the planned landing point, their heading alignment with the aircraft and how many frames
+				they have been reported in.
+ */
+
+#ifndef LP_CANDIDATE_POOL_HPP
+#define LP_CANDIDATE_POOL_HPP
+
+// Messages structures
+#include "message_structures/message_landing_point_t.hpp"
+#include "message_structures/message_aircraft_state_t.hpp"
+
+// Utility functions
+#include <mavNRC/geo.h>
+#include "Constants.hpp"
+
+// System Libraries
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * 	\class		LP_Candidate_Pool
+ *	\brief		Definition of the landing point candidate pool.
+ *	\details	This class stores up to a fixed number of landing point candidates in an ordered ranking so
+				that the best candidate can be found, inserted and evicted in O(log n). Landing points
+				reported within LP_SEPARATION of an existing candidate are merged into that candidate,
+				which increases its persistence. The candidate to merge into is found through a grid of
+				cells at least LP_SEPARATION wide, so only the candidates in the neighbouring cells are
+				measured. Candidates not reported for LP_CANDIDATE_MAX_AGE frames are dropped, which takes
+				O(log n) for each candidate dropped as the candidates are stored in the order they were
+				last reported. Changing the aircraft state or planned landing point changes the score of
+				every candidate, so it rescores and reranks the whole pool in O(n log n).
+ */
+class LP_Candidate_Pool {
+public:
+	/**
+	 *	\struct	candidate_t
+	 * 	\brief 	Definition of a landing point candidate.
+	 * 	\param 	lp			Most recent report of the landing point.
+	 *	\param	hits		Number of frames the landing point has been reported in.
+	 *	\param	last_frame	Last frame the landing point was reported in.
+	 *	\param	sequence	Order the candidate was last reported in, used to rank newer candidates first on equal scores.
+	 *	\param	score		Current score of the candidate, higher is better.
+	 */
+	struct candidate_t {
+		message_landing_point_t lp;
+		int hits;
+		unsigned long last_frame;
+		unsigned long sequence;
+		double score;
+	};
+
+	/**
+	 * \brief 	Constructor for the pool with parameter for the maximum number of candidates.
+	 * \param	capacity	size_t maximum number of candidates stored.
+	 */
+	explicit LP_Candidate_Pool(size_t capacity = LP_CANDIDATE_POOL_SIZE) {
+		this->capacity = capacity;
+		clear();
+	}
+
+	/// Function for removing all candidates and references from the pool.
+	void clear() {
+		candidates.clear();
+		ranking.clear();
+		grid.clear();
+		frame = 0;
+		sequence = 0;
+		aircraft_state_set = false;
+		plp_set = false;
+	}
+
+	/// @brief 	Function set_aircraft_state is used to set the aircraft state the candidates are scored against.
+	/// @param 	i_aircraft_state	message_aircraft_state_t most recent state of the aircraft.
+	void set_aircraft_state(const message_aircraft_state_t& i_aircraft_state) {
+		aircraft_state = i_aircraft_state;
+		aircraft_state_set = true;
+		rescore();
+	}
+
+	/// @brief 	Function set_plp is used to set the planned landing point the candidates are scored against.
+	/// @param 	i_plp	message_landing_point_t planned landing point.
+	void set_plp(const message_landing_point_t& i_plp) {
+		plp = i_plp;
+		plp_set = true;
+		rescore();
+	}
+
+	/**
+	 *	\brief 		Function add_frame is used to add a frame of landing points from the perception system.
+	 *	\details	Each landing point is merged into the candidate it is within LP_SEPARATION of, or
+	 * 				added as a new candidate. When the pool is full the lowest ranked candidate is evicted.
+	 * 	\param		landing_points	Landing points received in a single frame.
+	 */
+	void add_frame(const std::vector<message_landing_point_t>& landing_points) {
+		frame++;
+		expire();
+		for (const auto& new_lp : landing_points) {
+			auto existing = find_candidate(new_lp);
+			if (existing != candidates.end()) {
+				candidate_t candidate = existing->second;
+				erase(existing);
+				if (candidate.last_frame != frame) {
+					candidate.hits++;
+				}
+				candidate.lp = new_lp;
+				candidate.last_frame = frame;
+				candidate.sequence = sequence++;
+				insert(candidate);
+			} else {
+				candidate_t candidate{new_lp, 1, frame, sequence++, 0.0};
+				if (candidates.size() >= capacity) {
+					// Keep the pool bounded by dropping whichever of the new and lowest ranked candidates is worse.
+					auto worst = std::prev(ranking.end());
+					if (rank_key_t(score(candidate), candidate.sequence) < worst->first) {
+						continue;
+					}
+					erase(candidates.find(worst->second));
+				}
+				insert(candidate);
+			}
+		}
+	}
+
+	/// @brief 	Function best is used to find the highest ranked candidate.
+	/// @param 	o_lp	message_landing_point_t set to the best candidate if one exists.
+	/// @return	true if the pool contains a candidate, false otherwise.
+	bool best(message_landing_point_t& o_lp) const {
+		if (ranking.empty()) {
+			return false;
+		}
+		o_lp = candidates.at(ranking.begin()->second).lp;
+		return true;
+	}
+
+	/**
+	 *	\brief 		Function best_if_separated_from is used to find the highest ranked candidate if it is far enough from a landing point.
+	 *	\details	Lower ranked candidates are never returned, so a landing point that is still ranked first
+	 * 				is kept rather than being swapped for a worse candidate.
+	 * 	\param		current_lp	message_landing_point_t landing point the candidate should be separated from.
+	 * 	\param		o_lp		message_landing_point_t set to the best candidate if it is separated.
+	 * 	\return		true if the best candidate is separated from the landing point, false otherwise.
+	 */
+	bool best_if_separated_from(const message_landing_point_t& current_lp, message_landing_point_t& o_lp) const {
+		message_landing_point_t best_lp;
+		if (!best(best_lp) || horizontal_distance(current_lp.lat, current_lp.lon, current_lp.alt, best_lp) <= LP_SEPARATION) {
+			return false;
+		}
+		o_lp = best_lp;
+		return true;
+	}
+
+	/// @brief 	Function ranked is used to get the candidates in order from best to worst.
+	/// @return	Vector of the candidate landing points from best to worst.
+	[[nodiscard]] std::vector<message_landing_point_t> ranked() const {
+		std::vector<message_landing_point_t> ranked_lps;
+		ranked_lps.reserve(ranking.size());
+		for (const auto& ranked : ranking) {
+			ranked_lps.push_back(candidates.at(ranked.second).lp);
+		}
+		return ranked_lps;
+	}
+
+	/// @return	Number of candidates currently in the pool.
+	[[nodiscard]] size_t size() const {
+		return candidates.size();
+	}
+
+private:
+	/// Key used to order the ranking, the score followed by the sequence to break ties.
+	using rank_key_t = std::pair<double, unsigned long>;
+	/// Key of a cell of the grid, the latitude band followed by the longitude cell within the band.
+	using cell_key_t = std::pair<long, long>;
+
+	/// Radius of the earth in meters used by the distances of the mavNRC geo library.
+	static constexpr double EARTH_RADIUS = 6371000.0;
+	/// Margin added to the size of the cells so that rounding never puts merged landing points more than a cell apart.
+	static constexpr double CELL_MARGIN = 1.01;
+
+	/// Maximum number of candidates stored in the pool.
+	size_t capacity;
+	/// Candidates stored by their sequence number.
+	std::map<unsigned long, candidate_t> candidates;
+	/// Sequence numbers of the candidates ordered from the best to the worst score.
+	std::map<rank_key_t, unsigned long, std::greater<rank_key_t>> ranking;
+	/// Sequence numbers of the candidates by the cell of the grid they are in.
+	std::multimap<cell_key_t, unsigned long> grid;
+	/// Number of frames that have been added to the pool.
+	unsigned long frame;
+	/// Sequence number given to the next candidate that is reported.
+	unsigned long sequence;
+	/// Most recent aircraft state used for scoring.
+	message_aircraft_state_t aircraft_state;
+	/// Whether an aircraft state has been set for scoring.
+	bool aircraft_state_set;
+	/// Planned landing point used for scoring.
+	message_landing_point_t plp;
+	/// Whether a planned landing point has been set for scoring.
+	bool plp_set;
+
+	/// Function for calculating the horizontal distance in meters between a position and a landing point.
+	static float horizontal_distance(double lat, double lon, double alt, const message_landing_point_t& i_lp) {
+		float distance_xy;
+		float distance_z;
+		get_distance_to_point_global_wgs84(
+				lat, lon, alt,
+				i_lp.lat, i_lp.lon, i_lp.alt,
+				&distance_xy, &distance_z);
+		return distance_xy;
+	}
+
+	/// Function for calculating the score of a candidate against the current references.
+	double score(const candidate_t& candidate) const {
+		double result = LP_SCORE_WEIGHT_PERSISTENCE * candidate.hits;
+		if (aircraft_state_set) {
+			result -= LP_SCORE_WEIGHT_AIRCRAFT_DIST *
+					horizontal_distance(aircraft_state.lat, aircraft_state.lon, candidate.lp.alt, candidate.lp);
+
+			// Wrap the heading difference into 0-180
+			double heading_difference = std::fmod(std::abs(candidate.lp.hdg - aircraft_state.hdg_Deg), 360.0);
+			if (heading_difference > 180.0) {
+				heading_difference = 360.0 - heading_difference;
+			}
+			result -= LP_SCORE_WEIGHT_HDG * heading_difference;
+		}
+		if (plp_set) {
+			result -= LP_SCORE_WEIGHT_PLP_DIST * horizontal_distance(plp.lat, plp.lon, candidate.lp.alt, candidate.lp);
+		}
+		return result;
+	}
+
+	/// Function for finding the latitude band of the grid a latitude in degrees is in.
+	static long band(double lat) {
+		// The distance between two points is at least the earth radius times their difference in latitude.
+		return static_cast<long>(std::floor(lat * (M_PI / 180.0) * EARTH_RADIUS / (LP_SEPARATION * CELL_MARGIN)));
+	}
+
+	/// Function for finding the number of longitude cells of a latitude band.
+	static long cells_in_band(long lat_band) {
+		// The cells are sized for the pole side edge of the neighbouring band, where a degree of longitude is
+		// shortest for any landing point that can be merged with one in the band.
+		double band_height = LP_SEPARATION * CELL_MARGIN / EARTH_RADIUS;
+		double edge = (std::max(std::abs(lat_band), std::abs(lat_band + 1)) + 1) * band_height;
+		if (edge >= M_PI / 2.0) {
+			return 1;
+		}
+		// The margin only covers the curvature of the earth for cells narrower than a quarter radian,
+		// wider cells are within a few kilometers of a pole where the whole band is searched.
+		double cell_width = band_height / std::cos(edge);
+		if (cell_width > 0.25) {
+			return 1;
+		}
+		return static_cast<long>(std::floor(2.0 * M_PI / cell_width));
+	}
+
+	/// Function for finding the longitude cell of a longitude in degrees within a latitude band.
+	static long cell(long lat_band, double lon) {
+		long cells = cells_in_band(lat_band);
+		long lon_cell = static_cast<long>(std::floor((lon + 180.0) / 360.0 * cells));
+		return ((lon_cell % cells) + cells) % cells;
+	}
+
+	/// Function for finding the candidate a landing point should be merged into, the earliest reported one within LP_SEPARATION.
+	std::map<unsigned long, candidate_t>::iterator find_candidate(const message_landing_point_t& new_lp) {
+		unsigned long merged = std::numeric_limits<unsigned long>::max();
+		long lp_band = band(new_lp.lat);
+		for (long lat_band = lp_band - 1; lat_band <= lp_band + 1; lat_band++) {
+			long cells = cells_in_band(lat_band);
+			long lp_cell = cell(lat_band, new_lp.lon);
+			// Bands with fewer than three cells wrap around onto the same cells, which are only searched once.
+			for (long offset = -1; offset <= 1 && offset < cells - 1; offset++) {
+				auto range = grid.equal_range(cell_key_t(lat_band, ((lp_cell + offset) % cells + cells) % cells));
+				for (auto it = range.first; it != range.second; it++) {
+					const candidate_t& candidate = candidates.at(it->second);
+					if (it->second < merged && horizontal_distance(candidate.lp.lat, candidate.lp.lon, candidate.lp.alt, new_lp) <= LP_SEPARATION) {
+						merged = it->second;
+					}
+				}
+			}
+		}
+		return candidates.find(merged);
+	}
+
+	/// Function for scoring and inserting a candidate into the pool.
+	void insert(candidate_t candidate) {
+		candidate.score = score(candidate);
+		ranking.emplace(rank_key_t(candidate.score, candidate.sequence), candidate.sequence);
+		long lat_band = band(candidate.lp.lat);
+		grid.emplace(cell_key_t(lat_band, cell(lat_band, candidate.lp.lon)), candidate.sequence);
+		candidates.emplace(candidate.sequence, candidate);
+	}
+
+	/// Function for removing a candidate from the pool, returning the candidate after it.
+	std::map<unsigned long, candidate_t>::iterator erase(std::map<unsigned long, candidate_t>::iterator it) {
+		ranking.erase(rank_key_t(it->second.score, it->second.sequence));
+		long lat_band = band(it->second.lp.lat);
+		auto range = grid.equal_range(cell_key_t(lat_band, cell(lat_band, it->second.lp.lon)));
+		for (auto cell_it = range.first; cell_it != range.second; cell_it++) {
+			if (cell_it->second == it->first) {
+				grid.erase(cell_it);
+				break;
+			}
+		}
+		return candidates.erase(it);
+	}
+
+	/// Function for removing the candidates that have not been reported recently.
+	void expire() {
+		// A candidate is given a new sequence number each time it is reported, so the candidates are stored in
+		// the order they were last reported and the expired candidates are all at the start.
+		auto it = candidates.begin();
+		while (it != candidates.end() && frame - it->second.last_frame > LP_CANDIDATE_MAX_AGE) {
+			it = erase(it);
+		}
+	}
+
+	/// Function for recalculating the ranking after a reference has changed.
+	void rescore() {
+		ranking.clear();
+		for (auto& entry : candidates) {
+			entry.second.score = score(entry.second);
+			ranking.emplace(rank_key_t(entry.second.score, entry.second.sequence), entry.first);
+		}
+	}
+};
+
+#endif // LP_CANDIDATE_POOL_HPP
@@ -0,0 +1,105 @@
+/**
+ * 	\file		lp_load_pattern.hpp
+ *	\brief		Definition of the landing point load pattern.
+ *	\details	This header file defines the spatial distributions used to generate landing points
+				around a centre point when stress testing the landing point ingress path. The landing
+				points stand in for those found by the perception system.
+ */
+
+#ifndef LP_LOAD_PATTERN_HPP
+#define LP_LOAD_PATTERN_HPP
+
+// Messages structures
+#include "message_structures/message_landing_point_t.hpp"
+
+// Utility functions
+#include <mavNRC/geo.h>
+
+// System Libraries
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+/// Enum for the spatial distributions landing points can be generated with.
+enum class LP_Distribution_E {
+	UNIFORM,
+	GAUSSIAN,
+	RING
+};
+
+/**
+ * 	\class		LP_Load_Pattern
+ *	\brief		Definition of the landing point load pattern.
+ *	\details	This class generates landing points around a centre point with a seeded generator so
+				that a load can be repeated. Uniform landing points are spread evenly over a disc of the
+				given radius, Gaussian landing points are offset north and east by independent normal
+				distributions with the radius as their standard deviation, and ring landing points lie on
+				the circle of the given radius. Each landing point is given the next id so that it can be
+				matched up when it comes out of the ingress path.
+ */
+class LP_Load_Pattern {
+public:
+	/**
+	 * \brief 	Constructor for the pattern with the centre point and the shape of the distribution.
+	 * \param	i_centre		message_landing_point_t landing point the generated landing points are spread around.
+	 * \param	i_distribution	LP_Distribution_E spatial distribution of the generated landing points.
+	 * \param	i_radius		float radius in meters of the distribution.
+	 * \param	seed			uint32_t seed of the generator.
+	 */
+	explicit LP_Load_Pattern(const message_landing_point_t& i_centre = message_landing_point_t(0, 0, 45.0, -75.0, 300.0, 0.0),
+							 LP_Distribution_E i_distribution = LP_Distribution_E::UNIFORM,
+							 float i_radius = 50.0f,
+							 uint32_t seed = 1) : generator(seed) {
+		centre = i_centre;
+		distribution = i_distribution;
+		radius = i_radius;
+		next_id = 1;
+	}
+
+	/// @return	Next landing point of the pattern.
+	message_landing_point_t next() {
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		double bearing = 2.0 * M_PI * unit(generator);
+		double distance;
+		switch (distribution) {
+			case LP_Distribution_E::GAUSSIAN: {
+				// Independent north and east offsets spread the landing points as a normal distribution over the plane,
+				// a normally distributed distance would crowd them around the centre.
+				std::normal_distribution<double> offset(0.0, radius);
+				double north = offset(generator);
+				double east = offset(generator);
+				bearing = std::atan2(east, north);
+				distance = std::hypot(north, east);
+				break;
+			}
+			case LP_Distribution_E::RING:
+				distance = radius;
+				break;
+			default:
+				// The square root spreads the landing points evenly over the area of the disc.
+				distance = radius * std::sqrt(unit(generator));
+				break;
+		}
+
+		message_landing_point_t lp = centre;
+		lp.id = next_id++;
+		if (distance > 0.0) {
+			waypoint_from_heading_and_distance(centre.lat, centre.lon, bearing, distance, &lp.lat, &lp.lon);
+		}
+		return lp;
+	}
+
+private:
+	/// Landing point the generated landing points are spread around.
+	message_landing_point_t centre;
+	/// Spatial distribution of the generated landing points.
+	LP_Distribution_E distribution;
+	/// Radius in meters of the distribution.
+	float radius;
+	/// Id of the next landing point.
+	int next_id;
+	/// Seeded generator used to spread the landing points.
+	std::mt19937 generator;
+};
+
+#endif // LP_LOAD_PATTERN_HPP
@@ -0,0 +1,34 @@
+#ifndef MESSAGE_CACHE_ENTRY_T_HPP
+#define MESSAGE_CACHE_ENTRY_T_HPP
+
+#include <iostream>
+
+template<typename MSG>
+struct message_cache_entry_t {
+	MSG value;
+	int version;
+	double timestamp;	// s, simulation time the value was cached at
+	bool stale;
+
+	message_cache_entry_t() : value(), version(0), timestamp(0.0), stale(false) {}
+	message_cache_entry_t(const MSG& i_value, int i_version, double i_timestamp, bool i_stale) :
+			value(i_value),
+			version(i_version),
+			timestamp(i_timestamp),
+			stale(i_stale) {}
+};
+
+/***************************************************/
+/************* Output stream ***********************/
+/***************************************************/
+
+template<typename MSG>
+std::ostream& operator<<(std::ostream& os, const message_cache_entry_t<MSG>& msg) {
+	os << msg.value << " "
+	   << msg.version << " "
+	   << msg.timestamp << " "
+	   << msg.stale;
+	return os;
+}
+
+#endif // MESSAGE_CACHE_ENTRY_T_HPP
@@ -0,0 +1,59 @@
+#ifndef MESSAGE_HEARTBEAT_T_HPP
+#define MESSAGE_HEARTBEAT_T_HPP
+
+#include <cstdint>
+#include <iostream>
+#include "../Constants.hpp"
+
+// #pragma pack(push, 4) is used to set the byte alignment for the structure
+// This is used to make sure the byte alignment is the same on the receiver
+#pragma pack(push, 4)
+struct message_heartbeat_t {
+	uint32_t sequence; // Number of the heartbeat, increases by one for every heartbeat sent
+	uint32_t iterations; // Runner iterations since the last heartbeat
+	uint32_t period_us; // Median time between runner iterations in microseconds
+	uint32_t late_p50_us; // Percentiles of how late the runner iterations ran after the time they were scheduled for in microseconds
+	uint32_t late_p90_us;
+	uint32_t late_p99_us;
+	uint32_t late_max_us;
+	uint32_t stall_us; // Time since the last runner iteration in microseconds
+	uint8_t alert; // 1 = the lateness or stall is over the threshold, 0 = the loop is on time
+	uint8_t queue_count; // Number of queue depths used
+	uint16_t queue_depths[LOOP_WATCHDOG_MAX_QUEUES]{0}; // Messages waiting in each watched queue, saturated at 65535
+
+	message_heartbeat_t() :
+			sequence(0),
+			iterations(0),
+			period_us(0),
+			late_p50_us(0),
+			late_p90_us(0),
+			late_p99_us(0),
+			late_max_us(0),
+			stall_us(0),
+			alert(0),
+			queue_count(0) {}
+};
+#pragma pack(pop)
+
+/***************************************************/
+/************* Output stream ************************/
+/***************************************************/
+
+std::ostream &operator<<(std::ostream &os, const message_heartbeat_t &msg) {
+	os << msg.sequence << " "
+	   << msg.iterations << " "
+	   << msg.period_us << " "
+	   << msg.late_p50_us << " "
+	   << msg.late_p90_us << " "
+	   << msg.late_p99_us << " "
+	   << msg.late_max_us << " "
+	   << msg.stall_us << " "
+	   << (int)msg.alert << " "
+	   << (int)msg.queue_count;
+	for (int i = 0; i < msg.queue_count && i < LOOP_WATCHDOG_MAX_QUEUES; i++) {
+		os << " " << msg.queue_depths[i];
+	}
+	return os;
+}
+
+#endif // MESSAGE_HEARTBEAT_T_HPP
@@ -0,0 +1,20 @@
+#ifndef MESSAGE_STATE_FEED_T_HPP
+#define MESSAGE_STATE_FEED_T_HPP
+
+#include <cstdint>
+#include "message_aircraft_state_t.hpp"
+
+// #pragma pack(push, 4) is used to set the byte alignment for the structure
+// This is used to make sure the byte alignment is the same on the sender
+#pragma pack(push, 4)
+struct message_state_feed_t {
+	message_aircraft_state_t aircraft_state; // State of the aircraft of one vehicle of a fleet
+	uint32_t safety_status; // Safety status bits of the aircraft, FCC_ENGAGED_BITS are both set while the Supervisor has control
+
+	message_state_feed_t() :
+			aircraft_state(),
+			safety_status(0) {}
+};
+#pragma pack(pop)
+
+#endif // MESSAGE_STATE_FEED_T_HPP
@@ -1,21 +1,79 @@
 #ifndef MESSAGE_UPDATE_GCS_T_HPP
 #define MESSAGE_UPDATE_GCS_T_HPP
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <iostream>
+#include "../Constants.hpp"
 
 enum Mav_Severities_E {
 	MAV_SEVERITY_ALERT = 1,
 	MAV_SEVERITY_INFO = 6
 };
 
+// Texts sent to the GCS that never change are interned in GCS_TEXTS and referenced by id,
+// so that sending them does not build a string and they can be longer than one STATUSTEXT chunk.
+enum class GCS_Text_E : uint8_t {
+	NONE,
+	STARTING_LZ_SCAN,
+	LP_NOT_FOUND,
+	LP_TIMER_STARTED,
+	LP_ACCEPT_TIMER_EXPIRED,
+	REPO_TIMER_EXPIRED,
+	LANDING,
+	JUST_LANDED,
+	AIRCRAFT_STATE_NOT_AVAILABLE,
+	PERCEPTION_READY,
+	PERCEPTION_NOT_OPERATIONAL,
+	STARTING_MISSION_IN_AIR,
+	CAME_TO_HOVER,
+	REPOSITIONING_TO_LP,
+	LOOP_ON_TIME,
+	COUNT
+};
+
+constexpr std::string_view GCS_TEXTS[] = {
+	"",
+	"Starting an orbit to scan LZ",
+	"Landing point not found. Hovering over PLP",
+	"LP timer started",
+	"LP accept timer expired",
+	"Repo timer expired, hovering over the last LP",
+	"Landing",
+	"Just landed!",
+	"The aircraft state is not available, the mission was not started!",
+	"The perceptions system is ready for operation!",
+	"The perception system is not operational!",
+	"Starting Mission in air!",
+	"Came to hover!",
+	"Repositioning to LP!",
+	"The Supervisor loop is back on time"
+};
+
+static_assert(sizeof(GCS_TEXTS) / sizeof(GCS_TEXTS[0]) == static_cast<size_t>(GCS_Text_E::COUNT), "Every GCS text id needs an interned text.");
+
 struct message_update_gcs_t {
-	std::string text;
+	char text[MAVLINK_MSG_STATUSTEXT_TEXT_LEN]; // Inline text, only null terminated when shorter than the buffer like the STATUSTEXT text
 	int severity;
+	GCS_Text_E text_id; // Interned text sent instead of the inline text when not NONE
 
-	message_update_gcs_t(): severity(0) {}
-	message_update_gcs_t(std::string text, uint8_t severity): text(std::move(text)), severity(severity) {}
+	message_update_gcs_t(): text{}, severity(0), text_id(GCS_Text_E::NONE) {}
+	message_update_gcs_t(GCS_Text_E text_id, uint8_t severity): text{}, severity(severity), text_id(text_id) {}
+	message_update_gcs_t(std::string_view i_text, uint8_t severity): text{}, severity(severity), text_id(GCS_Text_E::NONE) {
+		// Text that does not fit in one chunk is truncated, longer texts should be interned.
+		std::memcpy(text, i_text.data(), std::min(i_text.size(), sizeof(text)));
+	}
+
+	// Text of the message, either interned or inline.
+	[[nodiscard]] std::string_view str() const {
+		if (text_id != GCS_Text_E::NONE) {
+			return GCS_TEXTS[static_cast<size_t>(text_id)];
+		}
+		return std::string_view(text, strnlen(text, sizeof(text)));
+	}
 };
 
 /***************************************************/
@@ -23,7 +81,7 @@ struct message_update_gcs_t {
 /***************************************************/
 
 std::ostream& operator<<(std::ostream& os, const message_update_gcs_t& msg) {
-	os << msg.text << " "
+	os << msg.str() << " "
 	   << msg.severity << " ";
 	return os;
 }
@@ -33,8 +91,10 @@ std::ostream& operator<<(std::ostream& os, const message_update_gcs_t& msg) {
 /***************************************************/
 
 std::istream& operator>> (std::istream& is, message_update_gcs_t& msg) {
-	is >> msg.text
+	std::string text;
+	is >> text
 	   >> msg.severity;
+	msg = message_update_gcs_t(text, msg.severity);
 	return is;
 }
 
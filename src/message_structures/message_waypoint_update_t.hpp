@@ -0,0 +1,63 @@
+#ifndef MESSAGE_WAYPOINT_UPDATE_T_HPP
+#define MESSAGE_WAYPOINT_UPDATE_T_HPP
+
+#include <cstdint>
+#include <iostream>
+
+#include "message_fcc_command_t.hpp"
+
+enum class Waypoint_Update_E : uint8_t {
+	SET,		// Add the waypoint at the end of the route or replace the waypoint at the index
+	SKIP,		// Remove the waypoint at the index from the route
+	REACHED		// Mark every waypoint up to and including the index as passed
+};
+
+// #pragma pack(push, 4) is used to set the byte alignment for the structure
+// This is used to make sure the byte alignment is the same on MavNRC
+#pragma pack(push, 4)
+struct message_waypoint_update_t {
+	int32_t index;
+	uint8_t action;
+	message_fcc_command_t waypoint;
+
+	message_waypoint_update_t() :
+			index(0),
+			action(static_cast<uint8_t>(Waypoint_Update_E::SET)),
+			waypoint() {}
+
+	message_waypoint_update_t(
+			int32_t i_index,
+			Waypoint_Update_E i_action,
+			const message_fcc_command_t& i_waypoint
+	) :
+			index(i_index),
+			action(static_cast<uint8_t>(i_action)),
+			waypoint(i_waypoint) {}
+};
+#pragma pack(pop)
+
+/***************************************************/
+/************* Output stream ************************/
+/***************************************************/
+
+std::ostream& operator<<(std::ostream& os, const message_waypoint_update_t& msg) {
+	os << msg.index << " "
+	   << static_cast<int>(msg.action) << " "
+	   << msg.waypoint;
+	return os;
+}
+
+/***************************************************/
+/************* Input stream ************************/
+/***************************************************/
+
+std::istream& operator>>(std::istream& is, message_waypoint_update_t& msg) {
+	int action;
+	is >> msg.index
+	   >> action
+	   >> msg.waypoint;
+	msg.action = static_cast<uint8_t>(action);
+	return is;
+}
+
+#endif // MESSAGE_WAYPOINT_UPDATE_T_HPP
@@ -0,0 +1,61 @@
+#ifndef SHARED_MESSAGE_T_HPP
+#define SHARED_MESSAGE_T_HPP
+
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ *	\struct		shared_message_t
+ *	\brief		Handle to an immutable message shared between the models it is sent through.
+ *	\details	Messages are copied into every message bag they pass through on their way between
+ *				models. For large messages the handle is sent instead, so each hop copies a pointer
+ *				and the message itself is only allocated once, when it is created by the sending model.
+ */
+template<typename T>
+struct shared_message_t {
+	/// Default constructor for a handle to a default constructed message.
+	shared_message_t() : message(std::make_shared<const T>()) {}
+
+	/// Constructor for a handle to a message built from the arguments of one of its constructors.
+	template<typename... Args, typename = std::enable_if_t<!(sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, shared_message_t> && ...))>>
+	shared_message_t(Args&&... args) : message(std::make_shared<const T>(std::forward<Args>(args)...)) {}
+
+	/// @return	Message the handle refers to.
+	const T& operator*() const {
+		return *message;
+	}
+
+	/// @return	Pointer to the message the handle refers to.
+	const T* operator->() const {
+		return message.get();
+	}
+
+private:
+	std::shared_ptr<const T> message;
+};
+
+/***************************************************/
+/************* Output stream ***********************/
+/***************************************************/
+
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const shared_message_t<T>& msg) {
+	os << *msg;
+	return os;
+}
+
+/***************************************************/
+/************* Input stream ************************/
+/***************************************************/
+
+template<typename T>
+std::istream& operator>> (std::istream& is, shared_message_t<T>& msg) {
+	T message;
+	is >> message;
+	msg = shared_message_t<T>(std::move(message));
+	return is;
+}
+
+#endif // SHARED_MESSAGE_T_HPP
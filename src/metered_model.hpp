@@ -0,0 +1,320 @@
+/**
+ * 	\file		metered_model.hpp
+ *	\brief		Definition of the metered wrapper for the atomic models.
+ *	\details	This header file defines a wrapper that counts the messages through every port of an
+				atomic model and the transitions it makes, without changing its behaviour.
+ */
+
+#ifndef METERED_MODEL_HPP
+#define METERED_MODEL_HPP
+
+// Messages structures
+#include "message_structures/shared_message_t.hpp"
+
+// Utility functions
+#include "allocation_counter.hpp"
+#include "metrics.hpp"
+#include "step_arena.hpp"
+#include "time_conversion.hpp"
+#include "time_warp.hpp"
+#include "tracepoints.hpp"
+
+// Cadmium Simulator Headers
+#include <cadmium/modeling/message_bag.hpp>
+
+// Boost Headers
+#include <boost/core/demangle.hpp>
+
+// System Libraries
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/// @return	Size in bytes of a message, the size of the message structure.
+template<typename T>
+uint64_t message_bytes(const T&) {
+	return sizeof(T);
+}
+
+/// @return	Size in bytes of a packet.
+inline uint64_t message_bytes(const std::vector<char>& packet) {
+	return packet.size();
+}
+
+/// @return	Size in bytes of a shared message, the size of the message it refers to.
+template<typename T>
+uint64_t message_bytes(const shared_message_t<T>&) {
+	return sizeof(T);
+}
+
+/**
+ * 	\struct		Metered
+ *	\brief		Definition of the metered wrapper for the atomic models.
+ *	\details	Metered<MODEL>::model derives from the atomic model and is used in its place when the
+				model is created, for example make_dynamic_atomic_model<Metered<LP_Manager>::model, TIME>.
+				Every bag received or sent is counted in the Metrics of the process, labelled with the
+				type of the model and the name of the port, along with the largest bag and the number of
+				bytes of the messages. The ports and state of the model are unchanged, so the couplings
+				and logging of the model do not change. The transitions, outputs and time advances of the
+				model also fire the static tracepoints of the Supervisor, labelled with the same name.
+				Each of them is a step of the model, which opens the Step_Arena of the thread and, when
+				SUPERVISOR_COUNT_ALLOCATIONS is defined, counts the heap allocations made during it.
+				The time advances and elapsed times are converted by the Time_Warp of the process, so the
+				model sees simulated time while the runner follows the wall clock. Only the models of the
+				process are warped, such as those of the Emulated_Aircraft; inputs read from outside it,
+				such as the aircraft state in shared memory or from a state feed, keep following the wall clock.
+ */
+template<template<typename> class MODEL>
+struct Metered {
+	template<typename TIME>
+	class model : public MODEL<TIME> {
+		using base = MODEL<TIME>;
+		using input_bags = typename cadmium::make_message_bags<typename base::input_ports>::type;
+		using output_bags = typename cadmium::make_message_bags<typename base::output_ports>::type;
+
+	public:
+		using base::base;
+
+		/// Internal transitions of the model
+		void internal_transition() {
+			step_t step(Call::INTERNAL);
+			Metrics::instance().increment(transitions().internal);
+			SUPERVISOR_TRACE(transition_start, trace_name(), 0, static_cast<int>(this->state.current_state));
+			base::internal_transition();
+			SUPERVISOR_TRACE(transition_done, trace_name(), 0, static_cast<int>(this->state.current_state));
+		}
+
+		/// External transitions of the model
+		void external_transition(TIME e, input_bags mbs) {
+			step_t step(Call::EXTERNAL);
+			Metrics::instance().increment(transitions().external);
+			count_bags<typename base::input_ports>(mbs, std::make_index_sequence<std::tuple_size<typename base::input_ports>::value>{});
+			SUPERVISOR_TRACE(transition_start, trace_name(), 1, static_cast<int>(this->state.current_state));
+			base::external_transition(Time_Warp::to_simulated(e), std::move(mbs));
+			SUPERVISOR_TRACE(transition_done, trace_name(), 1, static_cast<int>(this->state.current_state));
+		}
+
+		/// Function used to decide precedence between internal and external transitions when both are scheduled simultaneously.
+		void confluence_transition(TIME e, input_bags mbs) {
+			step_t step(Call::CONFLUENCE);
+			Metrics::instance().increment(transitions().confluence);
+			count_bags<typename base::input_ports>(mbs, std::make_index_sequence<std::tuple_size<typename base::input_ports>::value>{});
+			SUPERVISOR_TRACE(transition_start, trace_name(), 2, static_cast<int>(this->state.current_state));
+			base::confluence_transition(Time_Warp::to_simulated(e), std::move(mbs));
+			SUPERVISOR_TRACE(transition_done, trace_name(), 2, static_cast<int>(this->state.current_state));
+		}
+
+		/// Function for generating output from the model before internal transitions.
+		output_bags output() const {
+			step_t step(Call::OUTPUT);
+			output_bags bags = base::output();
+			count_bags<typename base::output_ports>(bags, std::make_index_sequence<std::tuple_size<typename base::output_ports>::value>{});
+			SUPERVISOR_TRACE(output, trace_name(), static_cast<int>(this->state.current_state),
+				bag_messages<typename base::output_ports>(bags, std::make_index_sequence<std::tuple_size<typename base::output_ports>::value>{}));
+			return bags;
+		}
+
+		/// Function to declare the time advance value for each state of the model.
+		TIME time_advance() const {
+			step_t step(Call::TIME_ADVANCE);
+			TIME next_internal = base::time_advance();
+			SUPERVISOR_TRACE(time_advance, trace_name(), static_cast<int>(this->state.current_state), trace_microseconds(next_internal));
+			return Time_Warp::to_wall(next_internal);
+		}
+
+	private:
+		/// Enum for the calls made to the model by the simulator, in the order of their allocation counters.
+		enum Call {
+			INTERNAL,
+			EXTERNAL,
+			CONFLUENCE,
+			OUTPUT,
+			TIME_ADVANCE,
+			CALLS
+		};
+
+		/**
+		 *	\class		step_t
+		 *	\brief 	Definition of a step of the model.
+		 *	\details	The step arena is open while the step exists, and the heap allocations made between
+		 *				the construction and destruction of the step are added to the counters of the call.
+		 */
+		class step_t {
+		public:
+			explicit step_t(Call call) : call(call), start(Allocation_Counter::allocations()) {}
+
+			~step_t() {
+				if constexpr (Allocation_Counter::enabled) {
+					uint64_t made = Allocation_Counter::allocations() - start;
+					const allocation_counters_t& counters = allocation_counters();
+					Metrics::instance().increment(counters.calls[call], made);
+					Metrics::instance().maximum(counters.max_step, made);
+				}
+			}
+
+			step_t(const step_t&) = delete;
+			step_t& operator=(const step_t&) = delete;
+
+		private:
+			/// Arena of the step.
+			Step_Arena::scope arena;
+			/// Call made to the model.
+			Call call;
+			/// Allocations made by the thread before the step.
+			uint64_t start;
+		};
+
+		/**
+		 *	\struct	allocation_counters_t
+		 * 	\brief 	Definition of the indices of the allocation counters of the model.
+		 * 	\param 	calls		Index of the allocation counter of each call.
+		 *	\param	max_step	Index of the most allocations made by a single step.
+		 */
+		struct allocation_counters_t {
+			size_t calls[CALLS];
+			size_t max_step;
+		};
+
+		/**
+		 *	\struct	transition_counters_t
+		 * 	\brief 	Definition of the indices of the transition counters of the model.
+		 * 	\param 	internal	Index of the internal transition counter.
+		 *	\param	external	Index of the external transition counter.
+		 *	\param	confluence	Index of the confluence transition counter.
+		 */
+		struct transition_counters_t {
+			size_t internal;
+			size_t external;
+			size_t confluence;
+		};
+
+		/**
+		 *	\struct	port_counters_t
+		 * 	\brief 	Definition of the indices of the counters of a port.
+		 * 	\param 	messages		Index of the message counter.
+		 *	\param	bags			Index of the counter of bags that held messages.
+		 *	\param	max_bag_size	Index of the largest bag size.
+		 *	\param	bytes			Index of the byte counter.
+		 */
+		struct port_counters_t {
+			size_t messages;
+			size_t bags;
+			size_t max_bag_size;
+			size_t bytes;
+		};
+
+		/// @return	Name of the model type without its template arguments.
+		static std::string model_name() {
+			std::string name = boost::core::demangle(typeid(base).name());
+			return name.substr(0, name.find('<'));
+		}
+
+		/// @return	Name of a port without the model it belongs to.
+		template<typename PORT>
+		static std::string port_name() {
+			std::string name = boost::core::demangle(typeid(PORT).name());
+			return name.substr(name.rfind(':') + 1);
+		}
+
+		/// @return	Name of the model type for the tracepoints, kept for the life of the process.
+		static const char * trace_name() {
+			static const std::string name = model_name();
+			return name.c_str();
+		}
+
+		/// @return	Time advance in whole microseconds for the tracepoints, -1 if the model is passive.
+		static int64_t trace_microseconds(const TIME& time) {
+			if (time == std::numeric_limits<TIME>::infinity()) {
+				return -1;
+			}
+			double seconds = time_to_seconds(time);
+			return std::isfinite(seconds) ? static_cast<int64_t>(std::llround(seconds * 1E6)) : -1;
+		}
+
+		/// @return	Transition counters of the model, registered by the first model of the type.
+		static const transition_counters_t& transitions() {
+			static const transition_counters_t counters = [] {
+				Metrics& metrics = Metrics::instance();
+				const std::string help = "Transitions made by the models.";
+				const std::string labels = "model=\"" + model_name() + "\",transition=";
+				return transition_counters_t{
+					metrics.add("supervisor_model_transitions_total", help, Metrics::Kind::COUNTER, labels + "\"internal\""),
+					metrics.add("supervisor_model_transitions_total", help, Metrics::Kind::COUNTER, labels + "\"external\""),
+					metrics.add("supervisor_model_transitions_total", help, Metrics::Kind::COUNTER, labels + "\"confluence\"")
+				};
+			}();
+			return counters;
+		}
+
+		/// @return	Allocation counters of the model, registered by the first model of the type to count them.
+		static const allocation_counters_t& allocation_counters() {
+			static const allocation_counters_t counters = [] {
+				Metrics& metrics = Metrics::instance();
+				const std::string help = "Heap allocations made by the steps of the models.";
+				const std::string labels = "model=\"" + model_name() + "\"";
+				const char * calls[CALLS] = {"internal", "external", "confluence", "output", "time_advance"};
+				allocation_counters_t added{};
+				for (size_t call = 0; call < CALLS; call++) {
+					added.calls[call] = metrics.add("supervisor_model_allocations_total", help, Metrics::Kind::COUNTER, labels + ",call=\"" + calls[call] + "\"");
+				}
+				added.max_step = metrics.add("supervisor_model_step_max_allocations", "Most heap allocations made by a single step of the models.", Metrics::Kind::MAXIMUM, labels);
+				return added;
+			}();
+			return counters;
+		}
+
+		/// @return	Counters of a port, registered by the first model of the type.
+		template<typename PORT>
+		static const port_counters_t& port_counters() {
+			static const port_counters_t counters = [] {
+				Metrics& metrics = Metrics::instance();
+				const std::string labels = "model=\"" + model_name() + "\",port=\"" + port_name<PORT>() + "\"";
+				return port_counters_t{
+					metrics.add("supervisor_port_messages_total", "Messages through the ports of the models.", Metrics::Kind::COUNTER, labels),
+					metrics.add("supervisor_port_bags_total", "Bags holding messages through the ports of the models.", Metrics::Kind::COUNTER, labels),
+					metrics.add("supervisor_port_max_bag_size", "Most messages in a single bag through the ports of the models.", Metrics::Kind::MAXIMUM, labels),
+					metrics.add("supervisor_port_bytes_total", "Bytes of the messages through the ports of the models.", Metrics::Kind::COUNTER, labels)
+				};
+			}();
+			return counters;
+		}
+
+		/// Function for counting the messages in a bag of each port.
+		template<typename PORTS, typename BAGS, size_t... I>
+		static void count_bags(const BAGS& bags, std::index_sequence<I...>) {
+			(count_bag<std::tuple_element_t<I, PORTS>>(bags), ...);
+		}
+
+		/// @return	Number of messages in the bags of every port.
+		template<typename PORTS, typename BAGS, size_t... I>
+		static uint64_t bag_messages(const BAGS& bags, std::index_sequence<I...>) {
+			return (uint64_t{0} + ... + cadmium::get_messages<std::tuple_element_t<I, PORTS>>(bags).size());
+		}
+
+		/// Function for counting the messages in the bag of a port, empty bags are not counted.
+		template<typename PORT, typename BAGS>
+		static void count_bag(const BAGS& bags) {
+			const auto& messages = cadmium::get_messages<PORT>(bags);
+			if (messages.empty()) {
+				return;
+			}
+			uint64_t bytes = 0;
+			for (const auto& message : messages) {
+				bytes += message_bytes(message);
+			}
+			const port_counters_t& counters = port_counters<PORT>();
+			Metrics& metrics = Metrics::instance();
+			metrics.increment(counters.messages, messages.size());
+			metrics.increment(counters.bags);
+			metrics.maximum(counters.max_bag_size, messages.size());
+			metrics.increment(counters.bytes, bytes);
+		}
+	};
+};
+
+#endif // METERED_MODEL_HPP
@@ -0,0 +1,177 @@
+/**
+ * 	\file		metrics.hpp
+ *	\brief		Definition of the metrics of the Supervisor.
+ *	\details	This header file defines the counters used to watch the load on the Supervisor while it
+				runs, and the function that writes them out in the Prometheus text format.
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+// Constants
+#include "Constants.hpp"
+
+// System Libraries
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * 	\class		Metrics
+ *	\brief		Definition of the metrics of the Supervisor.
+ *	\details	This class stores counters in a shard for each thread that updates them. Only the thread
+				that owns a shard writes to it, so updating a counter is a relaxed load and store with no
+				contention between the threads running the models. The shards are only summed when the
+				metrics are read. Counters are registered once, by the first model of a type to use them,
+				and are identified by their index after that.
+ */
+class Metrics {
+public:
+	/// Enum for how the shards of a counter are combined when the metrics are read.
+	enum class Kind {
+		COUNTER,	// Summed over the shards, only ever increases.
+		MAXIMUM		// Largest value of the shards.
+	};
+
+	/// @return	Metrics shared by the whole process.
+	static Metrics& instance() {
+		static Metrics metrics;
+		return metrics;
+	}
+
+	/**
+	 *	\brief 		Function add is used to register a counter.
+	 *	\details	Counters with the same family are written out together, the help and kind are taken
+	 * 				from the first counter of the family.
+	 * 	\param		family	Name of the metric the counter belongs to.
+	 * 	\param		help	Description of the metric.
+	 * 	\param		kind	How the shards of the counter are combined.
+	 * 	\param		labels	Labels of the counter in the Prometheus format, without the braces.
+	 * 	\return		Index of the counter.
+	 * 	\throws		std::length_error if METRICS_MAX_COUNTERS counters are already registered.
+	 */
+	size_t add(const std::string& family, const std::string& help, Kind kind, const std::string& labels) {
+		std::lock_guard<std::mutex> lock(mutex);
+		// The shards have a fixed number of values, so a counter past them would be written out of bounds.
+		if (counters.size() >= METRICS_MAX_COUNTERS) {
+			throw(std::length_error("Counter " + family + "{" + labels + "} is past the " + std::to_string(METRICS_MAX_COUNTERS) + " metrics counters available"));
+		}
+		counters.push_back(counter_t{family, help, kind, labels});
+		return counters.size() - 1;
+	}
+
+	/// @brief 	Function increment is used to add to a counter.
+	/// @param 	index	Index of the counter.
+	/// @param 	amount	uint64_t amount added to the counter.
+	void increment(size_t index, uint64_t amount = 1) {
+		std::atomic<uint64_t>& value = local_shard().values[index];
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	/// @brief 	Function maximum is used to raise a counter to a value if it is larger.
+	/// @param 	index	Index of the counter.
+	/// @param 	value	uint64_t value the counter is raised to.
+	void maximum(size_t index, uint64_t value) {
+		std::atomic<uint64_t>& current = local_shard().values[index];
+		if (value > current.load(std::memory_order_relaxed)) {
+			current.store(value, std::memory_order_relaxed);
+		}
+	}
+
+	/// @return	Value of a counter combined over the shards.
+	[[nodiscard]] uint64_t value(size_t index) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return combine(index);
+	}
+
+	/// @return	Every counter in the Prometheus text format.
+	[[nodiscard]] std::string prometheus() const {
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// The counters of a family are grouped under one HELP and TYPE line, in the order the families were added.
+		std::vector<std::string> families;
+		for (const counter_t& counter : counters) {
+			if (std::find(families.begin(), families.end(), counter.family) == families.end()) {
+				families.push_back(counter.family);
+			}
+		}
+
+		std::ostringstream text;
+		for (const std::string& family : families) {
+			bool first = true;
+			for (size_t index = 0; index < counters.size(); index++) {
+				const counter_t& counter = counters[index];
+				if (counter.family != family) {
+					continue;
+				}
+				if (first) {
+					text << "# HELP " << family << " " << counter.help << "\n";
+					text << "# TYPE " << family << " " << ((counter.kind == Kind::COUNTER) ? "counter" : "gauge") << "\n";
+					first = false;
+				}
+				text << family << "{" << counter.labels << "} " << combine(index) << "\n";
+			}
+		}
+		return text.str();
+	}
+
+private:
+	/**
+	 *	\struct	counter_t
+	 * 	\brief 	Definition of a registered counter.
+	 * 	\param 	family	Name of the metric the counter belongs to.
+	 *	\param	help	Description of the metric.
+	 *	\param	kind	How the shards of the counter are combined.
+	 *	\param	labels	Labels of the counter in the Prometheus format.
+	 */
+	struct counter_t {
+		std::string family;
+		std::string help;
+		Kind kind;
+		std::string labels;
+	};
+
+	/// Counters of one thread, aligned so that threads do not share a cache line.
+	struct alignas(64) shard_t {
+		std::array<std::atomic<uint64_t>, METRICS_MAX_COUNTERS> values{};
+	};
+
+	/// Mutex guarding the registered counters and the list of shards.
+	mutable std::mutex mutex;
+	/// Registered counters, by index.
+	std::vector<counter_t> counters;
+	/// Shard of each thread that has updated a counter, kept after the thread exits so its counts are not lost.
+	std::vector<std::unique_ptr<shard_t>> shards;
+
+	Metrics() = default;
+
+	/// @return	Shard of the calling thread, added the first time the thread updates a counter.
+	shard_t& local_shard() {
+		thread_local shard_t* shard = nullptr;
+		if (shard == nullptr) {
+			std::lock_guard<std::mutex> lock(mutex);
+			shards.push_back(std::make_unique<shard_t>());
+			shard = shards.back().get();
+		}
+		return *shard;
+	}
+
+	/// @return	Value of a counter combined over the shards, the mutex must be held.
+	[[nodiscard]] uint64_t combine(size_t index) const {
+		uint64_t combined = 0;
+		for (const std::unique_ptr<shard_t>& shard : shards) {
+			uint64_t value = shard->values[index].load(std::memory_order_relaxed);
+			combined = (counters[index].kind == Kind::COUNTER) ? combined + value : std::max(combined, value);
+		}
+		return combined;
+	}
+};
+
+#endif // METRICS_HPP
@@ -0,0 +1,140 @@
+/**
+ * 	\file		metrics_endpoint.hpp
+ *	\brief		Definition of the metrics endpoint of the Supervisor.
+ *	\details	This header file defines a small HTTP server that serves the metrics of the Supervisor
+				in the Prometheus text format, so that the load on the Supervisor can be watched live.
+ */
+
+#ifndef METRICS_ENDPOINT_HPP
+#define METRICS_ENDPOINT_HPP
+
+// Utility functions
+#include "metrics.hpp"
+
+// Constants
+#include "Constants.hpp"
+
+// Boost Headers
+#include <boost/asio.hpp>
+
+// System Libraries
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/**
+ * 	\class		Metrics_Endpoint
+ *	\brief		Definition of the metrics endpoint of the Supervisor.
+ *	\details	This class listens for HTTP connections on a local port in its own thread. Every request
+				is answered with the Metrics of the process in the Prometheus text format and the
+				connection is closed, so any path can be scraped. The metrics are only read when they are
+				requested, so the endpoint adds nothing to the models while nobody is watching.
+ */
+class Metrics_Endpoint {
+public:
+	/**
+	 * \brief 	Constructor for the endpoint, which starts listening immediately.
+	 * \param	address	const char * address the endpoint listens on, the loopback address by default.
+	 * \param	port	unsigned short port the endpoint listens on.
+	 */
+	explicit Metrics_Endpoint(const char * address = "127.0.0.1", unsigned short port = PORT_METRICS) : acceptor(io_service), retry_timer(io_service) {
+		boost::system::error_code err;
+		// Each step is checked on its own, so a failed bind is not hidden by a listen on an ephemeral port.
+		auto failed = [&err, port](const char * step) {
+			if (err) {
+				std::cout << "[Metrics Endpoint] (ERROR) Could not " << step << " on port " << port << ": " << err.message() << std::endl;
+			}
+			return static_cast<bool>(err);
+		};
+		boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(address, err), port);
+		if (failed("parse the address")) {
+			return;
+		}
+		acceptor.open(endpoint.protocol(), err);
+		if (failed("open the socket")) {
+			return;
+		}
+		acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), err);
+		if (failed("reuse the address")) {
+			return;
+		}
+		acceptor.bind(endpoint, err);
+		if (failed("bind")) {
+			return;
+		}
+		acceptor.listen(boost::asio::socket_base::max_connections, err);
+		if (failed("listen")) {
+			return;
+		}
+		std::cout << "[Metrics Endpoint] (INFO) Serving metrics on http://" << address << ":" << port << "/metrics" << std::endl;
+		accept();
+		server = std::thread([this] { io_service.run(); });
+	}
+
+	Metrics_Endpoint(const Metrics_Endpoint&) = delete;
+	Metrics_Endpoint& operator=(const Metrics_Endpoint&) = delete;
+
+	/// Destructor which stops the endpoint and waits for its thread to finish.
+	~Metrics_Endpoint() {
+		io_service.stop();
+		if (server.joinable()) {
+			server.join();
+		}
+	}
+
+private:
+	/// Service running the endpoint.
+	boost::asio::io_service io_service;
+	/// Acceptor listening for connections.
+	boost::asio::ip::tcp::acceptor acceptor;
+	/// Timer delaying the next accept after an accept fails.
+	boost::asio::steady_timer retry_timer;
+	/// Thread running the service.
+	std::thread server;
+
+	/// Function for waiting for the next connection.
+	void accept() {
+		auto socket = std::make_shared<boost::asio::ip::tcp::socket>(io_service);
+		acceptor.async_accept(*socket, [this, socket](const boost::system::error_code& err) {
+			if (err == boost::asio::error::operation_aborted) {
+				return;
+			}
+			if (!err) {
+				respond(socket);
+				accept();
+				return;
+			}
+			// Accepting again straight away would spin while the error lasts, such as when file descriptors run out.
+			retry_timer.expires_after(std::chrono::milliseconds(METRICS_ACCEPT_RETRY_MS));
+			retry_timer.async_wait([this](const boost::system::error_code& timer_err) {
+				if (!timer_err) {
+					accept();
+				}
+			});
+		});
+	}
+
+	/// Function for reading a request and answering it with the metrics.
+	void respond(const std::shared_ptr<boost::asio::ip::tcp::socket>& socket) {
+		auto request = std::make_shared<boost::asio::streambuf>();
+		boost::asio::async_read_until(*socket, *request, "\r\n\r\n", [socket, request](const boost::system::error_code& err, size_t) {
+			if (err) {
+				return;
+			}
+			std::string body = Metrics::instance().prometheus();
+			auto response = std::make_shared<std::string>(
+				"HTTP/1.0 200 OK\r\n"
+				"Content-Type: text/plain; version=0.0.4\r\n"
+				"Content-Length: " + std::to_string(body.size()) + "\r\n"
+				"Connection: close\r\n\r\n" + body
+			);
+			boost::asio::async_write(*socket, boost::asio::buffer(*response), [socket, response](const boost::system::error_code&, size_t) {
+				boost::system::error_code ignored;
+				socket->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+			});
+		});
+	}
+};
+
+#endif // METRICS_ENDPOINT_HPP
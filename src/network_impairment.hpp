@@ -0,0 +1,251 @@
+/**
+ * 	\file		network_impairment.hpp
+ *	\brief		Definition of the network impairment proxy.
+ *	\details	This header file defines a UDP proxy on the loopback interface that loses, duplicates,
+				reorders and delays the packets passing through it, so that the RUDP and UDP links of the
+				Supervisor can be tested under the conditions of the aircraft network on a single machine.
+ */
+
+#ifndef NETWORK_IMPAIRMENT_HPP
+#define NETWORK_IMPAIRMENT_HPP
+
+// Utility functions
+#include "io_thread.hpp"
+
+// Constants
+#include "Constants.hpp"
+
+// Boost Libraries
+#include <boost/asio.hpp>
+
+// System Libraries
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Enum for the distributions the delay of each packet can be drawn from.
+enum class Jitter_Distribution_E {
+	UNIFORM,
+	NORMAL,
+	PARETO
+};
+
+/**
+ *	\struct	impairment_profile_t
+ * 	\brief 	Definition of the impairments applied to each packet by the proxy.
+ * 	\param 	name				Name of the profile.
+ * 	\param 	loss				Probability of a packet being lost.
+ * 	\param 	duplication			Probability of a packet being delivered twice.
+ * 	\param 	reorder				Probability of a packet being held back so that the packets after it overtake it.
+ *	\param	latency_ms			Mean delay of a packet in milliseconds.
+ *	\param	jitter_ms			Spread of the delay of a packet in milliseconds.
+ *	\param	jitter_distribution	Distribution the delay of a packet is drawn from.
+ */
+struct impairment_profile_t {
+	std::string name;
+	double loss;
+	double duplication;
+	double reorder;
+	double latency_ms;
+	double jitter_ms;
+	Jitter_Distribution_E jitter_distribution;
+};
+
+/**
+ * 	\class		Impairment_Proxy
+ *	\brief		Definition of the network impairment proxy.
+ *	\details	The proxy listens on a local port and forwards every packet it receives to the target, and
+				every packet the target sends back, such as RUDP acknowledgements, to the last sender seen,
+				so a link is impaired by pointing its sender at the proxy instead of the receiver. Packets in
+				both directions are impaired by the same profile. Uniform delays are spread evenly over the
+				latency plus or minus the jitter, normal delays have the jitter as their standard deviation,
+				and Pareto delays add a heavy tail with a mean of the jitter to the latency. The decisions are
+				drawn from a seeded generator so that a run can be repeated, and the proxy runs in its own
+				thread, which is stopped when the proxy is destroyed.
+ */
+class Impairment_Proxy {
+public:
+	/**
+	 * \brief 	Constructor for the proxy, which starts forwarding immediately.
+	 * \param	i_profile		impairment_profile_t impairments applied to each packet.
+	 * \param	listen_port		unsigned short port on the loopback interface the proxy listens on.
+	 * \param	target_address	String IP version 4 address the packets are forwarded to.
+	 * \param	target_port		unsigned short port the packets are forwarded to.
+	 * \param	seed			uint32_t seed of the generator.
+	 */
+	Impairment_Proxy(impairment_profile_t i_profile, unsigned short listen_port, const std::string& target_address, unsigned short target_port, uint32_t seed = 1)
+			: profile(std::move(i_profile)), generator(seed) {
+		target = boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::from_string(target_address), target_port);
+		socket.open(boost::asio::ip::udp::v4());
+		socket.bind(boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::loopback(), listen_port));
+		receiver.start("Impairment Proxy", [this] {
+			start_receive();
+			io_service.run();
+			socket.close();
+		});
+	}
+
+	Impairment_Proxy(const Impairment_Proxy&) = delete;
+	Impairment_Proxy& operator=(const Impairment_Proxy&) = delete;
+
+	/// Destructor which stops forwarding, packets still being delayed are lost.
+	~Impairment_Proxy() {
+		receiver.stop([this] { io_service.stop(); });
+	}
+
+	/// @return	Number of packets sent on by the proxy, including duplicates.
+	[[nodiscard]] uint64_t forwarded_packets() const {
+		return forwarded.load(std::memory_order_relaxed);
+	}
+
+	/// @return	Number of bytes sent on by the proxy, including duplicates.
+	[[nodiscard]] uint64_t forwarded_bytes() const {
+		return bytes.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * 	\brief 	Operator for printing a summary of the packets that passed through the proxy.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, const Impairment_Proxy& proxy) {
+		os << "Profile: " << proxy.profile.name
+		   << " Received: " << proxy.received.load(std::memory_order_relaxed)
+		   << " Forwarded: " << proxy.forwarded_packets()
+		   << " Lost: " << proxy.lost.load(std::memory_order_relaxed)
+		   << " Duplicated: " << proxy.duplicated.load(std::memory_order_relaxed)
+		   << " Reordered: " << proxy.reordered.load(std::memory_order_relaxed);
+		return os;
+	}
+
+private:
+	/// Impairments applied to each packet.
+	impairment_profile_t profile;
+	/// Generator the impairment of each packet is drawn from, only used by the thread of the proxy.
+	std::mt19937 generator;
+	/// Endpoint the packets are forwarded to.
+	boost::asio::ip::udp::endpoint target;
+	/// Endpoint of the last sender, which the packets from the target are returned to.
+	boost::asio::ip::udp::endpoint client;
+	/// Endpoint of the packet that was just received.
+	boost::asio::ip::udp::endpoint remote;
+	/// Variable to store the Boost IO service.
+	boost::asio::io_service io_service;
+	/// Socket the proxy receives and forwards the packets on.
+	boost::asio::ip::udp::socket socket{ io_service };
+	/// Buffer to hold the packet that was just received.
+	char recv_buffer[MAX_SER_BUFFER_CHARS]{};
+
+	/// Counters of the packets that passed through the proxy.
+	std::atomic<uint64_t> received{0};
+	std::atomic<uint64_t> forwarded{0};
+	std::atomic<uint64_t> bytes{0};
+	std::atomic<uint64_t> lost{0};
+	std::atomic<uint64_t> duplicated{0};
+	std::atomic<uint64_t> reordered{0};
+
+	/// Thread forwarding the packets, declared last so that it is stopped before the members it uses are destroyed.
+	IO_Thread receiver;
+
+	/// Function for receiving the next packet, called again once each packet has been impaired.
+	void start_receive() {
+		if (receiver.stopping()) {
+			return;
+		}
+		socket.async_receive_from(
+			boost::asio::buffer(recv_buffer),
+			remote,
+			[this](const boost::system::error_code& error, size_t bytes_transferred) {
+				if (!error) {
+					received.fetch_add(1, std::memory_order_relaxed);
+					if (remote == target) {
+						if (client.port() != 0) {
+							impair(bytes_transferred, client);
+						}
+					}
+					else {
+						client = remote;
+						impair(bytes_transferred, target);
+					}
+				}
+				start_receive();
+			});
+	}
+
+	/// Function for deciding whether the packet just received is lost, duplicated or reordered and sending it on.
+	void impair(size_t length, const boost::asio::ip::udp::endpoint& destination) {
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		if (unit(generator) < profile.loss) {
+			lost.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		int copies = 1;
+		if (unit(generator) < profile.duplication) {
+			duplicated.fetch_add(1, std::memory_order_relaxed);
+			copies = 2;
+		}
+		auto packet = std::make_shared<std::vector<char>>(recv_buffer, recv_buffer + length);
+		for (int i = 0; i < copies; i++) {
+			double delay_ms = draw_delay();
+			if (unit(generator) < profile.reorder) {
+				reordered.fetch_add(1, std::memory_order_relaxed);
+				delay_ms += profile.jitter_ms + NETWORK_IMPAIRMENT_REORDER_HOLD_MS;
+			}
+			send_after(packet, destination, delay_ms);
+		}
+	}
+
+	/// @return	Delay of a packet in milliseconds drawn from the distribution of the profile.
+	double draw_delay() {
+		double delay_ms = profile.latency_ms;
+		if (profile.jitter_ms > 0.0) {
+			switch (profile.jitter_distribution) {
+				case Jitter_Distribution_E::NORMAL:
+					delay_ms += std::normal_distribution<double>(0.0, profile.jitter_ms)(generator);
+					break;
+				case Jitter_Distribution_E::PARETO: {
+					// The scale is chosen so that the mean of the tail is the jitter.
+					double scale = profile.jitter_ms * (NETWORK_IMPAIRMENT_PARETO_SHAPE - 1.0);
+					double u = 1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+					delay_ms += scale * (std::pow(u, -1.0 / NETWORK_IMPAIRMENT_PARETO_SHAPE) - 1.0);
+					break;
+				}
+				default:
+					delay_ms += std::uniform_real_distribution<double>(-profile.jitter_ms, profile.jitter_ms)(generator);
+					break;
+			}
+		}
+		return std::max(delay_ms, 0.0);
+	}
+
+	/// Function for sending a packet once its delay has passed, undelayed packets are sent immediately.
+	void send_after(const std::shared_ptr<std::vector<char>>& packet, const boost::asio::ip::udp::endpoint& destination, double delay_ms) {
+		if (delay_ms <= 0.0) {
+			send(*packet, destination);
+			return;
+		}
+		auto timer = std::make_shared<boost::asio::steady_timer>(io_service, std::chrono::microseconds(std::llround(delay_ms * 1E3)));
+		timer->async_wait([this, timer, packet, destination](const boost::system::error_code& error) {
+			if (!error) {
+				send(*packet, destination);
+			}
+		});
+	}
+
+	/// Function for sending a packet on, counting it if it was sent.
+	void send(const std::vector<char>& packet, const boost::asio::ip::udp::endpoint& destination) {
+		boost::system::error_code error;
+		socket.send_to(boost::asio::buffer(packet), destination, 0, error);
+		if (!error) {
+			forwarded.fetch_add(1, std::memory_order_relaxed);
+			bytes.fetch_add(packet.size(), std::memory_order_relaxed);
+		}
+	}
+};
+
+#endif // NETWORK_IMPAIRMENT_HPP
@@ -0,0 +1,234 @@
+/**
+ * 	\file		point_mass_model.hpp
+ *	\brief		Definition of the helicopter point mass model.
+ *	\details	This header file defines a point mass model of a helicopter flying the commands the
+				Supervisor sends to the FCC. It is a kinematic stand-in for the FCC and the aircraft so
+				that missions can be flown without the aircraft, and is not a model of the real dynamics.
+ */
+
+#ifndef POINT_MASS_MODEL_HPP
+#define POINT_MASS_MODEL_HPP
+
+// Messages structures
+#include "message_structures/message_aircraft_state_t.hpp"
+#include "message_structures/message_fcc_command_t.hpp"
+
+// Utility functions
+#include <mavNRC/geo.h>
+#include "Constants.hpp"
+
+// System Libraries
+#include <algorithm>
+#include <cmath>
+
+/**
+ * 	\class		Point_Mass_Model
+ *	\brief		Definition of the helicopter point mass model.
+ *	\details	This class flies the aircraft as a point with a limited acceleration, climb rate and
+				descent rate. Repositions fly straight to the commanded point and slow down to stop over
+				it, orbits fly around the commanded centre while correcting the distance to the centre,
+				and a landing request descends in place until the aircraft is on the ground. The ground
+				is flat at the height of the ground below the aircraft at the start.
+ */
+class Point_Mass_Model {
+public:
+	/// Default constructor for an aircraft on the ground at the origin.
+	Point_Mass_Model() : Point_Mass_Model(message_aircraft_state_t()) {}
+
+	/**
+	 * \brief 	Constructor for the model starting from an aircraft state.
+	 * \param	initial_state	message_aircraft_state_t state of the aircraft at the start, hovering.
+	 */
+	explicit Point_Mass_Model(const message_aircraft_state_t& initial_state) {
+		gps_time = initial_state.gps_time;
+		lat = initial_state.lat;
+		lon = initial_state.lon;
+		alt = initial_state.alt_MSL * FT_TO_METERS;
+		ground = (initial_state.alt_MSL - initial_state.alt_AGL) * FT_TO_METERS;
+		hdg = initial_state.hdg_Deg;
+		vel_north = 0.0f;
+		vel_east = 0.0f;
+		vel_up = 0.0f;
+		speed = FCC_EMULATOR_DEFAULT_VELOCITY;
+
+		// Hold the starting position until a command is received.
+		mode = Mode::HOLD;
+		target_lat = lat;
+		target_lon = lon;
+		target_alt = alt;
+		orbit_radius = 0.0f;
+	}
+
+	/**
+	 * \brief 	Function command is used to change what the aircraft is flying.
+	 * \details	Commands the FCC does not recognise are ignored.
+	 * \param	fcc_command	message_fcc_command_t command sent to the FCC.
+	 */
+	void command(const message_fcc_command_t& fcc_command) {
+		if (fcc_command.supervisor_status & (1 << 1)) {
+			mode = Mode::LAND;
+			return;
+		}
+
+		switch (static_cast<Mav_Command_E>(fcc_command.command)) {
+			case Mav_Command_E::MAV_CMD_DO_CHANGE_SPEED:
+				if (fcc_command.param2 > 0.0f) {
+					speed = fcc_command.param2;
+				}
+				break;
+			case Mav_Command_E::MAV_CMD_DO_REPOSITION:
+				mode = Mode::HOLD;
+				target_lat = fcc_command.latitude / 1E7;
+				target_lon = fcc_command.longitude / 1E7;
+				target_alt = fcc_command.altitude_msl;
+				break;
+			case Mav_Command_E::MAV_CMD_DO_ORBIT:
+				mode = Mode::ORBIT;
+				target_lat = fcc_command.latitude / 1E7;
+				target_lon = fcc_command.longitude / 1E7;
+				target_alt = fcc_command.altitude_msl;
+				orbit_radius = std::fabs(fcc_command.param1);
+				if (fcc_command.param2 > 0.0f) {
+					speed = fcc_command.param2;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	/**
+	 * \brief 	Function step is used to fly the aircraft forward in time.
+	 * \param	dt	float time to fly for in seconds, kept short so the integration stays accurate.
+	 */
+	void step(float dt) {
+		if (dt <= 0.0f) {
+			return;
+		}
+		gps_time += dt;
+
+		// Horizontal velocity the command is asking for, reached at the acceleration limit.
+		float desired_north = 0.0f;
+		float desired_east = 0.0f;
+		float to_north, to_east;
+		get_vector_to_next_waypoint(lat, lon, target_lat, target_lon, &to_north, &to_east);
+		float distance = std::hypot(to_north, to_east);
+		if (mode == Mode::HOLD && distance > FCC_EMULATOR_POSITION_TOLERANCE) {
+			float approach = std::min(speed, std::sqrt(2.0f * FCC_EMULATOR_ACCELERATION * distance));
+			desired_north = approach * to_north / distance;
+			desired_east = approach * to_east / distance;
+		} else if (mode == Mode::ORBIT && distance > 0.0f) {
+			// Fly clockwise around the centre, steering back towards the orbit radius.
+			float out_north = -to_north / distance;
+			float out_east = -to_east / distance;
+			float correction = -FCC_EMULATOR_ORBIT_GAIN * (distance - orbit_radius);
+			desired_north = speed * -out_east + correction * out_north;
+			desired_east = speed * out_north + correction * out_east;
+		}
+
+		float change_north = desired_north - vel_north;
+		float change_east = desired_east - vel_east;
+		float change = std::hypot(change_north, change_east);
+		float max_change = FCC_EMULATOR_ACCELERATION * dt;
+		if (change > max_change) {
+			change_north *= max_change / change;
+			change_east *= max_change / change;
+		}
+		vel_north += change_north;
+		vel_east += change_east;
+
+		// Vertical velocity, climbing or descending to the commanded altitude or descending to land.
+		if (mode == Mode::LAND) {
+			vel_up = -FCC_EMULATOR_DESCENT_RATE;
+		} else {
+			vel_up = std::clamp(target_alt - alt, -FCC_EMULATOR_DESCENT_RATE, FCC_EMULATOR_CLIMB_RATE);
+		}
+
+		add_vector_to_global_position(lat, lon, vel_north * dt, vel_east * dt, &lat, &lon);
+		alt += vel_up * dt;
+		if (alt <= ground) {
+			alt = ground;
+			vel_up = 0.0f;
+		}
+
+		if (std::hypot(vel_north, vel_east) > FCC_EMULATOR_HEADING_VELOCITY) {
+			hdg = std::fmod(std::atan2(vel_east, vel_north) * 180.0f / M_PI + 360.0f, 360.0f);
+		}
+	}
+
+	/// @return	true if the aircraft has stopped where it was commanded to, false if it is still flying.
+	[[nodiscard]] bool settled() const {
+		if (mode == Mode::ORBIT) {
+			return false;
+		}
+		if (std::hypot(vel_north, vel_east) > FCC_EMULATOR_SETTLED_VELOCITY || std::fabs(vel_up) > FCC_EMULATOR_SETTLED_VELOCITY) {
+			return false;
+		}
+		if (mode == Mode::LAND) {
+			return landed();
+		}
+		float to_north, to_east;
+		get_vector_to_next_waypoint(lat, lon, target_lat, target_lon, &to_north, &to_east);
+		return std::hypot(to_north, to_east) <= FCC_EMULATOR_POSITION_TOLERANCE && std::fabs(target_alt - alt) <= FCC_EMULATOR_POSITION_TOLERANCE;
+	}
+
+	/// @return	true if the aircraft has been asked to land, false otherwise.
+	[[nodiscard]] bool landing() const {
+		return mode == Mode::LAND;
+	}
+
+	/// @return	true if the aircraft has been asked to land and is on the ground, false otherwise.
+	[[nodiscard]] bool landed() const {
+		return mode == Mode::LAND && alt <= ground;
+	}
+
+	/// @return	Current state of the aircraft.
+	[[nodiscard]] message_aircraft_state_t aircraft_state() const {
+		return message_aircraft_state_t(
+				gps_time,
+				lat,
+				lon,
+				(alt - ground) * METERS_TO_FT,
+				alt * METERS_TO_FT,
+				hdg,
+				std::hypot(vel_north, vel_east) * MPS_TO_KTS
+		);
+	}
+
+private:
+	/// What the aircraft is flying.
+	enum class Mode {HOLD, ORBIT, LAND};
+
+	/// GPS time of the aircraft state in seconds.
+	double gps_time;
+	/// Latitude of the aircraft in degrees.
+	double lat;
+	/// Longitude of the aircraft in degrees.
+	double lon;
+	/// Altitude of the aircraft above mean sea level in meters.
+	float alt;
+	/// Altitude of the ground above mean sea level in meters.
+	float ground;
+	/// True heading of the aircraft in degrees.
+	float hdg;
+	/// Velocity of the aircraft towards the north in m/s.
+	float vel_north;
+	/// Velocity of the aircraft towards the east in m/s.
+	float vel_east;
+	/// Climb rate of the aircraft in m/s.
+	float vel_up;
+	/// Horizontal velocity commanded in m/s.
+	float speed;
+	/// What the aircraft is flying.
+	Mode mode;
+	/// Latitude in degrees of the reposition or of the orbit centre.
+	double target_lat;
+	/// Longitude in degrees of the reposition or of the orbit centre.
+	double target_lon;
+	/// Altitude above mean sea level in meters of the reposition or orbit.
+	float target_alt;
+	/// Radius of the orbit in meters.
+	float orbit_radius;
+};
+
+#endif // POINT_MASS_MODEL_HPP
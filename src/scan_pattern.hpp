@@ -0,0 +1,204 @@
+/**
+ * 	\file		scan_pattern.hpp
+ *	\brief		Definition of the landing zone scan patterns.
+ *	\details	This header file defines the patterns flown around the planned landing point while the
+				perception system scans the landing zone for landing points. The patterns are either a set
+				of expanding orbits or a lawnmower of parallel tracks, sized to be flown in the time given
+				for the scan, and are cached for each planned landing point so they are only generated once.
+ */
+
+#ifndef SCAN_PATTERN_HPP
+#define SCAN_PATTERN_HPP
+
+// Messages structures
+#include "message_structures/message_landing_point_t.hpp"
+
+// Utility functions
+#include <mavNRC/geo.h>
+#include "Constants.hpp"
+
+// System Libraries
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
+
+/// Enum for the patterns that can be flown to scan the landing zone.
+enum class Scan_Pattern_E {
+	EXPANDING_ORBIT,
+	LAWNMOWER
+};
+
+/**
+ *	\struct	scan_leg_t
+ * 	\brief 	Definition of a single leg of a landing zone scan.
+ * 	\param 	lat			Latitude in degrees of the orbit centre, or of the waypoint at the end of the leg.
+ * 	\param 	lon			Longitude in degrees of the orbit centre, or of the waypoint at the end of the leg.
+ *	\param	radius		Radius of the orbit in meters, 0 if the leg is a straight track to a waypoint.
+ *	\param	length		Distance flown along the leg in meters.
+ */
+struct scan_leg_t {
+	double lat;
+	double lon;
+	float radius;
+	float length;
+};
+
+/**
+ *	\struct	scan_pattern_t
+ * 	\brief 	Definition of a landing zone scan.
+ * 	\param 	legs		Legs of the scan in the order they are flown.
+ *	\param	velocity	Velocity in knots the legs are flown at.
+ */
+struct scan_pattern_t {
+	std::vector<scan_leg_t> legs;
+	float velocity;
+};
+
+/**
+ * 	\class		Scan_Pattern_Cache
+ *	\brief		Definition of the cache of landing zone scan patterns.
+ *	\details	This class generates the legs of a scan pattern around a planned landing point with
+				waypoint_from_heading_and_distance and stores them by the position and heading of the
+				planned landing point. Expanding orbits start at DEFAULT_ORBIT_RADIUS and grow by the swath
+				width, while the lawnmower flies tracks aligned with the heading of the planned landing
+				point, spaced by the swath width, over a square centred on the planned landing point.
+				The velocity is chosen so the pattern is flown in the time given for the scan. When that
+				would need more than the maximum velocity, the pattern is shrunk by a swath width at a
+				time until it fits.
+ */
+class Scan_Pattern_Cache {
+public:
+	/**
+	 * \brief 	Constructor for the cache with parameters for the shape of the patterns.
+	 * \param	i_pattern		Scan_Pattern_E pattern to generate.
+	 * \param	i_swath_width	float spacing in meters between neighbouring orbits or tracks.
+	 * \param	i_max_radius	float furthest distance in meters from the planned landing point to scan.
+	 * \param	i_max_velocity	float fastest velocity in knots the pattern is flown at.
+	 */
+	explicit Scan_Pattern_Cache(Scan_Pattern_E i_pattern = LZ_SCAN_PATTERN,
+								float i_swath_width = LZ_SCAN_SWATH_WIDTH,
+								float i_max_radius = LZ_SCAN_MAX_RADIUS,
+								float i_max_velocity = LZ_SCAN_MAX_VELOCITY) {
+		pattern = i_pattern;
+		swath_width = i_swath_width;
+		max_radius = i_max_radius;
+		max_velocity = i_max_velocity;
+	}
+
+	/**
+	 * \brief 	Function scan is used to get the scan pattern for a planned landing point, generating it if it is not cached.
+	 * \param	plp			message_landing_point_t planned landing point the pattern is centred on.
+	 * \param	duration	double time in seconds given for the scan.
+	 * \return	Legs of the scan pattern in the order they are flown and the velocity to fly them at.
+	 */
+	const scan_pattern_t& scan(const message_landing_point_t& plp, double duration) {
+		key_t key = make_key(plp, duration);
+		auto it = patterns.find(key);
+		if (it == patterns.end()) {
+			it = patterns.emplace(key, generate(plp, duration)).first;
+		}
+		return it->second;
+	}
+
+	/// @return	Time in seconds to fly every leg of a scan pattern.
+	static double duration(const scan_pattern_t& scan_pattern) {
+		double length = 0.0;
+		for (const auto& leg : scan_pattern.legs) {
+			length += leg.length;
+		}
+		return length / (scan_pattern.velocity * KTS_TO_MPS);
+	}
+
+	/// @return	Number of planned landing points with a cached pattern.
+	[[nodiscard]] size_t size() const {
+		return patterns.size();
+	}
+
+	/// Function for removing every cached pattern.
+	void clear() {
+		patterns.clear();
+	}
+
+private:
+	/// Key of a cached pattern, the position of the planned landing point in 1E-7 degrees, its heading in degrees and the scan time in ms.
+	using key_t = std::tuple<long, long, long, long long>;
+
+	/// Pattern to generate.
+	Scan_Pattern_E pattern;
+	/// Spacing in meters between neighbouring orbits or tracks.
+	float swath_width;
+	/// Furthest distance in meters from the planned landing point to scan.
+	float max_radius;
+	/// Fastest velocity in knots the pattern is flown at.
+	float max_velocity;
+	/// Cached patterns by planned landing point and scan time.
+	std::map<key_t, scan_pattern_t> patterns;
+
+	/// Function for building the cache key of a planned landing point and scan time.
+	static key_t make_key(const message_landing_point_t& plp, double duration) {
+		return {std::lround(plp.lat * 1E7), std::lround(plp.lon * 1E7), std::lround(plp.hdg), std::llround(duration * 1000.0)};
+	}
+
+	/// Function for generating the largest pattern up to the maximum radius that can be flown in the scan time.
+	scan_pattern_t generate(const message_landing_point_t& plp, double duration) const {
+		// The expanding orbits always keep their first orbit, the lawnmower keeps at least one track.
+		float min_radius = (pattern == Scan_Pattern_E::LAWNMOWER) ? 0.0f : DEFAULT_ORBIT_RADIUS;
+		scan_pattern_t scan_pattern;
+		float radius = max_radius;
+		while (true) {
+			scan_pattern.legs = (pattern == Scan_Pattern_E::LAWNMOWER) ? lawnmower(plp, radius) : expanding_orbit(plp, radius);
+			scan_pattern.velocity = DEFAULT_ORBIT_VELOCITY;
+			if (duration > 0.0) {
+				scan_pattern.velocity = std::max<float>(scan_pattern.velocity, DEFAULT_ORBIT_VELOCITY * Scan_Pattern_Cache::duration(scan_pattern) / duration);
+			}
+			if (scan_pattern.velocity <= max_velocity || swath_width <= 0.0f || radius - swath_width < min_radius) {
+				break;
+			}
+			radius -= swath_width;
+		}
+		scan_pattern.velocity = std::min(scan_pattern.velocity, max_velocity);
+		return scan_pattern;
+	}
+
+	/// Function for generating orbits around the planned landing point that grow by the swath width up to the radius.
+	std::vector<scan_leg_t> expanding_orbit(const message_landing_point_t& plp, float scan_radius) const {
+		std::vector<scan_leg_t> pattern_legs;
+		float radius = DEFAULT_ORBIT_RADIUS;
+		do {
+			pattern_legs.push_back(scan_leg_t{plp.lat, plp.lon, radius, static_cast<float>(2.0 * M_PI * radius)});
+			radius += swath_width;
+		} while (swath_width > 0.0f && radius <= scan_radius);
+		return pattern_legs;
+	}
+
+	/// Function for generating parallel tracks over a square of half width radius around the planned landing point, flown back and forth.
+	std::vector<scan_leg_t> lawnmower(const message_landing_point_t& plp, float scan_radius) const {
+		std::vector<scan_leg_t> pattern_legs;
+		float heading = plp.hdg * M_PI / 180.0;
+		float cross = -scan_radius;
+		float along = -scan_radius;
+		float previous_cross = 0.0f;
+		float previous_along = 0.0f;
+		do {
+			// Each track is entered at the end the previous track left from.
+			for (int end = 0; end < 2; end++) {
+				scan_leg_t leg{plp.lat, plp.lon, 0.0f, std::hypot(cross - previous_cross, along - previous_along)};
+				float distance = std::hypot(cross, along);
+				if (distance > 0.0f) {
+					waypoint_from_heading_and_distance(plp.lat, plp.lon, heading + std::atan2(cross, along), distance, &leg.lat, &leg.lon);
+				}
+				pattern_legs.push_back(leg);
+				previous_cross = cross;
+				previous_along = along;
+				along = -along;
+			}
+			cross += swath_width;
+			along = -along;
+		} while (swath_width > 0.0f && cross <= scan_radius);
+		return pattern_legs;
+	}
+};
+
+#endif // SCAN_PATTERN_HPP
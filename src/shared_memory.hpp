@@ -0,0 +1,61 @@
+/**
+ * 	\file		shared_memory.hpp
+ *	\brief		Definition of the shared memory connection of the Supervisor.
+ *	\details	This header file defines the single connection to the shared memory of the aircraft used by
+				every model that reads it.
+ */
+
+#ifndef SHARED_MEMORY_HPP
+#define SHARED_MEMORY_HPP
+
+// Utility functions
+#include "dependency.hpp"
+
+// Shared Memory Model
+#include <sharedmemorymodel/SharedMemoryModel.h>
+
+/**
+ * 	\class		Shared_Memory
+ *	\brief		Definition of the shared memory connection of the Supervisor.
+ *	\details	This class connects to shared memory once for the whole process, in the background from the
+				first time a model asks for it, retrying until the shared memory is available. Models must
+				check connected before reading the shared memory.
+ */
+class Shared_Memory {
+public:
+	/// @return	Shared memory connection of the process, connecting in the background on the first call.
+	static Shared_Memory& instance() {
+		static Shared_Memory shared_memory;
+		return shared_memory;
+	}
+
+	/// @return	true once the shared memory is connected and can be read.
+	[[nodiscard]] bool connected() const {
+		return dependency.ready();
+	}
+
+	/// @return	Shared memory model, only valid once connected.
+	[[nodiscard]] const SharedMemoryModel& model() const {
+		return shared_memory_model;
+	}
+
+private:
+	/// Variable used for shared memory management and access.
+	SharedMemoryModel shared_memory_model;
+	/// Connection to the shared memory, declared after the model it connects.
+	Dependency dependency{
+		"shared memory",
+		[this] {
+			shared_memory_model = SharedMemoryModel();
+			shared_memory_model.connectSharedMem();
+			return shared_memory_model.isConnected();
+		},
+		[this] {
+			shared_memory_model.disconnectSharedMem();
+		}
+	};
+
+	Shared_Memory() = default;
+};
+
+#endif // SHARED_MEMORY_HPP
@@ -0,0 +1,95 @@
+/**
+ * 	\file		startup_profile.hpp
+ *	\brief		Definition of the startup profile of the Supervisor.
+ *	\details	This header file defines a timeline of the startup of the Supervisor, from the launch of
+				the process until it is ready to accept start_supervisor, so that the startup time can be
+				measured and the slow steps found.
+ */
+
+#ifndef STARTUP_PROFILE_HPP
+#define STARTUP_PROFILE_HPP
+
+// Utility functions
+#include "metrics.hpp"
+
+// System Libraries
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * 	\class		Startup_Profile
+ *	\brief		Definition of the startup profile of the Supervisor.
+ *	\details	This class records the time of named startup events since the launch of the process, taken
+				as the static initialisation of the program. Events can be marked from any thread. The events
+				are printed together by report, and events marked after the report, such as dependencies that
+				connect once the simulation is running, are printed as they happen. The time of each event
+				is also served with the metrics of the Supervisor.
+ */
+class Startup_Profile {
+public:
+	/// @return	Startup profile shared by the whole process.
+	static Startup_Profile& instance() {
+		static Startup_Profile profile;
+		return profile;
+	}
+
+	/// @brief 	Function mark is used to record a startup event.
+	/// @param 	event	Name of the event.
+	void mark(const std::string& event) {
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launch).count();
+		std::lock_guard<std::mutex> lock(mutex);
+		events.push_back(event_t{event, ms});
+		Metrics& metrics = Metrics::instance();
+		metrics.maximum(metrics.add("supervisor_startup_milliseconds", "Time of the startup events since the launch of the process.", Metrics::Kind::MAXIMUM, "event=\"" + event + "\""), static_cast<uint64_t>(ms));
+		if (reported) {
+			print(events.back());
+		}
+	}
+
+	/// Function report is used to print the events marked so far, later events are printed as they are marked.
+	void report() {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::cout << "[Startup] (INFO) Startup timeline since the launch of the process:" << std::endl;
+		for (const event_t& event : events) {
+			print(event);
+		}
+		reported = true;
+	}
+
+private:
+	/**
+	 *	\struct	event_t
+	 * 	\brief 	Definition of a startup event.
+	 * 	\param 	name	Name of the event.
+	 *	\param	ms		Time of the event since the launch of the process in milliseconds.
+	 */
+	struct event_t {
+		std::string name;
+		double ms;
+	};
+
+	/// Time the process was launched, taken during static initialisation.
+	inline static const std::chrono::steady_clock::time_point launch = std::chrono::steady_clock::now();
+
+	/// Mutex guarding the events.
+	std::mutex mutex;
+	/// Events marked so far, in the order they were marked.
+	std::vector<event_t> events;
+	/// Whether the events have been reported.
+	bool reported = false;
+
+	Startup_Profile() = default;
+
+	/// Function print is used to print an event on its own line.
+	static void print(const event_t& event) {
+		char time[32];
+		std::snprintf(time, sizeof(time), "%10.1f ms", event.ms);
+		std::cout << "[Startup] (INFO) " << time << "  " << event.name << std::endl;
+	}
+};
+
+#endif // STARTUP_PROFILE_HPP
@@ -0,0 +1,120 @@
+/**
+ * 	\file		state_feed.hpp
+ *	\brief		Definition of the aircraft state feed of a fleet.
+ *	\details	This header file defines the receiver of the aircraft state of each vehicle of a fleet over UDP,
+				so that every vehicle reads the state of its own aircraft.
+ */
+
+#ifndef STATE_FEED_HPP
+#define STATE_FEED_HPP
+
+// Messages structures
+#include "message_structures/message_state_feed_t.hpp"
+
+// Utility functions
+#include "aircraft_state_source.hpp"
+
+// Constants
+#include "Constants.hpp"
+
+// Boost Headers
+#include <boost/asio.hpp>
+
+// System Libraries
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 	\class		State_Feed
+ *	\brief		Definition of the aircraft state feed of a fleet.
+ *	\details	Each vehicle listens on its own port for message_state_feed_t datagrams, which are stored in
+				a Stored_State_Source read by the input models of the vehicle. All of the ports are received
+				on by the one thread of the feed, so the number of threads does not grow with the fleet.
+				Datagrams that are not the size of a message_state_feed_t are dropped.
+ */
+class State_Feed {
+public:
+	/// Constructor for the feed, which starts its thread immediately.
+	State_Feed() : work(boost::asio::make_work_guard(io_service)) {
+		receiver = std::thread([this] { io_service.run(); });
+	}
+
+	State_Feed(const State_Feed&) = delete;
+	State_Feed& operator=(const State_Feed&) = delete;
+
+	/// Destructor which stops the feed and waits for its thread to finish.
+	~State_Feed() {
+		io_service.stop();
+		if (receiver.joinable()) {
+			receiver.join();
+		}
+	}
+
+	/**
+	 * \brief 	Function listen is used to start receiving the aircraft state of a vehicle.
+	 * \param	port	unsigned short local port the state of the vehicle is sent to.
+	 * \return	Source of the aircraft state of the vehicle, which connects when the first state is received.
+	 * \throws	boost::system::system_error if the port cannot be bound.
+	 */
+	std::shared_ptr<Aircraft_State_Source> listen(unsigned short port) {
+		auto feed = std::make_unique<feed_t>(io_service);
+		feed->socket.open(boost::asio::ip::udp::v4());
+		feed->socket.bind(boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::any(), port));
+		std::shared_ptr<Aircraft_State_Source> source = feed->source;
+		feed_t * receiving = feed.get();
+		{
+			std::lock_guard<std::mutex> lock(feeds_mutex);
+			feeds.push_back(std::move(feed));
+		}
+		// The receive is started on the thread of the feed, which is the only thread that uses the socket once listening.
+		boost::asio::post(io_service, [this, receiving] { receive(receiving); });
+		return source;
+	}
+
+private:
+	/// Socket and source of the state of one vehicle.
+	struct feed_t {
+		explicit feed_t(boost::asio::io_service& io_service) : socket(io_service) {}
+
+		boost::asio::ip::udp::socket socket;
+		boost::asio::ip::udp::endpoint sender;
+		// One byte longer than the message, so that a longer datagram is not taken for one.
+		char datagram[sizeof(message_state_feed_t) + 1];
+		std::shared_ptr<Stored_State_Source> source = std::make_shared<Stored_State_Source>();
+	};
+
+	/// Service running the receives of every vehicle, declared first so that the sockets are closed before it is destroyed.
+	boost::asio::io_service io_service;
+	/// Keeps the service running while no receive is pending.
+	boost::asio::executor_work_guard<boost::asio::io_service::executor_type> work;
+	/// Mutex protecting the list of feeds while vehicles are added.
+	std::mutex feeds_mutex;
+	/// Feed of each vehicle, which is not moved once added.
+	std::vector<std::unique_ptr<feed_t>> feeds;
+	/// Thread running the service.
+	std::thread receiver;
+
+	/// Function for waiting for the next state of a vehicle.
+	void receive(feed_t * feed) {
+		feed->socket.async_receive_from(boost::asio::buffer(feed->datagram, sizeof(feed->datagram)), feed->sender,
+			[this, feed](const boost::system::error_code& err, size_t bytes_received) {
+				if (err == boost::asio::error::operation_aborted) {
+					return;
+				}
+				if (!err && bytes_received == sizeof(message_state_feed_t)) {
+					message_state_feed_t state;
+					std::memcpy(&state, feed->datagram, sizeof(state));
+					feed->source->set(state.aircraft_state, state.safety_status);
+				} else if (err && err != boost::asio::error::message_size) {
+					std::cout << "[State Feed] (ERROR) Error receiving the aircraft state: " << err.message() << std::endl;
+				}
+				receive(feed);
+			});
+	}
+};
+
+#endif // STATE_FEED_HPP
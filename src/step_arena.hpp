@@ -0,0 +1,79 @@
+/**
+ * 	\file		step_arena.hpp
+ *	\brief		Definition of the step arena used by the atomic models.
+ *	\details	This header file defines a monotonic arena for the containers a model builds and discards
+				within a single step, so that they do not allocate from the heap on every step.
+ */
+
+#ifndef STEP_ARENA_HPP
+#define STEP_ARENA_HPP
+
+// Constants
+#include "Constants.hpp"
+
+// System Libraries
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * 	\class		Step_Arena
+ *	\brief		Definition of the step arena used by the atomic models.
+ *	\details	Each thread has a fixed buffer handed out by a std::pmr::monotonic_buffer_resource. A step of
+				a model opens a scope, and the arena is reset when the outermost scope of the thread closes,
+				so memory taken from the arena must not outlive the transition, output or time advance that
+				took it. Outside of a scope the arena is the default memory resource, so code using it works
+				the same when the model is not stepped by the Metered wrapper, only allocating from the heap.
+				Steps that need more than STEP_ARENA_BYTES continue on the heap until the scope closes.
+ */
+class Step_Arena {
+public:
+	/**
+	 *	\class	scope
+	 *	\brief 	Definition of a step of a model, the arena is reset when the outermost scope closes.
+	 */
+	class scope {
+	public:
+		scope() {
+			local().depth++;
+		}
+
+		~scope() {
+			arena_t& arena = local();
+			if (--arena.depth == 0) {
+				arena.resource.release();
+			}
+		}
+
+		scope(const scope&) = delete;
+		scope& operator=(const scope&) = delete;
+	};
+
+	/// @return	Memory resource of the step of the calling thread, the default resource outside of a step.
+	static std::pmr::memory_resource * resource() {
+		arena_t& arena = local();
+		return (arena.depth != 0) ? &arena.resource : std::pmr::get_default_resource();
+	}
+
+private:
+	/**
+	 *	\struct	arena_t
+	 * 	\brief 	Definition of the arena of a thread.
+	 * 	\param 	buffer		Memory handed out by the arena before falling back to the heap.
+	 *	\param	resource	Monotonic resource handing out the buffer.
+	 *	\param	depth		Number of scopes open on the thread.
+	 */
+	struct arena_t {
+		alignas(std::max_align_t) std::array<std::byte, STEP_ARENA_BYTES> buffer;
+		std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::new_delete_resource()};
+		unsigned int depth = 0;
+	};
+
+	/// @return	Arena of the calling thread.
+	static arena_t& local() {
+		thread_local arena_t arena;
+		return arena;
+	}
+};
+
+#endif // STEP_ARENA_HPP
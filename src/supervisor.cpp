@@ -14,23 +14,42 @@
 
 // Project information headers this is created by cmake at generation time!!!!
 #include "SupervisorConfig.hpp"
-#include "io_models/Supervisor_UDP_Input.hpp"
-#include "io_models/Aircraft_State_Input.hpp"
-#include "io_models/Polling_Condition_Input.hpp"
-#include "io_models/Packet_Builder.hpp"
-#include "io_models/UDP_Output.hpp"
-#include "io_models/RUDP_Output.hpp"
-#include "io_models/GPS_Time.hpp"
 
 //Coupled model headers
-#include "coupled_models/Supervisor.hpp"
+#include "coupled_models/Vehicle.hpp"
+#include "coupled_models/Emulated_Aircraft.hpp"
+
+//Metrics headers
+#include "loop_watchdog.hpp"
+#include "metrics_endpoint.hpp"
+#include "startup_profile.hpp"
+#include "time_warp.hpp"
 
 
 
 using hclock = std::chrono::high_resolution_clock;
 using TIME = NDTime;
 
-int main() {
+int main(int argc, char* argv[]) {
+	Startup_Profile::instance().mark("main entered");
+	if (argc != 1 && argc != 3) {
+		std::cout << "[Supervisor] (ERROR) Usage: " << argv[0] << " [<time warp factor> <initial aircraft state file>]" << std::endl;
+		return 1;
+	}
+	// With a time warp the aircraft is emulated in the process, so that its state is warped with the Supervisor.
+	const bool emulated = (argc == 3);
+	message_aircraft_state_t initial_state;
+	if (emulated) {
+		try {
+			Time_Warp::set_factor(Time_Warp::parse_factor(argv[1]));
+			initial_state = Emulated_Aircraft::read_initial_state(argv[2]);
+		} catch (const std::exception& error) {
+			std::cout << "[Supervisor] (ERROR) " << error.what() << std::endl;
+			return 1;
+		}
+		std::cout << "[Supervisor] (INFO) Simulated time runs " << Time_Warp::factor() << " times faster than the wall clock" << std::endl;
+		std::cout << "[Supervisor] (INFO) The aircraft is emulated, starting from the state in " << argv[2] << std::endl;
+	}
 	std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 	char folder_name[64] = {0};
 	std::strftime(folder_name, sizeof(folder_name), "%F-%H%M-%S", std::localtime(&now));
@@ -46,120 +65,33 @@ int main() {
 	boost::filesystem::create_directories(out_directory.c_str()); // Creates if it does not exist. Does nothing if it does.
 
 	// Instantiate the coupled model
-	Supervisor supervisor_instance = Supervisor();
-	std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> supervisor = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>("supervisor", supervisor_instance.submodels, supervisor_instance.iports, supervisor_instance.oports, supervisor_instance.eics, supervisor_instance.eocs, supervisor_instance.ics);
-
-	// Instantiate the input readers.
-	std::shared_ptr<cadmium::dynamic::modeling::model> im_udp_interface = cadmium::dynamic::translate::make_dynamic_atomic_model<Supervisor_UDP_Input, TIME, TIME, unsigned short>("im_udp_interface", std::move(TIME("00:00:00:100")), 23001);
-	std::shared_ptr<cadmium::dynamic::modeling::model> im_aircraft_state = cadmium::dynamic::translate::make_dynamic_atomic_model<Aircraft_State_Input, TIME>("im_aircraft_state");
-	std::shared_ptr<cadmium::dynamic::modeling::model> im_landing_achieved = cadmium::dynamic::translate::make_dynamic_atomic_model<Polling_Condition_Input_Landing_Achieved, TIME, TIME, float>("im_landing_achieved", std::move(TIME("00:00:00:100")), DEFAULT_LAND_CRITERIA_VERT_DIST);
-	std::shared_ptr<cadmium::dynamic::modeling::model> im_pilot_takeover = cadmium::dynamic::translate::make_dynamic_atomic_model<Polling_Condition_Input_Pilot_Takeover, TIME, TIME>("im_pilot_takeover", std::move(TIME("00:00:01:000")));
-
-    // Instantiate the Packet Builders.
-	std::shared_ptr<cadmium::dynamic::modeling::model> pb_bool_mission_complete = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_Bool, TIME, uint8_t>("pb_bool_mission_complete", SIG_ID_MISSION_COMPLETE);
-    std::shared_ptr<cadmium::dynamic::modeling::model> pb_int_mission_start = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_Int, TIME, uint8_t>("pb_int_mission_start", SIG_ID_START_MISSION);
-    std::shared_ptr<cadmium::dynamic::modeling::model> pb_bool_update_mission_item = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_Bool, TIME, uint8_t>("pb_bool_update_mission_item", SIG_ID_MISSION_ITEM_REACHED);
-    std::shared_ptr<cadmium::dynamic::modeling::model> pb_uint8_set_mission_monitor_status = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_Uint8, TIME, uint8_t>("pb_uint8_set_mission_monitor_status", SIG_ID_SET_MISSION_MONITOR_STATUS);
-
-    std::shared_ptr<cadmium::dynamic::modeling::model> pb_boss = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_Boss, TIME>("pb_boss");
-    std::shared_ptr<cadmium::dynamic::modeling::model> pb_fcc = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_Fcc, TIME>("pb_fcc");
-    std::shared_ptr<cadmium::dynamic::modeling::model> pb_gcs = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_GCS, TIME>("pb_gcs");
-    std::shared_ptr<cadmium::dynamic::modeling::model> pb_landing_point = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_Landing_Point, TIME>("pb_landing_point");
-
-    std::shared_ptr<cadmium::dynamic::modeling::model> udp_boss = cadmium::dynamic::translate::make_dynamic_atomic_model<UDP_Output, TIME, const char *, const unsigned short, bool>("udp_boss", IPV4_BOSS, PORT_BOSS, true);
-    std::shared_ptr<cadmium::dynamic::modeling::model> udp_fcc = cadmium::dynamic::translate::make_dynamic_atomic_model<UDP_Output, TIME, const char *, const unsigned short, bool>("udp_fcc", IPV4_FCC, PORT_FCC, true);
-    std::shared_ptr<cadmium::dynamic::modeling::model> udp_gcs = cadmium::dynamic::translate::make_dynamic_atomic_model<UDP_Output, TIME, const char *, const unsigned short, bool>("udp_gcs", IPV4_GCS, PORT_GCS, false);
-    std::shared_ptr<cadmium::dynamic::modeling::model> udp_gcs_broadcast = cadmium::dynamic::translate::make_dynamic_atomic_model<UDP_Output, TIME, const char *, const unsigned short, bool>("udp_gcs_broadcast", IPV4_QGC_BROADCAST, PORT_QGC_BROADCAST, true);
-    std::shared_ptr<cadmium::dynamic::modeling::model> rudp_mavnrc = cadmium::dynamic::translate::make_dynamic_atomic_model<RUDP_Output, TIME, const char *, const unsigned short, int, int>("rudp_mavnrc", IPV4_MAVNRC, PORT_MAVNRC, DEFAULT_TIMEOUT_MS, 10);
-
-    // Instantiate GPS time logger
-	std::shared_ptr<cadmium::dynamic::modeling::model> gps_time = cadmium::dynamic::translate::make_dynamic_atomic_model<GPS_Time, TIME>("a_gps_time");
-
-    // The models to be included in this coupled model
-	// (accepts atomic and coupled models)
- 	cadmium::dynamic::modeling::Models submodels_TestDriver = {
-            supervisor,
-            im_landing_achieved,
-            im_aircraft_state,
-            im_pilot_takeover,
-            im_udp_interface,
-            pb_bool_mission_complete,
-            pb_int_mission_start,
-			pb_bool_update_mission_item,
-            pb_uint8_set_mission_monitor_status,
-            pb_boss,
-            pb_fcc,
-            pb_gcs,
-            pb_landing_point,
-            udp_boss,
-            udp_fcc,
-            udp_gcs,
-			udp_gcs_broadcast,
-            gps_time,
-            rudp_mavnrc
-	};
-
- 	cadmium::dynamic::modeling::Ports iports_TestDriver = { };
-
- 	cadmium::dynamic::modeling::Ports oports_TestDriver = { };
-
- 	cadmium::dynamic::modeling::EICs eics_TestDriver = { };
-
-	// The output ports will be used to export in logging
- 	cadmium::dynamic::modeling::EOCs eocs_TestDriver = {	};
-
-	// This will connect our outputs from our input reader to the file
- 	cadmium::dynamic::modeling::ICs ics_TestDriver = {
-		cadmium::dynamic::translate::make_IC<Polling_Condition_Input_Landing_Achieved<TIME>::defs::o_message, Supervisor::defs::i_landing_achieved>("im_landing_achieved", "supervisor"),
-		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_land, Polling_Condition_Input_Landing_Achieved<TIME>::defs::i_start>("supervisor", "im_landing_achieved"),
-		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_mission_complete, Polling_Condition_Input_Landing_Achieved<TIME>::defs::i_quit>("supervisor", "im_landing_achieved"),
-
-		cadmium::dynamic::translate::make_IC<Aircraft_State_Input<TIME>::defs::o_message, Supervisor::defs::i_aircraft_state>("im_aircraft_state", "supervisor"),
-		cadmium::dynamic::translate::make_IC<Supervisor::defs::o_request_aircraft_state, Aircraft_State_Input<TIME>::defs::i_request>("supervisor", "im_aircraft_state"),
-
-		cadmium::dynamic::translate::make_IC<Polling_Condition_Input_Pilot_Takeover<TIME>::defs::o_message, Supervisor::defs::i_pilot_takeover>("im_pilot_takeover", "supervisor"),
-		// cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_start_supervisor, Polling_Condition_Input_Pilot_Takeover<TIME>::defs::i_start>("im_udp_interface", "im_pilot_takeover"),
-		// cadmium::dynamic::translate::make_IC<Supervisor::defs::o_mission_complete, Polling_Condition_Input_Pilot_Takeover<TIME>::defs::i_quit>("supervisor", "im_pilot_takeover"),
-
-		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_lp_recv, Supervisor::defs::i_LP_recv>("im_udp_interface", "supervisor"),
-		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_plp_ach, Supervisor::defs::i_PLP_ach>("im_udp_interface", "supervisor"),
-		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_perception_status, Supervisor::defs::i_perception_status>("im_udp_interface", "supervisor"),
-		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_start_supervisor, Supervisor::defs::i_start_supervisor>("im_udp_interface", "supervisor"),
-		cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_waypoint, Supervisor::defs::i_waypoint>("im_udp_interface", "supervisor"),
-		// cadmium::dynamic::translate::make_IC<Supervisor::defs::o_mission_complete, Supervisor_UDP_Input<TIME>::defs::i_quit>("supervisor", "im_udp_interface"),
-
-		// Output ICs
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_LP_new, Packet_Builder_Landing_Point<TIME>::defs::i_data>("supervisor", "pb_landing_point"),
-
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_start_mission, Packet_Builder_Int<TIME>::defs::i_data>("supervisor", "pb_int_mission_start"),
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_mission_complete, Packet_Builder_Bool<TIME>::defs::i_data>("supervisor", "pb_bool_mission_complete"),
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_update_mission_item, Packet_Builder_Bool<TIME>::defs::i_data>("supervisor", "pb_bool_update_mission_item"),
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_set_mission_monitor_status, Packet_Builder_Uint8<TIME>::defs::i_data>("supervisor", "pb_uint8_set_mission_monitor_status"),
-
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_update_boss, Packet_Builder_Boss<TIME>::defs::i_data>("supervisor", "pb_boss"),
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_update_gcs, Packet_Builder_GCS<TIME>::defs::i_data>("supervisor", "pb_gcs"),
-
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_hover, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_land, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_orbit, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_command_velocity, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
-        cadmium::dynamic::translate::make_IC<Supervisor::defs::o_fcc_waypoint_update, Packet_Builder_Fcc<TIME>::defs::i_data>("supervisor", "pb_fcc"),
-
-        cadmium::dynamic::translate::make_IC<Packet_Builder_Boss<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("pb_boss", "udp_boss"),
-        cadmium::dynamic::translate::make_IC<Packet_Builder_Fcc<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("pb_fcc", "udp_fcc"),
-        cadmium::dynamic::translate::make_IC<Packet_Builder_GCS<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("pb_gcs", "udp_gcs"),
-        cadmium::dynamic::translate::make_IC<Packet_Builder_GCS<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("pb_gcs", "udp_gcs_broadcast"),
-
-        cadmium::dynamic::translate::make_IC<Packet_Builder_Int<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_int_mission_start", "rudp_mavnrc"),
-        cadmium::dynamic::translate::make_IC<Packet_Builder_Bool<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_bool_mission_complete", "rudp_mavnrc"),
-        cadmium::dynamic::translate::make_IC<Packet_Builder_Bool<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_bool_update_mission_item", "rudp_mavnrc"),
-        cadmium::dynamic::translate::make_IC<Packet_Builder_Uint8<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_uint8_set_mission_monitor_status", "rudp_mavnrc"),
-        cadmium::dynamic::translate::make_IC<Packet_Builder_Landing_Point<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_landing_point", "rudp_mavnrc"),
-	};
-
-	std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> test_driver = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
-		"test_driver", submodels_TestDriver, iports_TestDriver, oports_TestDriver, eics_TestDriver, eocs_TestDriver, ics_TestDriver
-	);
+	std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> test_driver;
+	if (emulated) {
+		// The vehicle reads the state the emulated aircraft publishes, and sends it the FCC packets.
+		std::shared_ptr<Stored_State_Source> state_source = std::make_shared<Stored_State_Source>();
+		Vehicle vehicle_instance = Vehicle(0, state_source);
+		Emulated_Aircraft aircraft_instance = Emulated_Aircraft(initial_state, state_source);
+		cadmium::dynamic::modeling::Models submodels = {
+			std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+				"vehicle", vehicle_instance.submodels, vehicle_instance.iports, vehicle_instance.oports, vehicle_instance.eics, vehicle_instance.eocs, vehicle_instance.ics
+			),
+			std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+				"emulated_aircraft", aircraft_instance.submodels, aircraft_instance.iports, aircraft_instance.oports, aircraft_instance.eics, aircraft_instance.eocs, aircraft_instance.ics
+			)
+		};
+		cadmium::dynamic::modeling::ICs ics = {
+			cadmium::dynamic::translate::make_IC<Vehicle::defs::o_fcc_packet, Emulated_Aircraft::defs::i_fcc_packet>("vehicle", "emulated_aircraft")
+		};
+		test_driver = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+			"test_driver", submodels, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics
+		);
+	} else {
+		Vehicle vehicle_instance = Vehicle();
+		test_driver = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+			"test_driver", vehicle_instance.submodels, vehicle_instance.iports, vehicle_instance.oports, vehicle_instance.eics, vehicle_instance.eocs, vehicle_instance.ics
+		);
+	}
+	Startup_Profile::instance().mark("models built");
 
 	/*************** Loggers *******************/
     static std::ofstream out_messages;
@@ -183,9 +115,19 @@ int main() {
 	using log_messages = cadmium::logger::logger<cadmium::logger::logger_messages, cadmium::dynamic::logger::formatter<TIME>, oss_sink_messages>;
 	using global_time_mes = cadmium::logger::logger<cadmium::logger::logger_global_time, cadmium::dynamic::logger::formatter<TIME>, oss_sink_messages>;
 	using global_time_sta = cadmium::logger::logger<cadmium::logger::logger_global_time, cadmium::dynamic::logger::formatter<TIME>, oss_sink_state>;
-	using logger_supervisor = cadmium::logger::multilogger<state, log_messages, global_time_mes, global_time_sta>;
+	// The loop monitor is first so that a blocked logger delays the next iteration it sees.
+	using logger_supervisor = cadmium::logger::multilogger<loop_monitor_logger, state, log_messages, global_time_mes, global_time_sta>;
+
+	// Serve the message and transition counts of the models while they run.
+	Metrics_Endpoint metrics_endpoint;
+	// Publish a heartbeat with the period and lateness of the loop, and alert the GCS when it is late.
+	Loop_Watchdog<TIME> loop_watchdog;
+	Startup_Profile::instance().mark("monitoring started");
 
 	cadmium::dynamic::engine::runner<NDTime, logger_supervisor> r(test_driver, { TIME("00:00:00:000:000") });
+	Startup_Profile::instance().mark("runner ready");
+	// Dependencies still connecting in the background are reported as they connect.
+	Startup_Profile::instance().report();
 	r.run_until_passivate();
 
 	return 0;
@@ -1,15 +1,48 @@
 #ifndef TIME_CONVERSION_H
 #define TIME_CONVERSION_H
 
-#include <string>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
+// The conversions build and read the fields of the time directly, so that they do not format or parse text.
+template<typename TIME>
+TIME milliseconds_to_time(uint64_t time) {
+	auto hours = static_cast<int>(time / 3600000);
+	auto mins = static_cast<int>((time / 60000) % 60);
+	auto secs = static_cast<int>((time / 1000) % 60);
+	auto millis = static_cast<int>(time % 1000);
+	return TIME({hours, mins, secs, millis});
+}
+
+// Rounds to the nearest millisecond, as 0.3 s is not exact in binary and would otherwise be truncated to 299 ms.
 template<typename TIME>
 TIME seconds_to_time(double time) {
-	int hours = time / 3600;
-	int mins = (time - hours * 3600) / 60;
-	int secs = (time - hours * 3600 - mins * 60);
-	int millis = (time - hours * 3600 - mins * 60 - secs) * 100;
-	return TIME(std::to_string(hours) + ":" + std::to_string(mins) + ":" + std::to_string(secs) + ":" + std::to_string(millis));
+	return milliseconds_to_time<TIME>((time > 0) ? static_cast<uint64_t>(std::llround(time * 1000.0)) : 0);
+}
+
+template<typename TIME>
+TIME microseconds_to_time(uint64_t time) {
+	auto hours = static_cast<int>(time / 3600000000);
+	auto mins = static_cast<int>((time / 60000000) % 60);
+	auto secs = static_cast<int>((time / 1000000) % 60);
+	auto millis = static_cast<int>((time / 1000) % 1000);
+	auto micros = static_cast<int>(time % 1000);
+	return TIME({hours, mins, secs, millis, micros});
+}
+
+// Reads the time from its fields, returning infinity if it is infinite.
+template<typename TIME>
+double time_to_seconds(const TIME& time) {
+	if (time == std::numeric_limits<TIME>::infinity()) {
+		return std::numeric_limits<double>::infinity();
+	}
+	if (time < TIME()) {
+		return -time_to_seconds(TIME() - time);
+	}
+	return time.getHours() * 3600.0 + time.getMinutes() * 60.0 + time.getSeconds()
+		+ time.getMilliseconds() * 1E-3 + time.getMicroseconds() * 1E-6 + time.getNanoseconds() * 1E-9
+		+ time.getPicoseconds() * 1E-12 + time.getFemtoseconds() * 1E-15;
 }
 
 #endif /* TIME_CONVERSION_H */
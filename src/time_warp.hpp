@@ -0,0 +1,100 @@
+/**
+ * 	\file		time_warp.hpp
+ *	\brief		Definition of the time warp of the real-time runner.
+ *	\details	This header file defines a speed factor between the simulated time of the models and the
+				wall clock followed by the real-time runner, so that long flights can be run in a fraction
+				of their duration with the real I/O models.
+ */
+
+#ifndef TIME_WARP_HPP
+#define TIME_WARP_HPP
+
+// Utility functions
+#include "time_conversion.hpp"
+
+// System Libraries
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * 	\class		Time_Warp
+ *	\brief		Definition of the time warp of the real-time runner.
+ *	\details	The runner follows the wall clock, so the time advances of the models are divided by the
+				factor before the runner sees them, and the elapsed times the runner passes back are
+				multiplied by it. The models therefore see simulated time, which runs factor times faster
+				than the wall clock. The conversion is done by the Metered wrapper, so every model of a
+				vehicle is warped the same, and is skipped entirely when the factor is 1. The times
+				written to the logs by the runner are wall clock times.
+ *	\note		A warped vehicle flies the Emulated_Aircraft, whose models are Metered as well, so the
+				aircraft state it reads is warped with it. The runners reject a factor other than 1 for
+				vehicles reading the shared memory or a state feed, which follow the wall clock.
+ */
+class Time_Warp {
+public:
+	/// @return	Number of simulated seconds that pass in each second of the wall clock.
+	static double factor() {
+		return warp_factor;
+	}
+
+	/**
+	 * \brief 	Function set_factor is used to set the factor before the runner is started.
+	 * \param	factor	Number of simulated seconds that pass in each second of the wall clock.
+	 */
+	static void set_factor(double factor) {
+		if (!std::isfinite(factor) || factor <= 0.0) {
+			throw(std::invalid_argument("The time warp factor must be a positive number."));
+		}
+		warp_factor = factor;
+	}
+
+	/**
+	 * \brief 	Function parse_factor is used to read the factor from a command line argument.
+	 * \param	argument	Text of the factor, such as "10" or "100".
+	 * \return	Factor read from the argument, checked by set_factor.
+	 */
+	static double parse_factor(const std::string& argument) {
+		size_t length = 0;
+		double factor = 0.0;
+		try {
+			factor = std::stod(argument, &length);
+		}
+		catch (std::exception&) {
+			length = 0;
+		}
+		if (length == 0 || length != argument.size()) {
+			throw(std::invalid_argument("The time warp factor must be a positive number, not " + argument + "."));
+		}
+		return factor;
+	}
+
+	/// @return	Wall clock duration of a simulated duration, which is unchanged if it is infinite.
+	template<typename TIME>
+	static TIME to_wall(const TIME& simulated) {
+		return (warp_factor == 1.0) ? simulated : scale(simulated, 1.0 / warp_factor);
+	}
+
+	/// @return	Simulated duration of a wall clock duration, which is unchanged if it is infinite.
+	template<typename TIME>
+	static TIME to_simulated(const TIME& wall) {
+		return (warp_factor == 1.0) ? wall : scale(wall, warp_factor);
+	}
+
+private:
+	/// Number of simulated seconds that pass in each second of the wall clock.
+	inline static double warp_factor = 1.0;
+
+	/// Function scale is used to multiply a duration, keeping durations that are not zero from rounding to zero.
+	template<typename TIME>
+	static TIME scale(const TIME& time, double multiplier) {
+		double seconds = time_to_seconds(time);
+		if (!std::isfinite(seconds) || seconds <= 0.0) {
+			return time;
+		}
+		auto microseconds = static_cast<uint64_t>(std::llround(seconds * multiplier * 1E6));
+		return microseconds_to_time<TIME>((microseconds == 0) ? 1 : microseconds);
+	}
+};
+
+#endif // TIME_WARP_HPP
@@ -0,0 +1,349 @@
+/**
+ * 	\file		timer_wheel.hpp
+ *	\brief		Definition of the hierarchical timer wheel.
+ *	\details	This header file defines a hierarchical timer wheel used by the atomic models to keep
+				track of multiple named timers. The elapsed time of each transition is given to the wheel,
+				which works out the timers that have expired and the time until the next expiry.
+ */
+
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+// Utility functions
+#include "cold_storage.hpp"
+#include "time_conversion.hpp"
+
+// System Libraries
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * 	\class		Timer_Wheel
+ *	\brief		Definition of the hierarchical timer wheel.
+ *	\details	This class stores named timers in a hierarchy of wheels with a resolution of one
+				millisecond. Each level has 64 slots, and a timer is placed in the lowest level where its
+				deadline shares all of the higher bits with the current time. Once a timer is found, arming,
+				cancelling and expiring it are O(1), and the next expiry is found from the first occupied slot
+				of the lowest occupied level. Timers in higher levels are cascaded down as the current time
+				reaches their slot. A model only has a few named timers, so they are found by a linear search
+				of the one array holding them rather than through a hash map. The slots are only used when the
+				timers are armed, cancelled or advanced, so they are kept in Cold_Storage, and the earliest
+				deadline is cached inline for the time advances of the models.
+ */
+template<typename TIME>
+class Timer_Wheel {
+public:
+	/// Default constructor for the timer wheel.
+	Timer_Wheel() {
+		clear();
+	}
+
+	/// Function for cancelling all timers and resetting the current time of the wheel.
+	void clear() {
+		timers.clear();
+		for (auto& level : wheel->slots) {
+			level.fill(NONE);
+		}
+		wheel->occupied.fill(0);
+		now = 0;
+		earliest = NO_DEADLINE;
+	}
+
+	/// @brief 	Function arm is used to start a named timer, restarting it if it is already armed.
+	/// @param 	name		Name of the timer.
+	/// @param 	duration	TIME until the timer expires, a timer armed with infinity never expires and is cancelled.
+	void arm(const std::string& name, TIME duration) {
+		if (std::isinf(time_to_seconds(duration))) {
+			cancel(name);
+			return;
+		}
+		size_t index = find_or_add(name);
+		bool was_earliest = (timers[index].status == Status::PENDING && timers[index].deadline == earliest);
+		unlink(index);
+		timers[index].deadline = now + time_to_milliseconds(duration);
+		timers[index].status = Status::PENDING;
+		link(index);
+		if (was_earliest) {
+			update_earliest();
+		} else {
+			earliest = std::min(earliest, timers[index].deadline);
+		}
+	}
+
+	/// @brief 	Function cancel is used to stop a named timer without it expiring.
+	/// @param 	name	Name of the timer.
+	void cancel(const std::string& name) {
+		size_t index = find(name);
+		if (index != timers.size()) {
+			bool was_pending = (timers[index].status == Status::PENDING);
+			unlink(index);
+			timers[index].status = Status::IDLE;
+			if (was_pending) {
+				update_earliest();
+			}
+		}
+	}
+
+	/**
+	 *	\brief 		Function advance is used to move the current time of the wheel forward.
+	 *	\details	Every timer with a deadline at or before the new current time is expired.
+	 * 	\param		e	TIME elapsed since the wheel was last advanced.
+	 */
+	void advance(TIME e) {
+		assert(!std::isinf(time_to_seconds(e)) && "Timer wheel advanced by an infinite time.");
+		uint64_t target = now + time_to_milliseconds(e);
+		// Nothing expires before the cached earliest deadline, so the slots are only visited when a timer is due.
+		if (earliest > target) {
+			now = target;
+			cascade();
+			return;
+		}
+		uint64_t deadline;
+		while (next_deadline(deadline) && deadline <= target) {
+			now = deadline;
+			cascade();
+			expire_slot();
+		}
+		now = target;
+		cascade();
+		update_earliest();
+	}
+
+	/// @return	true if the named timer is waiting to expire, false otherwise.
+	[[nodiscard]] bool armed(const std::string& name) const {
+		size_t index = find(name);
+		return index != timers.size() && timers[index].status == Status::PENDING;
+	}
+
+	/// @return	true if the named timer has expired since it was last armed, false otherwise.
+	[[nodiscard]] bool expired(const std::string& name) const {
+		size_t index = find(name);
+		return index != timers.size() && timers[index].status == Status::EXPIRED;
+	}
+
+	/// @return	TIME left before the named timer expires, zero if it has expired and infinity if it is not armed.
+	[[nodiscard]] TIME remaining(const std::string& name) const {
+		size_t index = find(name);
+		if (index == timers.size() || timers[index].status == Status::IDLE) {
+			return std::numeric_limits<TIME>::infinity();
+		}
+		if (timers[index].status == Status::EXPIRED) {
+			return TIME();
+		}
+		return milliseconds_to_time<TIME>(timers[index].deadline - now);
+	}
+
+	/// @return	TIME left before the next timer expires, infinity if no timers are armed.
+	[[nodiscard]] TIME next_expiry() const {
+		if (earliest == NO_DEADLINE) {
+			return std::numeric_limits<TIME>::infinity();
+		}
+		return milliseconds_to_time<TIME>(earliest - now);
+	}
+
+private:
+	/// Number of bits of the deadline used to index the slots of each level.
+	static constexpr unsigned SLOT_BITS = 6;
+	/// Number of slots in each level.
+	static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+	/// Number of levels, enough for timers of over two years.
+	static constexpr unsigned LEVELS = 6;
+	/// Index of a timer, kept small so that the slots of every level take fewer cache lines.
+	using index_t = uint16_t;
+	/// Index used to mark the end of a slot list.
+	static constexpr index_t NONE = std::numeric_limits<index_t>::max();
+	/// Deadline used when no timer is pending.
+	static constexpr uint64_t NO_DEADLINE = std::numeric_limits<uint64_t>::max();
+
+	/// Status of a named timer.
+	enum class Status {IDLE, PENDING, EXPIRED};
+
+	/**
+	 *	\struct	timer_t
+	 * 	\brief 	Definition of a named timer stored in the wheel.
+	 * 	\param 	deadline	Time in milliseconds the timer expires at.
+	 *	\param	status		Whether the timer is idle, pending or expired.
+	 *	\param	level		Level of the wheel the timer is stored in.
+	 *	\param	slot		Slot of the level the timer is stored in.
+	 *	\param	prev		Index of the previous timer in the slot.
+	 *	\param	next		Index of the next timer in the slot.
+	 *	\param	name		Name of the timer.
+	 */
+	struct timer_t {
+		uint64_t deadline;
+		Status status;
+		unsigned level;
+		unsigned slot;
+		index_t prev;
+		index_t next;
+		std::string name;
+	};
+
+	/**
+	 *	\struct	wheel_t
+	 * 	\brief 	Definition of the slots of the wheel, which are only used when the timers change.
+	 * 	\param 	slots		Index of the first timer in each slot of each level.
+	 *	\param	occupied	Bitmap of the occupied slots of each level.
+	 */
+	struct wheel_t {
+		std::array<std::array<index_t, SLOTS>, LEVELS> slots;
+		std::array<uint64_t, LEVELS> occupied;
+	};
+
+	/// Timers indexed by the order their names were first armed, searched by name as a model only has a few.
+	std::vector<timer_t> timers;
+	/// Slots of the wheel, kept out of line, see wheel_t.
+	Cold_Storage<wheel_t> wheel;
+	/// Current time of the wheel in milliseconds.
+	uint64_t now;
+	/// Earliest deadline of the pending timers in milliseconds, NO_DEADLINE if none are pending.
+	uint64_t earliest;
+
+	/// Function for finding the earliest deadline again after a timer has stopped being pending.
+	void update_earliest() {
+		if (!next_deadline(earliest)) {
+			earliest = NO_DEADLINE;
+		}
+	}
+
+	/// Function for converting a TIME to whole milliseconds.
+	static uint64_t time_to_milliseconds(TIME time) {
+		double seconds = time_to_seconds(time);
+		if (seconds <= 0.0) {
+			return 0;
+		}
+		return static_cast<uint64_t>(seconds * 1000.0 + 0.5);
+	}
+
+	/// Function for finding the index of a named timer, the number of timers if it does not exist.
+	size_t find(const std::string& name) const {
+		size_t index = 0;
+		while (index < timers.size() && timers[index].name != name) {
+			index++;
+		}
+		return index;
+	}
+
+	/// Function for finding the index of a named timer, adding it if it does not exist.
+	size_t find_or_add(const std::string& name) {
+		size_t index = find(name);
+		if (index != timers.size()) {
+			return index;
+		}
+		assert(timers.size() < NONE && "Too many named timers for the timer wheel.");
+		timers.push_back(timer_t{0, Status::IDLE, 0, 0, NONE, NONE, name});
+		return index;
+	}
+
+	/// Function for adding a pending timer to the slot matching its deadline.
+	void link(size_t index) {
+		timer_t& timer = timers[index];
+		uint64_t difference = timer.deadline ^ now;
+		unsigned level = 0;
+		while (level + 1 < LEVELS && (difference >> (SLOT_BITS * (level + 1))) != 0) {
+			level++;
+		}
+		timer.level = level;
+		timer.slot = (timer.deadline >> (SLOT_BITS * level)) & (SLOTS - 1);
+		timer.prev = NONE;
+		timer.next = wheel->slots[level][timer.slot];
+		if (timer.next != NONE) {
+			timers[timer.next].prev = static_cast<index_t>(index);
+		}
+		wheel->slots[level][timer.slot] = static_cast<index_t>(index);
+		wheel->occupied[level] |= (uint64_t(1) << timer.slot);
+	}
+
+	/// Function for removing a pending timer from its slot.
+	void unlink(size_t index) {
+		timer_t& timer = timers[index];
+		if (timer.status != Status::PENDING) {
+			return;
+		}
+		if (timer.prev != NONE) {
+			timers[timer.prev].next = timer.next;
+		} else {
+			wheel->slots[timer.level][timer.slot] = timer.next;
+		}
+		if (timer.next != NONE) {
+			timers[timer.next].prev = timer.prev;
+		}
+		if (wheel->slots[timer.level][timer.slot] == NONE) {
+			wheel->occupied[timer.level] &= ~(uint64_t(1) << timer.slot);
+		}
+		timer.prev = NONE;
+		timer.next = NONE;
+	}
+
+	/// Function for finding the earliest deadline of the pending timers.
+	bool next_deadline(uint64_t& deadline) const {
+		for (unsigned level = 0; level < LEVELS; level++) {
+			if (wheel->occupied[level] == 0) {
+				continue;
+			}
+			// Every deadline in a lower level is before every deadline in a higher level,
+			// so the first occupied slot of the lowest occupied level holds the earliest deadline.
+			unsigned slot = lowest_bit(wheel->occupied[level]);
+			deadline = std::numeric_limits<uint64_t>::max();
+			for (size_t index = wheel->slots[level][slot]; index != NONE; index = timers[index].next) {
+				if (timers[index].deadline < deadline) {
+					deadline = timers[index].deadline;
+				}
+			}
+			return true;
+		}
+		return false;
+	}
+
+	/// Function for moving the timers in the current slot of each higher level down to lower levels.
+	void cascade() {
+		for (unsigned level = LEVELS - 1; level > 0; level--) {
+			unsigned slot = (now >> (SLOT_BITS * level)) & (SLOTS - 1);
+			size_t index = wheel->slots[level][slot];
+			wheel->slots[level][slot] = NONE;
+			wheel->occupied[level] &= ~(uint64_t(1) << slot);
+			while (index != NONE) {
+				size_t next = timers[index].next;
+				link(index);
+				index = next;
+			}
+		}
+	}
+
+	/// Function for expiring the timers in the current slot of the lowest level.
+	void expire_slot() {
+		unsigned slot = now & (SLOTS - 1);
+		size_t index = wheel->slots[0][slot];
+		wheel->slots[0][slot] = NONE;
+		wheel->occupied[0] &= ~(uint64_t(1) << slot);
+		while (index != NONE) {
+			size_t next = timers[index].next;
+			timers[index].status = Status::EXPIRED;
+			timers[index].prev = NONE;
+			timers[index].next = NONE;
+			index = next;
+		}
+	}
+
+	/// Function for finding the index of the lowest set bit of a non-zero bitmap.
+	static unsigned lowest_bit(uint64_t bitmap) {
+		#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned>(__builtin_ctzll(bitmap));
+		#else
+		unsigned bit = 0;
+		while ((bitmap & 1) == 0) {
+			bitmap >>= 1;
+			bit++;
+		}
+		return bit;
+		#endif
+	}
+};
+
+#endif // TIMER_WHEEL_HPP
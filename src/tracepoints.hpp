@@ -0,0 +1,69 @@
+/**
+ * 	\file		tracepoints.hpp
+ *	\brief		Definition of the static tracepoints of the Supervisor.
+ *	\details	This header file defines the USDT probes placed in the transitions, outputs and time advances
+				of the models and where packets are received and sent. The probes are in the "supervisor"
+				provider and can be listed with "bpftrace -l 'usdt:./supervisor:supervisor:*'".
+ */
+
+#ifndef TRACEPOINTS_HPP
+#define TRACEPOINTS_HPP
+
+/**
+ *	The probes use the SystemTap SDT header where it exists, and can be left out with SUPERVISOR_NO_TRACEPOINTS.
+ *	Each probe is a single nop in the code and a note in the binary. Its arguments are only evaluated while a
+ *	tracer is attached, which the tracer signals by raising the semaphore of the probe, so a probe costs a load
+ *	and a branch that is never taken while nobody is tracing. Without the header the probes compile to nothing.
+ */
+#if defined(__linux__) && defined(__has_include) && !defined(SUPERVISOR_NO_TRACEPOINTS)
+#if __has_include(<sys/sdt.h>)
+#define SUPERVISOR_TRACEPOINTS 1
+#endif
+#endif
+
+#ifdef SUPERVISOR_TRACEPOINTS
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+/// Declares the semaphore of a probe, shared by every translation unit that includes this header.
+#define SUPERVISOR_TRACE_SEMAPHORE(name) \
+	inline unsigned short supervisor_##name##_semaphore __attribute__((unused, section(".probes"))) = 0
+
+/// True while a tracer is attached to a probe.
+#define SUPERVISOR_TRACE_ENABLED(name) \
+	__builtin_expect(*(volatile unsigned short *)&supervisor_##name##_semaphore != 0, 0)
+
+/// Fires a probe, evaluating its arguments only while a tracer is attached to it.
+#define SUPERVISOR_TRACE(name, ...) \
+	do { \
+		if (SUPERVISOR_TRACE_ENABLED(name)) { \
+			STAP_PROBEV(supervisor, name, __VA_ARGS__); \
+		} \
+	} while (0)
+
+#else
+
+#define SUPERVISOR_TRACE_SEMAPHORE(name) static_assert(true, "")
+#define SUPERVISOR_TRACE_ENABLED(name) false
+#define SUPERVISOR_TRACE(name, ...) do {} while (0)
+
+#endif // SUPERVISOR_TRACEPOINTS
+
+/**
+ *	Probes of the Supervisor and their arguments.
+ *	\param	transition_start	const char * model, int transition (0 internal, 1 external, 2 confluence), int state before the transition.
+ *	\param	transition_done		const char * model, int transition, int state after the transition.
+ *	\param	output				const char * model, int state, uint64_t messages in the output bags.
+ *	\param	time_advance		const char * model, int state, int64_t time advance in microseconds (-1 if passive).
+ *	\param	packet_receive		int bytes received, int component ID, int signal ID.
+ *	\param	packet_send			const char * transport ("udp" or "rudp"), uint64_t bytes of the packet, int 1 if sending failed.
+ */
+SUPERVISOR_TRACE_SEMAPHORE(transition_start);
+SUPERVISOR_TRACE_SEMAPHORE(transition_done);
+SUPERVISOR_TRACE_SEMAPHORE(output);
+SUPERVISOR_TRACE_SEMAPHORE(time_advance);
+SUPERVISOR_TRACE_SEMAPHORE(packet_receive);
+SUPERVISOR_TRACE_SEMAPHORE(packet_send);
+
+#endif // TRACEPOINTS_HPP
@@ -0,0 +1,94 @@
+/**
+ * 	\file		velocity_profile.hpp
+ *	\brief		Definition of the trapezoidal velocity profile.
+ *	\details	This header file defines a trapezoidal velocity profile used to schedule the velocity of
+				the aircraft while it repositions to a landing point. The profile accelerates from the
+				current velocity, cruises at the maximum velocity and decelerates before the landing point.
+ */
+
+#ifndef VELOCITY_PROFILE_HPP
+#define VELOCITY_PROFILE_HPP
+
+// System Libraries
+#include <algorithm>
+#include <cmath>
+
+/**
+ * 	\class		Velocity_Profile
+ *	\brief		Definition of the trapezoidal velocity profile.
+ *	\details	This class precomputes the peak velocity of a reposition of a given distance. Short
+				repositions that cannot reach the maximum velocity use a triangular profile. The planned velocity is looked up from the distance
+				remaining to the landing point, so progress is tracked from the aircraft state rather than
+				from the time since the reposition started.
+ */
+class Velocity_Profile {
+public:
+	/// Default constructor for an empty profile that plans the minimum velocity.
+	Velocity_Profile() : Velocity_Profile(0.0f, 0.0f, 0.0f, 0.0f, 0.0f) {}
+
+	/**
+	 * \brief 	Constructor for the profile of a reposition.
+	 * \param	i_distance			float horizontal distance to the landing point in meters.
+	 * \param	i_initial_velocity	float velocity of the aircraft at the start of the reposition in m/s.
+	 * \param	i_min_velocity		float lowest velocity that will be planned in m/s.
+	 * \param	i_max_velocity		float highest velocity that will be planned in m/s.
+	 * \param	i_acceleration		float acceleration and deceleration of the aircraft in m/s^2.
+	 */
+	Velocity_Profile(float i_distance, float i_initial_velocity, float i_min_velocity, float i_max_velocity, float i_acceleration) {
+		distance = std::max(i_distance, 0.0f);
+		min_velocity = i_min_velocity;
+		max_velocity = std::max(i_max_velocity, i_min_velocity);
+		initial_velocity = std::clamp(i_initial_velocity, min_velocity, max_velocity);
+		acceleration = i_acceleration;
+
+		peak_velocity = max_velocity;
+		if (acceleration <= 0.0f) {
+			return;
+		}
+
+		// Distances needed to accelerate from the initial velocity to the maximum velocity, and to decelerate back to a stop.
+		float accel_distance = (max_velocity * max_velocity - initial_velocity * initial_velocity) / (2.0f * acceleration);
+		float decel_distance = (max_velocity * max_velocity) / (2.0f * acceleration);
+		if (accel_distance + decel_distance > distance) {
+			// The maximum velocity cannot be reached, so the profile is a triangle peaking where the two phases meet.
+			peak_velocity = std::sqrt((2.0f * acceleration * distance + initial_velocity * initial_velocity) / 2.0f);
+			peak_velocity = std::clamp(peak_velocity, initial_velocity, max_velocity);
+		}
+	}
+
+	/**
+	 * \brief 	Function velocity is used to look up the planned velocity at a point of the reposition.
+	 * \param	remaining	float horizontal distance left to the landing point in meters.
+	 * \return	float planned velocity in m/s, between the minimum and maximum velocity.
+	 */
+	[[nodiscard]] float velocity(float remaining) const {
+		if (acceleration <= 0.0f) {
+			return peak_velocity;
+		}
+		float travelled = std::max(distance - remaining, 0.0f);
+		float accelerating = std::sqrt(initial_velocity * initial_velocity + 2.0f * acceleration * travelled);
+		float decelerating = std::sqrt(2.0f * acceleration * std::max(remaining, 0.0f));
+		return std::clamp(std::min({peak_velocity, accelerating, decelerating}), min_velocity, max_velocity);
+	}
+
+	/// @return	Highest velocity of the profile in m/s.
+	[[nodiscard]] float peak() const {
+		return peak_velocity;
+	}
+
+private:
+	/// Horizontal distance to the landing point at the start of the reposition in meters.
+	float distance;
+	/// Velocity of the aircraft at the start of the reposition in m/s.
+	float initial_velocity;
+	/// Lowest velocity that will be planned in m/s.
+	float min_velocity;
+	/// Highest velocity that will be planned in m/s.
+	float max_velocity;
+	/// Acceleration and deceleration of the aircraft in m/s^2.
+	float acceleration;
+	/// Highest velocity reached by the profile in m/s.
+	float peak_velocity;
+};
+
+#endif // VELOCITY_PROFILE_HPP
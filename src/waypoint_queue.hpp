@@ -0,0 +1,221 @@
+/**
+ * 	\file		waypoint_queue.hpp
+ *	\brief		Definition of the waypoint queue.
+ *	\details	This header file defines an indexed queue of the waypoints that make up the active route.
+				Waypoints are addressed by their index in the route so that the mission manager can
+				replace or skip a waypoint without the rest of the route being resent.
+ */
+
+#ifndef WAYPOINT_QUEUE_HPP
+#define WAYPOINT_QUEUE_HPP
+
+// Messages structures
+#include "message_structures/message_fcc_command_t.hpp"
+
+// System Libraries
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * 	\class		Waypoint_Queue
+ *	\brief		Definition of the waypoint queue.
+ *	\details	This class stores the route in a vector indexed by the waypoint index, with the pending
+				waypoints threaded through it in a doubly linked list. Adding, replacing and skipping a
+				waypoint are O(1), and the next waypoints are read by following the list from the active
+				waypoint. Restoring a skipped waypoint searches back for the previous pending waypoint.
+ */
+class Waypoint_Queue {
+public:
+	/// Index used to mark the end of the list or a missing waypoint.
+	static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+	/**
+	 *	\struct	entry_t
+	 * 	\brief 	Definition of a pending waypoint read from the queue.
+	 * 	\param 	index		Index of the waypoint in the route.
+	 *	\param	revision	Number of times the waypoint has been set, used to detect replaced waypoints.
+	 *	\param	waypoint	Command sent to the FCC for the waypoint.
+	 */
+	struct entry_t {
+		size_t index;
+		unsigned long revision;
+		message_fcc_command_t waypoint;
+	};
+
+	/// Default constructor for the queue.
+	Waypoint_Queue() {
+		clear();
+	}
+
+	/// Function for removing every waypoint from the route.
+	void clear() {
+		waypoints.clear();
+		head = NONE;
+		tail = NONE;
+		passed = 0;
+		pending = 0;
+	}
+
+	/**
+	 *	\brief 		Function set is used to add a waypoint to the end of the route or replace an existing waypoint.
+	 *	\details	A skipped waypoint that is replaced is restored to the route. Waypoints that have
+	 * 				already been passed cannot be replaced.
+	 * 	\param		index		size_t index of the waypoint in the route, equal to size() to add a waypoint.
+	 * 	\param		waypoint	message_fcc_command_t command sent to the FCC for the waypoint.
+	 * 	\return		true if the route was changed, false if the index is out of range.
+	 */
+	bool set(size_t index, const message_fcc_command_t& waypoint) {
+		if (index < passed || index > waypoints.size()) {
+			return false;
+		}
+		if (index == waypoints.size()) {
+			waypoints.push_back(node_t{waypoint, 0, Status::SKIPPED, NONE, NONE});
+			link_after(index, tail);
+			return true;
+		}
+
+		node_t& node = waypoints[index];
+		node.waypoint = waypoint;
+		node.revision++;
+		if (node.status == Status::SKIPPED) {
+			size_t previous = index;
+			while (previous > passed && waypoints[previous - 1].status != Status::PENDING) {
+				previous--;
+			}
+			link_after(index, previous > passed ? previous - 1 : NONE);
+		}
+		return true;
+	}
+
+	/// @brief 	Function skip is used to remove a pending waypoint from the route.
+	/// @param 	index	size_t index of the waypoint in the route.
+	/// @return	true if the route was changed, false if the waypoint was not pending.
+	bool skip(size_t index) {
+		if (index >= waypoints.size() || waypoints[index].status != Status::PENDING) {
+			return false;
+		}
+		unlink(index);
+		waypoints[index].status = Status::SKIPPED;
+		return true;
+	}
+
+	/**
+	 *	\brief 		Function reached is used to mark every waypoint up to and including a waypoint as passed.
+	 *	\details	Each waypoint is only passed once, so the cost is O(1) amortized over the route.
+	 * 	\param		index	size_t index of the waypoint that was reached.
+	 * 	\return		true if the route was changed, false if the waypoint had already been passed.
+	 */
+	bool reached(size_t index) {
+		if (index < passed || index >= waypoints.size()) {
+			return false;
+		}
+		while (head != NONE && head <= index) {
+			unlink(head);
+		}
+		for (size_t i = passed; i <= index; i++) {
+			waypoints[i].status = Status::PASSED;
+		}
+		passed = index + 1;
+		return true;
+	}
+
+	/// @brief 	Function next is used to read the active waypoint and the pending waypoints after it.
+	/// @param 	count		size_t maximum number of waypoints to read.
+	/// @param 	resource	Memory resource the vector is allocated from, the default resource if not given.
+	/// @return	Vector of up to count pending waypoints in route order, starting with the active waypoint.
+	[[nodiscard]] std::pmr::vector<entry_t> next(size_t count, std::pmr::memory_resource * resource = std::pmr::get_default_resource()) const {
+		std::pmr::vector<entry_t> entries(resource);
+		entries.reserve(count < pending ? count : pending);
+		for (size_t index = head; index != NONE && entries.size() < count; index = waypoints[index].next) {
+			entries.push_back(entry_t{index, waypoints[index].revision, waypoints[index].waypoint});
+		}
+		return entries;
+	}
+
+	/// @return	Index of the active waypoint, NONE if no waypoints are pending.
+	[[nodiscard]] size_t active() const {
+		return head;
+	}
+
+	/// @return	Number of waypoints in the route, including passed and skipped waypoints.
+	[[nodiscard]] size_t size() const {
+		return waypoints.size();
+	}
+
+	/// @return	Number of pending waypoints in the route.
+	[[nodiscard]] size_t size_pending() const {
+		return pending;
+	}
+
+private:
+	/// Status of a waypoint in the route.
+	enum class Status {PENDING, SKIPPED, PASSED};
+
+	/**
+	 *	\struct	node_t
+	 * 	\brief 	Definition of a waypoint stored in the route.
+	 * 	\param 	waypoint	Command sent to the FCC for the waypoint.
+	 *	\param	revision	Number of times the waypoint has been replaced.
+	 *	\param	status		Whether the waypoint is pending, skipped or passed.
+	 *	\param	prev		Index of the previous pending waypoint.
+	 *	\param	next		Index of the next pending waypoint.
+	 */
+	struct node_t {
+		message_fcc_command_t waypoint;
+		unsigned long revision;
+		Status status;
+		size_t prev;
+		size_t next;
+	};
+
+	/// Waypoints of the route indexed by their position in the route.
+	std::vector<node_t> waypoints;
+	/// Index of the active waypoint.
+	size_t head;
+	/// Index of the last pending waypoint.
+	size_t tail;
+	/// Number of waypoints at the start of the route that have been passed.
+	size_t passed;
+	/// Number of pending waypoints.
+	size_t pending;
+
+	/// Function for adding a waypoint to the pending list after another pending waypoint, or at the front if previous is NONE.
+	void link_after(size_t index, size_t previous) {
+		node_t& node = waypoints[index];
+		node.status = Status::PENDING;
+		node.prev = previous;
+		node.next = (previous == NONE) ? head : waypoints[previous].next;
+		if (node.prev != NONE) {
+			waypoints[node.prev].next = index;
+		} else {
+			head = index;
+		}
+		if (node.next != NONE) {
+			waypoints[node.next].prev = index;
+		} else {
+			tail = index;
+		}
+		pending++;
+	}
+
+	/// Function for removing a waypoint from the pending list.
+	void unlink(size_t index) {
+		node_t& node = waypoints[index];
+		if (node.prev != NONE) {
+			waypoints[node.prev].next = node.next;
+		} else {
+			head = node.next;
+		}
+		if (node.next != NONE) {
+			waypoints[node.next].prev = node.prev;
+		} else {
+			tail = node.prev;
+		}
+		node.prev = NONE;
+		node.next = NONE;
+		pending--;
+	}
+};
+
+#endif // WAYPOINT_QUEUE_HPP
@@ -28,6 +28,7 @@ class Cache_Input_LP : public Cache_Input<message_landing_point_t, T> {
 public:
     Cache_Input_LP() = default;
     explicit Cache_Input_LP(message_landing_point_t initial_lp) : Cache_Input<message_landing_point_t, T>(initial_lp){}
+    Cache_Input_LP(message_landing_point_t initial_lp, T stale_time) : Cache_Input<message_landing_point_t, T>(initial_lp, stale_time){}
 };
 
 int main() {
@@ -41,6 +42,7 @@ int main() {
 		string input_dir = i_base_dir + to_string(test_set_enumeration);
 		string input_file_new_input = input_dir + string("/new_input.txt");
 		string input_file_get_input = input_dir + string("/get_input.txt");
+		string input_file_get_changed = input_dir + string("/get_changed.txt");
 
 		// Output locations
 		string out_directory = o_base_dir + to_string(test_set_enumeration);
@@ -49,7 +51,8 @@ int main() {
 		string out_info_file = out_directory + string("/output_info.txt");
 
 		if (!boost::filesystem::exists(input_file_new_input) ||
-			!boost::filesystem::exists(input_file_get_input)
+			!boost::filesystem::exists(input_file_get_input) ||
+			!boost::filesystem::exists(input_file_get_changed)
 		) {
 			printf("One of the input files do not exist\n");
 			return 1;
@@ -59,7 +62,7 @@ int main() {
 		boost::filesystem::create_directories(out_directory.c_str()); // Creates if it does not exist. Does nothing if it does.
 
 		// Instantiate the atomic model to test
-		std::shared_ptr<cadmium::dynamic::modeling::model> cache_input = cadmium::dynamic::translate::make_dynamic_atomic_model<Cache_Input_LP, TIME, message_landing_point_t>("cache_input", message_landing_point_t(0, 10, 45.0, -75.0, 100.0, 5.0));
+		std::shared_ptr<cadmium::dynamic::modeling::model> cache_input = cadmium::dynamic::translate::make_dynamic_atomic_model<Cache_Input_LP, TIME, message_landing_point_t, TIME>("cache_input", message_landing_point_t(0, 10, 45.0, -75.0, 100.0, 5.0), TIME("00:00:30:000"));
 
 		// Instantiate the input readers.
 		// One for each input
@@ -67,13 +70,16 @@ int main() {
 			cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Mavlink_Mission_Item, TIME, const char* >("ir_new_input", input_file_new_input.c_str());
 		std::shared_ptr<cadmium::dynamic::modeling::model> ir_get_input =
 			cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Boolean, TIME, const char* >("ir_get_input", input_file_get_input.c_str());
+		std::shared_ptr<cadmium::dynamic::modeling::model> ir_get_changed =
+			cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Int, TIME, const char* >("ir_get_changed", input_file_get_changed.c_str());
 
 		// The models to be included in this coupled model
 		// (accepts atomic and coupled models)
 	 	cadmium::dynamic::modeling::Models submodels_TestDriver = {
 			cache_input,
 			ir_new_input,
-			ir_get_input
+			ir_get_input,
+			ir_get_changed
 		};
 
 	 	cadmium::dynamic::modeling::Ports iports_TestDriver = { };
@@ -88,7 +94,8 @@ int main() {
 		// This will connect our outputs from our input reader to the file
 	 	cadmium::dynamic::modeling::ICs ics_TestDriver = {
 			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_landing_point_t>::out, Cache_Input<message_landing_point_t, TIME>::defs::i_new_input>("ir_new_input", "cache_input"),
-			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<bool>::out, Cache_Input<message_landing_point_t, TIME>::defs::i_get_input>("ir_get_input", "cache_input")
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<bool>::out, Cache_Input<message_landing_point_t, TIME>::defs::i_get_input>("ir_get_input", "cache_input"),
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<int>::out, Cache_Input<message_landing_point_t, TIME>::defs::i_get_changed>("ir_get_changed", "cache_input")
 		};
 
 		std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> test_driver = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
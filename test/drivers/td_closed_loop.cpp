@@ -0,0 +1,272 @@
+//C++ headers
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+//Cadmium Simulator headers
+#include <cadmium/modeling/ports.hpp>
+#include <cadmium/modeling/message_bag.hpp>
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+//Time class header
+#include <NDTime.hpp>
+
+//Messages structures
+#include "../../src/message_structures/message_aircraft_state_t.hpp"
+#include "../../src/message_structures/message_landing_point_t.hpp"
+#include "../../src/message_structures/message_fcc_command_t.hpp"
+#include "../../src/message_structures/message_start_supervisor_t.hpp"
+
+// Project information headers this is created by cmake at generation time!!!!
+#include "../../src/SupervisorConfig.hpp"
+#include "../../src/input_readers.hpp" // Input Reader Definitions.
+
+//Coupled model headers
+#include "../../src/coupled_models/Closed_Loop.hpp"
+
+using namespace cadmium;
+using namespace cadmium::basic_models::pdevs;
+
+using hclock = std::chrono::high_resolution_clock;
+using TIME = NDTime;
+
+/// Longest a mission is flown for before it is judged to have failed.
+const char * MISSION_TIME_LIMIT = "00:30:00:000";
+
+/**
+ *	\struct	mission_outcome_t
+ * 	\brief 	Definition of what the closed loop did by the end of a mission.
+ * 	\param 	mission_complete	Whether the Supervisor declared the mission complete.
+ * 	\param 	pilot_notified		Whether the Supervisor asked the pilot to take control.
+ * 	\param 	aircraft_state		Last aircraft state fed back to the Supervisor.
+ */
+struct mission_outcome_t {
+	bool mission_complete = false;
+	bool pilot_notified = false;
+	message_aircraft_state_t aircraft_state;
+};
+
+/**
+ * 	\class		Outcome_Recorder
+ *	\brief		Atomic model recording the outputs of the closed loop into an outcome read after the simulation.
+ */
+template<typename TIME>
+class Outcome_Recorder {
+public:
+	struct defs {
+		struct i_aircraft_state : public cadmium::in_port<message_aircraft_state_t> {};
+		struct i_mission_complete : public cadmium::in_port<bool> {};
+		struct i_notify_pilot : public cadmium::in_port<bool> {};
+	};
+
+	using input_ports = std::tuple<typename defs::i_aircraft_state, typename defs::i_mission_complete, typename defs::i_notify_pilot>;
+	using output_ports = std::tuple<>;
+
+	struct state_type {
+		bool recorded;
+	} state;
+
+	Outcome_Recorder() : Outcome_Recorder(std::make_shared<mission_outcome_t>()) {}
+
+	explicit Outcome_Recorder(std::shared_ptr<mission_outcome_t> i_outcome) : outcome(std::move(i_outcome)) {
+		state.recorded = false;
+	}
+
+	void internal_transition() {}
+
+	void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		for (const message_aircraft_state_t& aircraft_state : cadmium::get_messages<typename defs::i_aircraft_state>(mbs)) {
+			outcome->aircraft_state = aircraft_state;
+		}
+		for (bool mission_complete : cadmium::get_messages<typename defs::i_mission_complete>(mbs)) {
+			outcome->mission_complete |= mission_complete;
+		}
+		for (bool notify_pilot : cadmium::get_messages<typename defs::i_notify_pilot>(mbs)) {
+			outcome->pilot_notified |= notify_pilot;
+		}
+		state.recorded = true;
+	}
+
+	void confluence_transition(TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		external_transition(e, std::move(mbs));
+	}
+
+	[[nodiscard]] typename cadmium::make_message_bags<output_ports>::type output() const {
+		return {};
+	}
+
+	TIME time_advance() const {
+		return std::numeric_limits<TIME>::infinity();
+	}
+
+	friend std::ostringstream& operator<<(std::ostringstream& os, const typename Outcome_Recorder<TIME>::state_type& i) {
+		os << "State: " << (i.recorded ? "RECORDED" : "WAITING");
+		return os;
+	}
+
+private:
+	/// Outcome shared with the test driver.
+	std::shared_ptr<mission_outcome_t> outcome;
+};
+
+/**
+* ==========================================================
+* MAIN METHOD
+* ==========================================================
+*/
+int main() {
+	int test_set_enumeration = 0;
+	bool passed = true;
+
+	const string i_base_dir = string(PROJECT_DIRECTORY) + string("/test/input_data/closed_loop/");
+	const string o_base_dir = string(PROJECT_DIRECTORY) + string("/test/simulation_results/closed_loop/");
+
+	do {
+		// Input Files
+		string input_dir = i_base_dir + to_string(test_set_enumeration);
+		string input_initial_state = input_dir + string("/initial_state.txt");
+		string input_expected = input_dir + string("/expected.txt");
+		string input_perception_status = input_dir + string("/perception_status.txt");
+		string input_start_supervisor = input_dir + string("/start_supervisor.txt");
+		string input_waypoint = input_dir + string("/waypoint.txt");
+		string input_LP_recv = input_dir + string("/LP_recv.txt");
+		string input_pilot_takeover = input_dir + string("/pilot_takeover.txt");
+		string input_PLP_ach = input_dir + string("/PLP_ach.txt");
+
+		// Output locations
+		string out_directory = o_base_dir + to_string(test_set_enumeration);
+		string out_messages_file = out_directory + string("/output_messages.txt");
+		string out_state_file = out_directory + string("/output_state.txt");
+
+		if (!boost::filesystem::exists(input_initial_state) ||
+			!boost::filesystem::exists(input_expected) ||
+			!boost::filesystem::exists(input_perception_status) ||
+			!boost::filesystem::exists(input_start_supervisor) ||
+			!boost::filesystem::exists(input_waypoint) ||
+			!boost::filesystem::exists(input_LP_recv) ||
+			!boost::filesystem::exists(input_pilot_takeover) ||
+			!boost::filesystem::exists(input_PLP_ach)) {
+			printf("One of the input files do not exist\n");
+			return 1;
+		}
+
+		// The aircraft starts hovering in the initial state, and the expected outcome is either "landed" or "handover".
+		message_aircraft_state_t initial_state;
+		string expected;
+		if (!(std::ifstream(input_initial_state) >> initial_state) || !(std::ifstream(input_expected) >> expected)) {
+			printf("The initial state or expected outcome could not be read\n");
+			return 1;
+		}
+
+		// Create the output location
+		boost::filesystem::create_directories(out_directory.c_str()); // Creates if it does not exist. Does nothing if it does.
+
+		// Instantiate the coupled model to test
+		Closed_Loop closed_loop_instance = Closed_Loop(initial_state);
+		shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> closed_loop = make_shared<cadmium::dynamic::modeling::coupled<TIME>>("closed_loop", closed_loop_instance.submodels, closed_loop_instance.iports, closed_loop_instance.oports, closed_loop_instance.eics, closed_loop_instance.eocs, closed_loop_instance.ics);
+
+		// Instantiate the model recording the outcome
+		auto outcome = make_shared<mission_outcome_t>();
+		shared_ptr<cadmium::dynamic::modeling::model> recorder = cadmium::dynamic::translate::make_dynamic_atomic_model<Outcome_Recorder, TIME, std::shared_ptr<mission_outcome_t>>("recorder", std::shared_ptr<mission_outcome_t>(outcome));
+
+		// Instantiate the input readers.
+		// One for each input
+		shared_ptr<cadmium::dynamic::modeling::model> ir_perception_status = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Boolean, TIME, const char* >("ir_perception_status", input_perception_status.c_str());
+		shared_ptr<cadmium::dynamic::modeling::model> ir_start_supervisor = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Start_Supervisor, TIME, const char* >("ir_start_supervisor", input_start_supervisor.c_str());
+		shared_ptr<cadmium::dynamic::modeling::model> ir_waypoint = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Fcc_Command, TIME, const char* >("ir_waypoint", input_waypoint.c_str());
+		shared_ptr<cadmium::dynamic::modeling::model> ir_LP_recv = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Mavlink_Mission_Item, TIME, const char* >("ir_LP_recv", input_LP_recv.c_str());
+		shared_ptr<cadmium::dynamic::modeling::model> ir_pilot_takeover = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Boolean, TIME, const char* >("ir_pilot_takeover", input_pilot_takeover.c_str());
+		shared_ptr<cadmium::dynamic::modeling::model> ir_PLP_ach = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Mavlink_Mission_Item, TIME, const char* >("ir_PLP_ach", input_PLP_ach.c_str());
+
+		// The models to be included in this coupled model
+		// (accepts atomic and coupled models)
+	 	cadmium::dynamic::modeling::Models submodels_TestDriver = {
+				closed_loop,
+				recorder,
+				ir_perception_status,
+				ir_start_supervisor,
+				ir_waypoint,
+				ir_LP_recv,
+				ir_pilot_takeover,
+				ir_PLP_ach
+		};
+
+	 	cadmium::dynamic::modeling::Ports iports_TestDriver = { };
+
+	 	cadmium::dynamic::modeling::Ports oports_TestDriver = { };
+
+	 	cadmium::dynamic::modeling::EICs eics_TestDriver = {	};
+
+		// The output ports will be used to export in logging
+	 	cadmium::dynamic::modeling::EOCs eocs_TestDriver = { };
+
+		// This will connect our outputs from our input reader to the file
+	 	cadmium::dynamic::modeling::ICs ics_TestDriver = {
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<bool>::out, Closed_Loop::defs::i_perception_status>("ir_perception_status", "closed_loop"),
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_start_supervisor_t>::out, Closed_Loop::defs::i_start_supervisor>("ir_start_supervisor", "closed_loop"),
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_fcc_command_t>::out, Closed_Loop::defs::i_waypoint>("ir_waypoint", "closed_loop"),
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_landing_point_t>::out, Closed_Loop::defs::i_LP_recv>("ir_LP_recv", "closed_loop"),
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<bool>::out, Closed_Loop::defs::i_pilot_takeover>("ir_pilot_takeover", "closed_loop"),
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_landing_point_t>::out, Closed_Loop::defs::i_PLP_ach>("ir_PLP_ach", "closed_loop"),
+
+			cadmium::dynamic::translate::make_IC<Closed_Loop::defs::o_aircraft_state, Outcome_Recorder<TIME>::defs::i_aircraft_state>("closed_loop", "recorder"),
+			cadmium::dynamic::translate::make_IC<Closed_Loop::defs::o_mission_complete, Outcome_Recorder<TIME>::defs::i_mission_complete>("closed_loop", "recorder"),
+			cadmium::dynamic::translate::make_IC<Closed_Loop::defs::o_notify_pilot, Outcome_Recorder<TIME>::defs::i_notify_pilot>("closed_loop", "recorder")
+		};
+
+		shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> test_driver = make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+			"test_driver", submodels_TestDriver, iports_TestDriver, oports_TestDriver, eics_TestDriver, eocs_TestDriver, ics_TestDriver
+		);
+
+		/*************** Loggers *******************/
+        static ofstream out_messages;
+        static ofstream out_state;
+
+		out_messages = ofstream(out_messages_file);
+		struct oss_sink_messages {
+			static ostream& sink() {
+				return out_messages;
+			}
+		};
+
+		out_state = ofstream(out_state_file);
+		struct oss_sink_state {
+			static ostream& sink() {
+				return out_state;
+			}
+		};
+
+		using state = cadmium::logger::logger<cadmium::logger::logger_state, cadmium::dynamic::logger::formatter<TIME>, oss_sink_state>;
+		using log_messages = cadmium::logger::logger<cadmium::logger::logger_messages, cadmium::dynamic::logger::formatter<TIME>, oss_sink_messages>;
+		using global_time_mes = cadmium::logger::logger<cadmium::logger::logger_global_time, cadmium::dynamic::logger::formatter<TIME>, oss_sink_messages>;
+		using global_time_sta = cadmium::logger::logger<cadmium::logger::logger_global_time, cadmium::dynamic::logger::formatter<TIME>, oss_sink_state>;
+
+		using logger_closed_loop = cadmium::logger::multilogger<state, log_messages, global_time_mes, global_time_sta>;
+
+		auto start = hclock::now(); //to measure simulation execution time
+
+		// The emulator keeps streaming the aircraft state while the Supervisor asks it to, so the mission is bounded.
+		cadmium::dynamic::engine::runner<NDTime, logger_closed_loop> r(test_driver, { 0 });
+		TIME end = r.run_until(TIME(MISSION_TIME_LIMIT));
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::duration<double, std::ratio<1>>>(hclock::now() - start).count();
+
+		bool landed = outcome->mission_complete && !outcome->pilot_notified;
+		bool handover = outcome->pilot_notified && !outcome->mission_complete;
+		bool test_passed = (expected == "landed") ? landed : (expected == "handover") ? handover : false;
+		passed &= test_passed;
+		cout << "Test set " << test_set_enumeration << (test_passed ? " passed" : " failed") << ": expected " << expected
+			 << ", mission complete " << outcome->mission_complete << ", pilot notified " << outcome->pilot_notified
+			 << ", last aircraft state {" << outcome->aircraft_state << "} at " << end
+			 << ", simulation took " << elapsed << " seconds" << endl;
+
+		test_set_enumeration++;
+	} while (boost::filesystem::exists(i_base_dir + std::to_string(test_set_enumeration)));
+
+	return passed ? 0 : 1;
+}
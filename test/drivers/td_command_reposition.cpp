@@ -30,6 +30,7 @@ int main() {
 		string input_file_initial_state			= input_dir + string("/initial_state.txt");
 		string input_file_aircraft_state		= input_dir + string("/aircraft_state.txt");
 		string input_file_hover_criteria_met	= input_dir + string("/hover_criteria_met.txt");
+		string input_file_lp_ranking			= input_dir + string("/lp_ranking.txt");
 		string input_file_pilot_handover		= input_dir + string("/pilot_handover.txt");
 		string input_file_pilot_takeover		= input_dir + string("/pilot_takeover.txt");
 		string input_file_request_reposition	= input_dir + string("/request_reposition.txt");
@@ -43,6 +44,7 @@ int main() {
 		if (!boost::filesystem::exists(input_file_initial_state) ||
 			!boost::filesystem::exists(input_file_aircraft_state) ||
 			!boost::filesystem::exists(input_file_hover_criteria_met) ||
+			!boost::filesystem::exists(input_file_lp_ranking) ||
 			!boost::filesystem::exists(input_file_pilot_handover) ||
 			!boost::filesystem::exists(input_file_pilot_takeover) ||
 			!boost::filesystem::exists(input_file_request_reposition) ||
@@ -76,6 +78,8 @@ int main() {
 			cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Aircraft_State, TIME, const char* >("ir_aircraft_state", input_file_aircraft_state.c_str());
 		shared_ptr<cadmium::dynamic::modeling::model> ir_hover_criteria_met =
 			cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Boolean, TIME, const char* >("ir_hover_criteria_met", input_file_hover_criteria_met.c_str());
+		shared_ptr<cadmium::dynamic::modeling::model> ir_lp_ranking =
+			cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Mavlink_Mission_Item, TIME, const char* >("ir_lp_ranking", input_file_lp_ranking.c_str());
 		shared_ptr<cadmium::dynamic::modeling::model> ir_pilot_handover =
 			cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Mavlink_Mission_Item, TIME, const char* >("ir_pilot_handover", input_file_pilot_handover.c_str());
 		shared_ptr<cadmium::dynamic::modeling::model> ir_pilot_takeover =
@@ -90,6 +94,7 @@ int main() {
 		cadmium::dynamic::modeling::Models submodels_TestDriver = {
 			ir_aircraft_state,
 			ir_hover_criteria_met,
+			ir_lp_ranking,
 			ir_pilot_handover,
 			ir_pilot_takeover,
 			ir_request_reposition,
@@ -110,6 +115,7 @@ int main() {
 		cadmium::dynamic::modeling::ICs ics_TestDriver = {
 			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_aircraft_state_t>::out,Command_Reposition<TIME>::defs::i_aircraft_state>("ir_aircraft_state", "command_reposition"),
 			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<bool>::out,Command_Reposition<TIME>::defs::i_hover_criteria_met>("ir_hover_criteria_met", "command_reposition"),
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_landing_point_t>::out,Command_Reposition<TIME>::defs::i_lp_ranking>("ir_lp_ranking", "command_reposition"),
 			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_landing_point_t>::out,Command_Reposition<TIME>::defs::i_pilot_handover>("ir_pilot_handover", "command_reposition"),
 			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<bool>::out,Command_Reposition<TIME>::defs::i_pilot_takeover>("ir_pilot_takeover", "command_reposition"),
 			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_landing_point_t>::out,Command_Reposition<TIME>::defs::i_request_reposition>("ir_request_reposition", "command_reposition"),
@@ -0,0 +1,85 @@
+//C++ headers
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+// Project information headers this is created by cmake at generation time!!!!
+#include "../../src/SupervisorConfig.hpp"
+
+//Utility headers
+#include "../../src/fleet_config.hpp"
+
+/// Checks a condition of a test set, printing the failure to the console.
+bool check(bool condition, int test_set, const std::string& description) {
+	if (!condition) {
+		std::cout << "Test set " << test_set << " failed: " << description << std::endl;
+	}
+	return condition;
+}
+
+/// Writes a vehicle in the form used by the expected results.
+std::string to_string(const vehicle_config_t& vehicle) {
+	return vehicle.name + " " + std::to_string(vehicle.port_offset) + " " +
+		   ((vehicle.state_source == State_Source_E::SHARED_MEMORY) ? "shared_memory" :
+			(vehicle.state_source == State_Source_E::EMULATOR) ? "emulator" : "feed");
+}
+
+/**
+* ==========================================================
+* MAIN METHOD
+* ==========================================================
+*/
+int main() {
+	int test_set_enumeration = 0;
+	bool passed = true;
+
+	const std::string i_base_dir = std::string(PROJECT_DIRECTORY) + std::string("/test/input_data/fleet_config/");
+
+	do {
+		// Input Files
+		std::string input_dir = i_base_dir + std::to_string(test_set_enumeration);
+		std::string input_file_fleet = input_dir + std::string("/fleet.txt");
+		std::string input_file_expected = input_dir + std::string("/expected.txt");
+
+		// The fleet file is left out of the test sets where it is missing on purpose.
+		if (!boost::filesystem::exists(input_file_expected)) {
+			printf("One of the input files do not exist\n");
+			return 1;
+		}
+
+		std::vector<std::string> expected;
+		std::ifstream expected_file(input_file_expected);
+		for (std::string line; std::getline(expected_file, line);) {
+			expected.push_back(line);
+		}
+		bool expect_error = !expected.empty() && expected[0].rfind("error ", 0) == 0;
+
+		try {
+			std::vector<vehicle_config_t> vehicles = read_fleet_config(input_file_fleet);
+			passed &= check(!expect_error, test_set_enumeration, "the configuration was read instead of failing with: " + (expect_error ? expected[0].substr(6) : ""));
+			if (!expect_error) {
+				std::vector<std::string> read;
+				for (const vehicle_config_t& vehicle : vehicles) {
+					read.push_back(to_string(vehicle));
+				}
+				passed &= check(read == expected, test_set_enumeration, "the vehicles read are not the expected vehicles");
+			}
+		} catch (const std::runtime_error& error) {
+			std::string message = error.what();
+			passed &= check(expect_error, test_set_enumeration, "the configuration failed with: " + message);
+			if (expect_error) {
+				passed &= check(message.rfind(expected[0].substr(6), 0) == 0, test_set_enumeration,
+					"the configuration failed with: " + message + " instead of: " + expected[0].substr(6));
+			}
+		}
+
+		test_set_enumeration++;
+	} while (boost::filesystem::exists(i_base_dir + std::to_string(test_set_enumeration)));
+
+	std::cout << (passed ? "All fleet configuration tests passed" : "Some fleet configuration tests failed") << std::endl;
+	return passed ? 0 : 1;
+}
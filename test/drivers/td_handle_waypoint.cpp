@@ -18,6 +18,7 @@
 using TIME = NDTime;
 
 struct o_fcc_waypoint_update : public cadmium::out_port<message_fcc_command_t> {};
+struct o_update_boss : public cadmium::out_port<shared_message_t<message_boss_mission_update_t>> {};
 struct o_request_gps_time : public cadmium::out_port<bool> {};
 
 int main() {
@@ -33,6 +34,7 @@ int main() {
 		string input_file_pilot_takeover		= input_dir + std::string("/pilot_takeover.txt");
 		string input_file_start_mission			= input_dir + std::string("/start_mission.txt");
 		string input_file_waypoint				= input_dir + std::string("/waypoint.txt");
+		string input_file_waypoint_update		= input_dir + std::string("/waypoint_update.txt");
 
 		// Output locations
 		string out_directory					= o_base_dir + to_string(test_set_enumeration);
@@ -42,7 +44,8 @@ int main() {
 		if (!boost::filesystem::exists(input_file_initial_state) ||
 			!boost::filesystem::exists(input_file_pilot_takeover) ||
 			!boost::filesystem::exists(input_file_start_mission) ||
-			!boost::filesystem::exists(input_file_waypoint)) {
+			!boost::filesystem::exists(input_file_waypoint) ||
+			!boost::filesystem::exists(input_file_waypoint_update)) {
 			printf("One of the input files do not exist\n");
 			return 1;
 		}
@@ -74,6 +77,8 @@ int main() {
 				cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Int, TIME, const char* >("ir_start_mission", input_file_start_mission.c_str());
 		shared_ptr<cadmium::dynamic::modeling::model> ir_waypoint =
 				cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Fcc_Command, TIME, const char* >("ir_waypoint", input_file_waypoint.c_str());
+		shared_ptr<cadmium::dynamic::modeling::model> ir_waypoint_update =
+				cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Waypoint_Update, TIME, const char* >("ir_waypoint_update", input_file_waypoint_update.c_str());
 
 		// The models to be included in this coupled model
 		// (accepts atomic and coupled models)
@@ -81,6 +86,7 @@ int main() {
 				ir_pilot_takeover,
 				ir_start_mission,
 				ir_waypoint,
+				ir_waypoint_update,
 				handle_waypoint
 		};
 
@@ -88,21 +94,24 @@ int main() {
 
 		cadmium::dynamic::modeling::Ports oports_TestDriver = {
 				typeid(o_fcc_waypoint_update),
-				typeid(o_request_gps_time)
+				typeid(o_request_gps_time),
+				typeid(o_update_boss)
 		};
 
 		cadmium::dynamic::modeling::EICs eics_TestDriver = {	};
 
 		// The output ports will be used to export in logging
 		cadmium::dynamic::modeling::EOCs eocs_TestDriver = {
-				cadmium::dynamic::translate::make_EOC<Handle_Waypoint<TIME>::defs::o_fcc_waypoint_update,o_fcc_waypoint_update>("handle_waypoint")
+				cadmium::dynamic::translate::make_EOC<Handle_Waypoint<TIME>::defs::o_fcc_waypoint_update,o_fcc_waypoint_update>("handle_waypoint"),
+				cadmium::dynamic::translate::make_EOC<Handle_Waypoint<TIME>::defs::o_update_boss,o_update_boss>("handle_waypoint")
 		};
 
 		// This will connect our outputs from our input reader to the file
 		cadmium::dynamic::modeling::ICs ics_TestDriver = {
 				cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<bool>::out,Handle_Waypoint<TIME>::defs::i_pilot_takeover>("ir_pilot_takeover", "handle_waypoint"),
 				cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<int>::out,Handle_Waypoint<TIME>::defs::i_start_mission>("ir_start_mission", "handle_waypoint"),
-				cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_fcc_command_t>::out,Handle_Waypoint<TIME>::defs::i_waypoint>("ir_waypoint", "handle_waypoint")
+				cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_fcc_command_t>::out,Handle_Waypoint<TIME>::defs::i_waypoint>("ir_waypoint", "handle_waypoint"),
+				cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_waypoint_update_t>::out,Handle_Waypoint<TIME>::defs::i_waypoint_update>("ir_waypoint_update", "handle_waypoint")
 		};
 
 		shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> TEST_DRIVER = make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
@@ -0,0 +1,171 @@
+//C++ headers
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//Time class header
+#include <NDTime.hpp>
+
+//Atomic model headers
+#include "../../src/atomic_models/LP_Manager.hpp"
+#include "../../src/atomic_models/Mission_Initialization.hpp"
+#include "../../src/atomic_models/Reposition_Timer.hpp"
+#include "../../src/atomic_models/Stabilize.hpp"
+#include "../../src/atomic_models/Touchdown_Estimator.hpp"
+
+using hclock = std::chrono::high_resolution_clock;
+using TIME = NDTime;
+
+/// Number of models swept, from a single Supervisor up to a large fleet or parameter sweep.
+const size_t MODEL_COUNTS[] = {1000, 10000, 100000};
+/// Number of times each set of models is swept.
+const int SWEEPS = 100;
+
+/**
+ *	\brief		Counter of the cache misses of the process, read from the hardware counters.
+ *	\details	The counter is opened with perf_event_open, so it is only available on Linux when the
+				kernel exposes the hardware counters, which virtual machines often do not.
+ */
+class Cache_Miss_Counter {
+public:
+	Cache_Miss_Counter() {
+		#ifdef __linux__
+		perf_event_attr attributes;
+		std::memset(&attributes, 0, sizeof(attributes));
+		attributes.size = sizeof(attributes);
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+		#endif
+	}
+
+	~Cache_Miss_Counter() {
+		#ifdef __linux__
+		if (fd >= 0) {
+			close(fd);
+		}
+		#endif
+	}
+
+	/// @return	true if the hardware counter could be opened, false otherwise.
+	[[nodiscard]] bool available() const {
+		return fd >= 0;
+	}
+
+	/// Function for resetting and starting the counter.
+	void start() {
+		#ifdef __linux__
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+		#endif
+	}
+
+	/// @return	Number of cache misses since the counter was started.
+	uint64_t stop() {
+		uint64_t count = 0;
+		#ifdef __linux__
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+				count = 0;
+			}
+		}
+		#endif
+		return count;
+	}
+
+private:
+	/// File descriptor of the counter, negative if it is not available.
+	int fd = -1;
+};
+
+/**
+ *	\brief		Function for starting the LZ scan of a model the way the simulator runs it.
+ *	\details	The model receives the planned landing point, requests and receives the aircraft state, and
+				runs the output and internal transition of START_LZE_SCAN, which arm the orbit and scan leg
+				timers read by the time advance of LZE_SCAN.
+ */
+void start_scan(LP_Manager<TIME>& model) {
+	using input_bags = typename cadmium::make_message_bags<LP_Manager<TIME>::input_ports>::type;
+
+	input_bags plp_bags;
+	cadmium::get_messages<LP_Manager<TIME>::defs::i_plp_ach>(plp_bags).emplace_back(0, 10, 45.38331862894929, -75.69759707249413, 100.0, 45.8);
+	model.external_transition(TIME(), std::move(plp_bags));
+	model.output();
+	model.internal_transition();
+
+	input_bags state_bags;
+	cadmium::get_messages<LP_Manager<TIME>::defs::i_aircraft_state>(state_bags).emplace_back(0.0, 45.38331862894929, -75.69759707249413, 30.0f, 100.0f, 45.8f, 0.0f);
+	model.external_transition(TIME(), std::move(state_bags));
+	model.output();
+	model.internal_transition();
+}
+
+/**
+* ==========================================================
+* MAIN METHOD
+* ==========================================================
+*/
+int main() {
+	std::cout << "LP_Manager: " << sizeof(LP_Manager<TIME>) << " bytes per model" << std::endl;
+	// The other models holding a timer wheel are printed so that the size of their inline state is tracked as well.
+	std::cout << "Mission_Initialization: " << sizeof(Mission_Initialization<TIME>) << " bytes per model" << std::endl;
+	std::cout << "Reposition_Timer: " << sizeof(Reposition_Timer<TIME>) << " bytes per model" << std::endl;
+	std::cout << "Stabilize: " << sizeof(Stabilize<TIME>) << " bytes per model" << std::endl;
+	std::cout << "Touchdown_Estimator: " << sizeof(Touchdown_Estimator<TIME>) << " bytes per model" << std::endl;
+
+	Cache_Miss_Counter cache_misses;
+	if (!cache_misses.available()) {
+		std::cout << "The hardware cache counters are not available, only the time per model is measured" << std::endl;
+	}
+
+	for (size_t model_count : MODEL_COUNTS) {
+		// The models are scanning the LZ with the default timers, long enough for several scan legs,
+		// so that the time advance reads both the orbit and scan leg timers.
+		std::vector<LP_Manager<TIME>> models;
+		models.reserve(model_count);
+		for (size_t i = 0; i < model_count; i++) {
+			models.emplace_back(seconds_to_time<TIME>(LP_ACCEPT_TIMER), seconds_to_time<TIME>(ORBIT_TIMER), LP_Manager<TIME>::States::WAIT_LP_PLP);
+			start_scan(models.back());
+		}
+
+		// Each sweep asks every model for its time advance, as the simulator does when scheduling the next step.
+		size_t scanning = 0;
+		TIME next_internal = std::numeric_limits<TIME>::infinity();
+		cache_misses.start();
+		auto start = hclock::now();
+		for (int sweep = 0; sweep < SWEEPS; sweep++) {
+			for (const LP_Manager<TIME>& model : models) {
+				// The earliest time advance is kept, so the sweep is not optimised away.
+				next_internal = std::min(next_internal, model.time_advance());
+				scanning += (model.state.current_state == LP_Manager<TIME>::States::LZE_SCAN);
+			}
+		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(hclock::now() - start).count();
+		uint64_t misses = cache_misses.stop();
+
+		std::cout << "Models: " << model_count << " Sweep: " << elapsed / (static_cast<double>(model_count) * SWEEPS) << " ns per model";
+		if (cache_misses.available()) {
+			std::cout << " " << static_cast<double>(misses) / (static_cast<double>(model_count) * SWEEPS) << " cache misses per model";
+		}
+		std::cout << " (" << scanning / SWEEPS << " scanning, next event in " << next_internal << ")" << std::endl;
+	}
+
+	return 0;
+}
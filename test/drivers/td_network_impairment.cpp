@@ -0,0 +1,329 @@
+//C++ headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <iostream>
+
+//Cadmium Simulator headers
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+//Time class header
+#include <NDTime.hpp>
+
+//Messages structures
+#include "../../src/message_structures/message_landing_point_t.hpp"
+
+// Project information headers this is created by cmake at generation time!!!!
+#include "../../src/SupervisorConfig.hpp"
+#include "../../src/network_impairment.hpp"
+
+//Coupled model headers
+#include "../../src/io_models/Packet_Builder.hpp"
+#include "../../src/io_models/Perception_Load_Generator.hpp"
+#include "../../src/io_models/RUDP_Output.hpp"
+#include "../../src/io_models/Supervisor_UDP_Input.hpp"
+#include "../../src/io_models/UDP_Input.hpp"
+#include "../../src/io_models/UDP_Output.hpp"
+
+//RUDP library
+#include <RUDP/src/ConnectionController.hpp>
+
+using namespace cadmium;
+
+using hclock = std::chrono::high_resolution_clock;
+using TIME = NDTime;
+
+/// Impairment profiles each link is benchmarked under, from a clean link to the worst seen on the aircraft network.
+const impairment_profile_t PROFILES[] = {
+	{"Clean",		0.00, 0.00, 0.00,  0.0,  0.0, Jitter_Distribution_E::UNIFORM},
+	{"Lossy",		0.05, 0.00, 0.00,  0.0,  0.0, Jitter_Distribution_E::UNIFORM},
+	{"Duplicating",	0.00, 0.05, 0.00,  0.0,  0.0, Jitter_Distribution_E::UNIFORM},
+	{"Reordering",	0.00, 0.00, 0.10,  2.0,  1.0, Jitter_Distribution_E::UNIFORM},
+	{"Jittery",		0.00, 0.00, 0.00, 20.0,  5.0, Jitter_Distribution_E::NORMAL},
+	{"Congested",	0.01, 0.00, 0.00, 20.0, 10.0, Jitter_Distribution_E::PARETO},
+	{"Harsh",		0.10, 0.02, 0.05, 50.0, 20.0, Jitter_Distribution_E::PARETO}
+};
+/// Rate in Hz that landing points are sent at by the perception system.
+const double PERCEPTION_RATE_HZ = 100.0;
+/// Rate in Hz that landing points are sent at by the Supervisor to mavNRC.
+const double MAVNRC_RATE_HZ = 10.0;
+/// Rate in Hz that messages are sent at over the plain UDP link, as fast as the perception link.
+const double UDP_RATE_HZ = 100.0;
+/// Port the receivers listen on, each run uses the next port and the proxies of the perception and UDP links listen on the port after it.
+const unsigned short BASE_PORT = 23200;
+
+/// Packet builder sending landing points as they are stored, in the format read by a UDP Input.
+template<typename TIME>
+using Packet_Builder_Raw_Landing_Point = Packet_Builder<message_landing_point_t, TIME>;
+
+/// UDP Input receiving landing points.
+template<typename TIME>
+using UDP_Input_Landing_Point = UDP_Input<message_landing_point_t, TIME>;
+
+/**
+ *	\class		MavNRC_Landing_Point_Input
+ *	\brief		Stand in for the mavNRC end of the link the Supervisor sends landing points over.
+ *	\details	The model receives the packets of a Packet_Builder_Landing_Point over RUDP, as mavNRC
+				would, and forwards the landing points so that they can be matched up by the load generator.
+				The receive thread is woken to stop in the same way as the one of the Supervisor UDP Input.
+ */
+template<typename TIME>
+class MavNRC_Landing_Point_Input {
+public:
+	DEFINE_ENUM_WITH_STRING_CONVERSIONS(States,
+		(IDLE)
+		(INPUT)
+	);
+
+	struct defs {
+		struct o_lp : public cadmium::out_port<message_landing_point_t> { };
+		struct i_quit : public cadmium::in_port<bool> { };
+	};
+
+	using input_ports = std::tuple<typename defs::i_quit>;
+	using output_ports = std::tuple<typename defs::o_lp>;
+
+	struct state_type {
+		States current_state;
+		bool has_messages;
+	} state;
+
+	/**
+	 * \brief 	Constructor for the model with the rate the received landing points are polled at and the port they are received on.
+	 * \param	rate	TIME rate at which the received landing points are polled.
+	 * \param	port	unsigned short port number the RUDP connection is bound to.
+	 */
+	MavNRC_Landing_Point_Input(TIME rate, unsigned short port) : polling_rate(rate), receiver_state(std::make_shared<receiver_t>(port)) {
+		state.current_state = States::INPUT;
+		state.has_messages = false;
+		receiver.start("mavNRC Landing Point Input", [r = receiver_state] { receive_packet_thread(*r); }, true);
+	}
+
+	~MavNRC_Landing_Point_Input() {
+		receiver.stop([r = receiver_state] { r->stop(); });
+	}
+
+	/// Internal transitions of the model
+	void internal_transition() {
+		if (state.current_state == States::INPUT) {
+			std::unique_lock<std::mutex> mutexLock(receiver_state->input_mutex, std::defer_lock);
+			if (mutexLock.try_lock()) {
+				state.has_messages = !receiver_state->landing_points.empty();
+			}
+		}
+	}
+
+	/// External transitions of the model
+	void external_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		if (!cadmium::get_messages<typename defs::i_quit>(mbs).empty()) {
+			state.current_state = States::IDLE;
+			receiver.request_stop();
+			receiver_state->stop();
+		}
+	}
+
+	/// Function used to decide precedence between internal and external transitions when both are scheduled simultaneously.
+	void confluence_transition([[maybe_unused]] TIME e, typename cadmium::make_message_bags<input_ports>::type mbs) {
+		internal_transition();
+		external_transition(TIME(), std::move(mbs));
+	}
+
+	/// Function for generating output from the model before internal transitions.
+	[[nodiscard]] typename cadmium::make_message_bags<output_ports>::type output() const {
+		typename cadmium::make_message_bags<output_ports>::type bags;
+		if (state.current_state == States::INPUT) {
+			std::unique_lock<std::mutex> mutexLock(receiver_state->input_mutex, std::defer_lock);
+			if (state.has_messages && mutexLock.try_lock()) {
+				cadmium::get_messages<typename defs::o_lp>(bags) = std::move(receiver_state->landing_points);
+				receiver_state->landing_points.clear();
+			}
+		}
+		return bags;
+	}
+
+	/// Function to declare the time advance value for each state of the model.
+	TIME time_advance() const {
+		if (state.current_state == States::IDLE) {
+			return std::numeric_limits<TIME>::infinity();
+		}
+		return state.has_messages ? TIME(TA_ZERO) : polling_rate;
+	}
+
+	friend std::ostringstream& operator<<(std::ostringstream& os, const typename MavNRC_Landing_Point_Input<TIME>::state_type& i) {
+		os << "State: " << enumToString(i.current_state) << "-" << (i.has_messages ? "MESSAGES" : "NO_MESSAGES");
+		return os;
+	}
+
+private:
+	/// Everything the receive thread uses, shared with the model so that a stuck thread can be detached.
+	struct receiver_t {
+		explicit receiver_t(unsigned short port) : local_port(port) {
+			connection_number = rudp::ConnectionController::addConnection(DEFAULT_TIMEOUT_MS);
+			connection = rudp::ConnectionController::getConnection(connection_number);
+		}
+
+		~receiver_t() {
+			rudp::ConnectionController::removeConnection(connection_number);
+		}
+
+		receiver_t(const receiver_t&) = delete;
+		receiver_t& operator=(const receiver_t&) = delete;
+
+		/// Function for asking the thread to stop and waking its receive with a packet through RUDP.
+		void stop() {
+			if (stopping.exchange(true, std::memory_order_acq_rel)) {
+				return;
+			}
+			int wake_number = rudp::ConnectionController::addConnection(RUDP_WAKE_TIMEOUT_MS);
+			try {
+				rudp::Connection * wake_connection = rudp::ConnectionController::getConnection(wake_number);
+				wake_connection->setEndpointRemote(LOCALHOST, local_port);
+				wake_connection->setSendRetriesLimit(1);
+				char wake = 0;
+				wake_connection->send(&wake, sizeof(wake));
+			}
+			catch (std::runtime_error& error) {
+				std::cout << "[mavNRC Landing Point Input] (ERROR) Could not wake the receive thread: " << error.what() << std::endl;
+			}
+			rudp::ConnectionController::removeConnection(wake_number);
+		}
+
+		std::mutex input_mutex;
+		std::vector<message_landing_point_t> landing_points;
+		rudp::Connection * connection;
+		int connection_number;
+		unsigned short local_port;
+		char recv_buffer[MAX_SER_BUFFER_CHARS]{};
+		std::atomic<bool> stopping{false};
+	};
+
+	/// Function for receiving the landing point packets until the thread is stopped.
+	static void receive_packet_thread(receiver_t& r) {
+		try {
+			r.connection->setEndpointLocal(r.local_port);
+		} catch (std::runtime_error& error) {
+			std::cout << "[mavNRC Landing Point Input] (ERROR) Could not listen on port " << r.local_port << ": " << error.what() << std::endl;
+			return;
+		}
+		while (!r.stopping.load(std::memory_order_acquire)) {
+			char sender_address[IPV4_ADDRESS_LENGTH_BYTES]{};
+			int sender_port;
+			int bytes_received = r.connection->receive(r.recv_buffer, MAX_SER_BUFFER_CHARS, sender_address, &sender_port);
+			if (r.stopping.load(std::memory_order_acquire)) {
+				break;
+			}
+			// Packet_Builder_Landing_Point packets are the signal ID followed by the landing point.
+			if (bytes_received == static_cast<int>(sizeof(message_landing_point_t) + 1) && r.recv_buffer[0] == SIG_ID_LANDING_POINT) {
+				message_landing_point_t lp;
+				std::memcpy(&lp, &r.recv_buffer[1], sizeof(lp));
+				std::lock_guard<std::mutex> lock(r.input_mutex);
+				r.landing_points.push_back(lp);
+			}
+		}
+	}
+
+	/// Variable for rate at which the received landing points are polled.
+	TIME polling_rate;
+	/// Variable for the receiver shared with the receive thread.
+	std::shared_ptr<receiver_t> receiver_state;
+	/// Thread receiving the packets, declared last so that it is stopped before the members it uses are destroyed.
+	IO_Thread receiver;
+};
+
+/**
+ * \brief 	Function run_link is used to benchmark a link through the impairment proxy.
+ * \details	The landing points of the load generator are built into packets by BUILDER, sent by the sender
+ * 			through the proxy to the receiver, and fed back to the load generator to be matched up.
+ * \tparam	BUILDER		Packet builder sending the landing points in the format of the link.
+ * \tparam	SENDER		Output model sending the packets to the proxy.
+ * \tparam	RECEIVER	Input model receiving the packets from the proxy.
+ * \tparam	RECV_PORT	Output port of the receiver the landing points of the link come out of.
+ * \param	profile		impairment_profile_t impairments of the link.
+ * \param	rate_hz		double number of landing points sent each second.
+ * \param	proxy_port	unsigned short port the sender sends to and the proxy listens on.
+ * \param	target_port	unsigned short port the receiver listens on.
+ * \param	sender		Model of the sender, sending to the proxy port.
+ * \param	receiver	Model of the receiver, listening on the target port.
+ */
+template<template<typename> class BUILDER, template<typename> class SENDER, template<typename> class RECEIVER, typename RECV_PORT>
+void run_link(const impairment_profile_t& profile, double rate_hz, unsigned short proxy_port, unsigned short target_port,
+			  std::shared_ptr<cadmium::dynamic::modeling::model> sender, std::shared_ptr<cadmium::dynamic::modeling::model> receiver) {
+	Impairment_Proxy proxy(profile, proxy_port, LOCALHOST, target_port);
+
+	LP_Load_Pattern pattern(message_landing_point_t(0, 10, 45.3229263, -75.6646528, 300.0, 0.0), LP_Distribution_E::UNIFORM, 50.0f, 1);
+	std::shared_ptr<cadmium::dynamic::modeling::model> load_generator = cadmium::dynamic::translate::make_dynamic_atomic_model<Perception_Load_Generator, TIME, double, TIME, LP_Load_Pattern>("load_generator", std::move(rate_hz), TIME("00:00:05:000"), std::move(pattern));
+	std::shared_ptr<cadmium::dynamic::modeling::model> packet_builder = cadmium::dynamic::translate::make_dynamic_atomic_model<BUILDER, TIME>("packet_builder");
+
+	cadmium::dynamic::modeling::Models submodels_TestDriver = {
+		load_generator,
+		packet_builder,
+		sender,
+		receiver
+	};
+
+	// The landing points coming out of the receiver are fed back to the generator to be matched up.
+	cadmium::dynamic::modeling::ICs ics_TestDriver = {
+		cadmium::dynamic::translate::make_IC<Perception_Load_Generator<TIME>::defs::o_lp, typename BUILDER<TIME>::defs::i_data>("load_generator", "packet_builder"),
+		cadmium::dynamic::translate::make_IC<typename BUILDER<TIME>::defs::o_packet, typename SENDER<TIME>::defs::i_message>("packet_builder", "sender"),
+		cadmium::dynamic::translate::make_IC<RECV_PORT, Perception_Load_Generator<TIME>::defs::i_lp_recv>("receiver", "load_generator"),
+		cadmium::dynamic::translate::make_IC<Perception_Load_Generator<TIME>::defs::o_quit, typename RECEIVER<TIME>::defs::i_quit>("load_generator", "receiver")
+	};
+
+	std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> test_driver = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+		"test_driver", submodels_TestDriver, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics_TestDriver
+	);
+
+	// Logging is left out so that it does not slow down the link.
+	auto start = hclock::now();
+
+	cadmium::dynamic::engine::runner<NDTime, cadmium::logger::not_logger> r(test_driver, { TIME("00:00:00:000:000") });
+	r.run_until_passivate();
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::duration<double, std::ratio<1>>>(hclock::now() - start).count();
+	cout << "[Impairment Proxy] " << proxy << " Forwarded bytes: " << proxy.forwarded_bytes() << endl;
+	cout << "Simulation took: " << elapsed << " seconds" << endl;
+}
+
+/**
+* ==========================================================
+* MAIN METHOD
+* ==========================================================
+*/
+int main() {
+	unsigned short port = BASE_PORT;
+
+	for (const impairment_profile_t& profile : PROFILES) {
+		// Landing points from the perception system into the Supervisor, over RUDP.
+		cout << profile.name << " perception link" << endl;
+		unsigned short perception_proxy_port = port + 1;
+		run_link<Packet_Builder_Perception_LP, RUDP_Output, Supervisor_UDP_Input, Supervisor_UDP_Input<TIME>::defs::o_lp_recv>(profile, PERCEPTION_RATE_HZ, perception_proxy_port, port,
+			cadmium::dynamic::translate::make_dynamic_atomic_model<RUDP_Output, TIME, const char *, const unsigned short, int, int>("sender", LOCALHOST, std::move(perception_proxy_port), DEFAULT_TIMEOUT_MS, 10),
+			cadmium::dynamic::translate::make_dynamic_atomic_model<Supervisor_UDP_Input, TIME, TIME, unsigned short>("receiver", TIME("00:00:00:100"), static_cast<unsigned short>(port)));
+		port += 2;
+
+		// Landing points from the Supervisor to mavNRC, sent by an RUDP Output configured as the Vehicle configures it,
+		// so the proxy stands in for mavNRC on its port and forwards to the stand in receiver.
+		cout << profile.name << " mavNRC link" << endl;
+		unsigned short mavnrc_port = PORT_MAVNRC;
+		run_link<Packet_Builder_Landing_Point, RUDP_Output, MavNRC_Landing_Point_Input, MavNRC_Landing_Point_Input<TIME>::defs::o_lp>(profile, MAVNRC_RATE_HZ, PORT_MAVNRC, port,
+			cadmium::dynamic::translate::make_dynamic_atomic_model<RUDP_Output, TIME, const char *, const unsigned short, int, int>("sender", IPV4_MAVNRC, std::move(mavnrc_port), DEFAULT_TIMEOUT_MS, 10),
+			cadmium::dynamic::translate::make_dynamic_atomic_model<MavNRC_Landing_Point_Input, TIME, TIME, unsigned short>("receiver", TIME("00:00:00:100"), static_cast<unsigned short>(port)));
+		port += 2;
+
+		// Landing points over plain UDP, from a UDP Output to a UDP Input.
+		cout << profile.name << " UDP link" << endl;
+		unsigned short udp_proxy_port = port + 1;
+		run_link<Packet_Builder_Raw_Landing_Point, UDP_Output, UDP_Input_Landing_Point, UDP_Input_Landing_Point<TIME>::defs::o_message>(profile, UDP_RATE_HZ, udp_proxy_port, port,
+			cadmium::dynamic::translate::make_dynamic_atomic_model<UDP_Output, TIME, const char *, const unsigned short, bool>("sender", LOCALHOST, std::move(udp_proxy_port), false),
+			cadmium::dynamic::translate::make_dynamic_atomic_model<UDP_Input_Landing_Point, TIME, TIME, bool, std::string>("receiver", TIME("00:00:00:100"), false, std::to_string(port)));
+		port += 2;
+	}
+
+	return 0;
+}
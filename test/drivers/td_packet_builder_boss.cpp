@@ -78,7 +78,7 @@ int main() {
 
 		// This will connect our outputs from our input reader to the file
 		cadmium::dynamic::modeling::ICs ics_TestDriver = {
-				cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_boss_mission_update_t>::out, Packet_Builder_Boss<TIME>::defs::i_data>("ir_data", "packet_builder")
+				cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<shared_message_t<message_boss_mission_update_t>>::out, Packet_Builder_Boss<TIME>::defs::i_data>("ir_data", "packet_builder")
 		};
 
 		shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> TEST_DRIVER = make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
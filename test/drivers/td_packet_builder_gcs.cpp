@@ -1,5 +1,9 @@
 // C++ headers
+#include <cstdint>
+#include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <boost/filesystem.hpp>
 
 // Cadmium Simulator headers
@@ -21,6 +25,91 @@ using namespace cadmium;
 
 struct o_packet : public cadmium::out_port<std::vector<char>> {};
 
+/// Checks a condition of the packet tests, printing the failure to the console.
+bool check(bool condition, const std::string& description) {
+	if (!condition) {
+		std::cout << "Packet test failed: " << description << std::endl;
+	}
+	return condition;
+}
+
+/// Converts bytes written out by hand into a packet.
+std::vector<char> bytes(std::initializer_list<uint8_t> values) {
+	return std::vector<char>(values.begin(), values.end());
+}
+
+/// Frames a STATUSTEXT chunk as MAVLink 2 does, independently of the packet builder.
+std::vector<char> statustext(uint8_t seq, uint8_t severity, std::string_view text, uint16_t id, uint8_t chunk_seq) {
+	std::vector<uint8_t> payload(MAVLINK_MSG_ID_STATUSTEXT_LEN, 0);
+	payload[0] = severity;
+	std::copy(text.begin(), text.end(), payload.begin() + 1);
+	payload[51] = id & 0xFF;
+	payload[52] = id >> 8;
+	payload[53] = chunk_seq;
+	while (payload.size() > 1 && payload.back() == 0) {
+		payload.pop_back();
+	}
+
+	std::vector<uint8_t> packet = {MAVLINK_STX, (uint8_t)payload.size(), 0, 0, seq, MY_MAV_SYS_ID, MY_MAV_COMP_ID, MAVLINK_MSG_ID_STATUSTEXT, 0, 0};
+	packet.insert(packet.end(), payload.begin(), payload.end());
+	uint16_t checksum = 0xFFFF;
+	std::vector<uint8_t> checked(packet.begin() + 1, packet.end());
+	checked.push_back(MAVLINK_MSG_ID_STATUSTEXT_CRC);
+	for (uint8_t byte : checked) {
+		uint8_t tmp = byte ^ (uint8_t)(checksum & 0xFF);
+		tmp ^= (tmp << 4);
+		checksum = (checksum >> 8) ^ (tmp << 8) ^ (tmp << 3) ^ (tmp >> 4);
+	}
+	packet.push_back(checksum & 0xFF);
+	packet.push_back(checksum >> 8);
+	return std::vector<char>(packet.begin(), packet.end());
+}
+
+/// Sends an update through the packet builder the way the simulator does and returns the packets it outputs.
+std::vector<std::vector<char>> build(Packet_Builder_GCS<TIME>& builder, const message_update_gcs_t& update) {
+	typename cadmium::make_message_bags<typename Packet_Builder_GCS<TIME>::input_ports>::type bags;
+	cadmium::get_messages<typename Packet_Builder_GCS<TIME>::defs::i_data>(bags).push_back(update);
+	builder.external_transition(TIME(), std::move(bags));
+	auto packets = builder.output();
+	builder.internal_transition();
+	return cadmium::get_messages<typename Packet_Builder_GCS<TIME>::defs::o_packet>(packets);
+}
+
+/// Checks the bytes of the STATUSTEXT packets, which the simulation only logs.
+bool check_packets() {
+	bool passed = true;
+	Packet_Builder_GCS<TIME> builder;
+	std::string_view long_text = GCS_TEXTS[static_cast<size_t>(GCS_Text_E::AIRCRAFT_STATE_NOT_AVAILABLE)];
+	std::string_view full_text = "ThisIsATestMessageOfALongerLengthOfSize50ExtraChar";
+
+	// A short inline text is sent alone with id 0, and only its own bytes are read and sent.
+	passed &= check(build(builder, message_update_gcs_t("I", MAV_SEVERITY_ALERT)) == std::vector<std::vector<char>>{
+		bytes({0xFD, 0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 0xFD, 0x00, 0x00, 0x01, 'I', 0x30, 0xDD})
+	}, "a short inline text was not trimmed to its own bytes");
+
+	// An interned text longer than a chunk is split into chunks sharing the first id, with the last one null terminated.
+	passed &= check(long_text.size() > MAVLINK_MSG_STATUSTEXT_TEXT_LEN, "the long interned text fits in a single chunk");
+	passed &= check(build(builder, message_update_gcs_t(GCS_Text_E::AIRCRAFT_STATE_NOT_AVAILABLE, MAV_SEVERITY_ALERT)) == std::vector<std::vector<char>>{
+		statustext(1, MAV_SEVERITY_ALERT, long_text.substr(0, MAVLINK_MSG_STATUSTEXT_TEXT_LEN), 1, 0),
+		statustext(2, MAV_SEVERITY_ALERT, long_text.substr(MAVLINK_MSG_STATUSTEXT_TEXT_LEN), 1, 1)
+	}, "the long interned text was not split into chunks with id 1");
+	passed &= check(build(builder, message_update_gcs_t(GCS_Text_E::AIRCRAFT_STATE_NOT_AVAILABLE, MAV_SEVERITY_ALERT))[1] == bytes({
+		0xFD, 0x36, 0x00, 0x00, 0x04, 0x01, 0x01, 0xFD, 0x00, 0x00, 0x01,
+		'a', 's', ' ', 'n', 'o', 't', ' ', 's', 't', 'a', 'r', 't', 'e', 'd', '!',
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0x02, 0x00, 0x01, 0xB8, 0xC1
+	}), "the next long text did not get the next id");
+
+	// Texts that fit in a chunk keep id 0 between chunked texts, including an inline text that fills the chunk.
+	passed &= check(build(builder, message_update_gcs_t(GCS_Text_E::LOOP_ON_TIME, MAV_SEVERITY_INFO)) == std::vector<std::vector<char>>{
+		statustext(5, MAV_SEVERITY_INFO, GCS_TEXTS[static_cast<size_t>(GCS_Text_E::LOOP_ON_TIME)], 0, 0)
+	}, "a short interned text was not sent with id 0");
+	std::vector<std::vector<char>> full = build(builder, message_update_gcs_t(full_text, MAV_SEVERITY_INFO));
+	passed &= check(full == std::vector<std::vector<char>>{statustext(6, MAV_SEVERITY_INFO, full_text, 0, 0)} &&
+		full[0][1] == 1 + MAVLINK_MSG_STATUSTEXT_TEXT_LEN, "an inline text filling the chunk was not sent whole with id 0");
+	return passed;
+}
+
 int main() {
 	int test_set_enumeration = 0;
 
@@ -116,5 +205,7 @@ int main() {
 		test_set_enumeration++;
 	} while (boost::filesystem::exists(i_base_dir + std::to_string(test_set_enumeration)));
 
-	return 0;
+	bool passed = check_packets();
+	std::cout << (passed ? "All GCS packet tests passed" : "Some GCS packet tests failed") << std::endl;
+	return passed ? 0 : 1;
 }
@@ -0,0 +1,92 @@
+//C++ headers
+#include <chrono>
+#include <string>
+#include <iostream>
+
+//Cadmium Simulator headers
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+//Time class header
+#include <NDTime.hpp>
+
+//Messages structures
+#include "../../src/message_structures/message_landing_point_t.hpp"
+
+// Project information headers this is created by cmake at generation time!!!!
+#include "../../src/SupervisorConfig.hpp"
+
+//Coupled model headers
+#include "../../src/io_models/Packet_Builder.hpp"
+#include "../../src/io_models/Perception_Load_Generator.hpp"
+#include "../../src/io_models/RUDP_Output.hpp"
+#include "../../src/io_models/Supervisor_UDP_Input.hpp"
+
+using namespace cadmium;
+
+using hclock = std::chrono::high_resolution_clock;
+using TIME = NDTime;
+
+/// Rates in Hz that landing points are sent at, from the current perception system up to the next generation.
+const double RATES_HZ[] = {1.0, 10.0, 100.0, 1000.0, 10000.0};
+/// Spatial distributions of the landing points sent at each rate.
+const LP_Distribution_E DISTRIBUTIONS[] = {LP_Distribution_E::UNIFORM, LP_Distribution_E::GAUSSIAN, LP_Distribution_E::RING};
+/// Names of the spatial distributions.
+const char * DISTRIBUTION_NAMES[] = {"Uniform", "Gaussian", "Ring"};
+/// Port the ingress path listens on, each run uses the next port.
+const unsigned short BASE_PORT = 23100;
+
+/**
+* ==========================================================
+* MAIN METHOD
+* ==========================================================
+*/
+int main() {
+	unsigned short port = BASE_PORT;
+
+	for (int d = 0; d < 3; d++) {
+		for (double rate_hz : RATES_HZ) {
+			cout << DISTRIBUTION_NAMES[d] << " landing points" << endl;
+
+			// Landing points are spread 50m around the planned landing point of the supervisor test driver.
+			LP_Load_Pattern pattern(message_landing_point_t(0, 10, 45.3229263, -75.6646528, 300.0, 0.0), DISTRIBUTIONS[d], 50.0f, 1);
+			std::shared_ptr<cadmium::dynamic::modeling::model> perception_load_generator = cadmium::dynamic::translate::make_dynamic_atomic_model<Perception_Load_Generator, TIME, double, TIME, LP_Load_Pattern>("perception_load_generator", std::move(rate_hz), TIME("00:00:05:000"), std::move(pattern));
+			std::shared_ptr<cadmium::dynamic::modeling::model> pb_perception_lp = cadmium::dynamic::translate::make_dynamic_atomic_model<Packet_Builder_Perception_LP, TIME>("pb_perception_lp");
+			std::shared_ptr<cadmium::dynamic::modeling::model> rudp_perception = cadmium::dynamic::translate::make_dynamic_atomic_model<RUDP_Output, TIME, const char *, const unsigned short, int, int>("rudp_perception", "127.0.0.1", std::move(port), DEFAULT_TIMEOUT_MS, 10);
+			std::shared_ptr<cadmium::dynamic::modeling::model> supervisor_udp_input = cadmium::dynamic::translate::make_dynamic_atomic_model<Supervisor_UDP_Input, TIME, TIME, unsigned short>("supervisor_udp_input", TIME("00:00:00:100"), std::move(port));
+
+			cadmium::dynamic::modeling::Models submodels_TestDriver = {
+				perception_load_generator,
+				pb_perception_lp,
+				rudp_perception,
+				supervisor_udp_input
+			};
+
+			// The landing points coming out of the ingress path are fed back to the generator to be matched up.
+			cadmium::dynamic::modeling::ICs ics_TestDriver = {
+				cadmium::dynamic::translate::make_IC<Perception_Load_Generator<TIME>::defs::o_lp, Packet_Builder_Perception_LP<TIME>::defs::i_data>("perception_load_generator", "pb_perception_lp"),
+				cadmium::dynamic::translate::make_IC<Packet_Builder_Perception_LP<TIME>::defs::o_packet, RUDP_Output<TIME>::defs::i_message>("pb_perception_lp", "rudp_perception"),
+				cadmium::dynamic::translate::make_IC<Supervisor_UDP_Input<TIME>::defs::o_lp_recv, Perception_Load_Generator<TIME>::defs::i_lp_recv>("supervisor_udp_input", "perception_load_generator"),
+				cadmium::dynamic::translate::make_IC<Perception_Load_Generator<TIME>::defs::o_quit, Supervisor_UDP_Input<TIME>::defs::i_quit>("perception_load_generator", "supervisor_udp_input")
+			};
+
+			std::shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> test_driver = std::make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+				"test_driver", submodels_TestDriver, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics_TestDriver
+			);
+
+			// Logging is left out so that it does not slow down the ingress path.
+			auto start = hclock::now();
+
+			cadmium::dynamic::engine::runner<NDTime, cadmium::logger::not_logger> r(test_driver, { TIME("00:00:00:000:000") });
+			r.run_until_passivate();
+
+			auto elapsed = std::chrono::duration_cast<std::chrono::duration<double, std::ratio<1>>>(hclock::now() - start).count();
+			cout << "Simulation took: " << elapsed << " seconds" << endl;
+
+			port++;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+//C++ headers
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <boost/filesystem.hpp>
+
+// Project information headers this is created by cmake at generation time!!!!
+#include "../../src/SupervisorConfig.hpp"
+
+//Utility headers
+#include "../../src/scan_pattern.hpp"
+
+/// Checks a condition of a test set, printing the failure to the console.
+bool check(bool condition, int test_set, const std::string& description) {
+	if (!condition) {
+		std::cout << "Test set " << test_set << " failed: " << description << std::endl;
+	}
+	return condition;
+}
+
+/**
+* ==========================================================
+* MAIN METHOD
+* ==========================================================
+*/
+int main() {
+	int test_set_enumeration = 0;
+	bool passed = true;
+
+	const std::string i_base_dir = std::string(PROJECT_DIRECTORY) + std::string("/test/input_data/scan_pattern/");
+	const std::string o_base_dir = std::string(PROJECT_DIRECTORY) + std::string("/test/simulation_results/scan_pattern/");
+
+	do {
+		// Input Files
+		std::string input_dir = i_base_dir + std::to_string(test_set_enumeration);
+		std::string input_file_scan = input_dir + std::string("/scan.txt");
+		std::string input_file_plp = input_dir + std::string("/plp.txt");
+
+		// Output locations
+		std::string out_directory = o_base_dir + std::to_string(test_set_enumeration);
+		std::string out_legs_file = out_directory + std::string("/output_legs.txt");
+
+		if (!boost::filesystem::exists(input_file_scan) ||
+			!boost::filesystem::exists(input_file_plp)
+		) {
+			printf("One of the input files do not exist\n");
+			return 1;
+		}
+
+		// Create the output location
+		boost::filesystem::create_directories(out_directory.c_str()); // Creates if it does not exist. Does nothing if it does.
+
+		// The scan is given as: pattern swath_width max_radius max_velocity duration
+		int pattern;
+		float swath_width, max_radius, max_velocity;
+		double duration;
+		std::ifstream(input_file_scan) >> pattern >> swath_width >> max_radius >> max_velocity >> duration;
+		message_landing_point_t plp;
+		std::ifstream(input_file_plp) >> plp;
+
+		Scan_Pattern_Cache cache(static_cast<Scan_Pattern_E>(pattern), swath_width, max_radius, max_velocity);
+		const scan_pattern_t& scan = cache.scan(plp, duration);
+
+		std::ofstream out_legs(out_legs_file);
+		out_legs << "velocity " << scan.velocity << " duration " << Scan_Pattern_Cache::duration(scan) << std::endl;
+		for (const auto& leg : scan.legs) {
+			out_legs << std::setprecision(12) << leg.lat << " " << leg.lon << " " << leg.radius << " " << leg.length << std::endl;
+		}
+
+		// The pattern is flown in the scan time unless even its smallest size needs more than the maximum velocity.
+		passed &= check(!scan.legs.empty(), test_set_enumeration, "the pattern has no legs");
+		passed &= check(scan.velocity >= DEFAULT_ORBIT_VELOCITY - 1E-3f, test_set_enumeration, "the pattern is flown below the orbit velocity");
+		passed &= check(scan.velocity <= max_velocity + 1E-3f, test_set_enumeration, "the pattern is flown above the maximum velocity");
+		passed &= check(Scan_Pattern_Cache::duration(scan) <= duration + 1E-3 || scan.velocity >= max_velocity - 1E-3f,
+			test_set_enumeration, "the pattern is longer than the scan time");
+
+		// Asking again for the same planned landing point returns the cached pattern.
+		passed &= check(&cache.scan(plp, duration) == &scan && cache.size() == 1, test_set_enumeration, "the pattern was not cached");
+
+		// A different scan time or planned landing point gets a pattern of its own.
+		cache.scan(plp, duration * 2.0);
+		message_landing_point_t moved = plp;
+		moved.lat += 1E-4;
+		cache.scan(moved, duration);
+		passed &= check(cache.size() == 3, test_set_enumeration, "a pattern was shared between different scans");
+		cache.clear();
+		passed &= check(cache.size() == 0, test_set_enumeration, "the cache was not cleared");
+
+		test_set_enumeration++;
+	} while (boost::filesystem::exists(i_base_dir + std::to_string(test_set_enumeration)));
+
+	std::cout << (passed ? "All scan pattern tests passed" : "Some scan pattern tests failed") << std::endl;
+	return passed ? 0 : 1;
+}
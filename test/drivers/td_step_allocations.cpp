@@ -0,0 +1,121 @@
+// Count the heap allocations of the models, whether or not the build counts them.
+#ifndef SUPERVISOR_COUNT_ALLOCATIONS
+#define SUPERVISOR_COUNT_ALLOCATIONS
+#endif
+
+//C++ headers
+#include <iostream>
+#include <string>
+
+//Time class header
+#include <NDTime.hpp>
+
+//Atomic model headers
+#include "../../src/atomic_models/Handle_Waypoint.hpp"
+#include "../../src/atomic_models/LP_Manager.hpp"
+
+//Utility headers
+#include "../../src/metered_model.hpp"
+
+using TIME = NDTime;
+
+/// Number of steady state steps made by each model.
+const int STEPS = 1000;
+/// Number of waypoints in the route flown by Handle_Waypoint.
+const int ROUTE_LENGTH = STEPS + WPT_PREVIEW_LENGTH + 1;
+
+/// Prints the allocations made by the steps of a model, read from the metrics.
+void print_allocations(const std::string& model) {
+	std::cout << "Model: " << model << std::endl;
+	std::string metrics = Metrics::instance().prometheus();
+	size_t start = 0;
+	while ((start = metrics.find("allocations", start)) != std::string::npos) {
+		size_t line_start = metrics.rfind('\n', start) + 1;
+		size_t line_end = metrics.find('\n', start);
+		std::string line = metrics.substr(line_start, line_end - line_start);
+		if (line[0] != '#' && line.find("model=\"" + model + "\"") != std::string::npos) {
+			std::cout << "\t" << line << std::endl;
+		}
+		start = line_end;
+	}
+}
+
+/**
+* ==========================================================
+* MAIN METHOD
+* ==========================================================
+*/
+int main() {
+	// Handle_Waypoint flies a route, reaching one waypoint each step and sending the next active waypoint to the FCC.
+	{
+		using Model = Metered<Handle_Waypoint>::model<TIME>;
+		using defs = Handle_Waypoint<TIME>::defs;
+		Model model;
+
+		cadmium::make_message_bags<Model::input_ports>::type start;
+		cadmium::get_messages<defs::i_start_mission>(start).push_back(1);
+		model.external_transition(TIME(), start);
+
+		cadmium::make_message_bags<Model::input_ports>::type route;
+		for (int i = 0; i < ROUTE_LENGTH; i++) {
+			message_fcc_command_t waypoint;
+			waypoint.set_supervisor_status(Control_Mode_E::MAV_COMMAND);
+			cadmium::get_messages<defs::i_waypoint_update>(route).emplace_back(i, Waypoint_Update_E::SET, waypoint);
+		}
+		model.external_transition(TIME(), route);
+		model.output();
+		model.internal_transition();
+
+		for (int step = 0; step < STEPS; step++) {
+			cadmium::make_message_bags<Model::input_ports>::type reached;
+			cadmium::get_messages<defs::i_waypoint_update>(reached).emplace_back(step, Waypoint_Update_E::REACHED, message_fcc_command_t());
+			model.external_transition(TIME(), std::move(reached));
+			model.time_advance();
+			model.output();
+			model.internal_transition();
+			model.time_advance();
+		}
+	}
+	print_allocations("Handle_Waypoint");
+
+	// LP_Manager starts the LZ scan, then receives a landing point from the perception system each step,
+	// requests and receives the aircraft state, and notifies the new landing point before approaching it.
+	{
+		using Model = Metered<LP_Manager>::model<TIME>;
+		using defs = LP_Manager<TIME>::defs;
+		Model model(seconds_to_time<TIME>(LP_ACCEPT_TIMER), seconds_to_time<TIME>(ORBIT_TIMER), LP_Manager<TIME>::States::WAIT_LP_PLP);
+
+		cadmium::make_message_bags<Model::input_ports>::type plp;
+		cadmium::get_messages<defs::i_plp_ach>(plp).emplace_back(0, 10, 45.38331862894929, -75.69759707249413, 100.0, 45.8);
+		model.external_transition(TIME(), std::move(plp));
+		model.output();
+		model.internal_transition();
+
+		cadmium::make_message_bags<Model::input_ports>::type scan_state;
+		cadmium::get_messages<defs::i_aircraft_state>(scan_state).emplace_back(0.0, 45.38331862894929, -75.69759707249413, 30.0f, 100.0f, 45.8f, 0.0f);
+		model.external_transition(TIME(), std::move(scan_state));
+		model.output();
+		model.internal_transition();
+
+		for (int step = 0; step < STEPS; step++) {
+			cadmium::make_message_bags<Model::input_ports>::type lp;
+			cadmium::get_messages<defs::i_lp_recv>(lp).emplace_back(step + 1, 10, 45.38331862894929, -75.69759707249413, 100.0, 45.8);
+			model.external_transition(TIME(), std::move(lp));
+			model.time_advance();
+			model.output();
+			model.internal_transition();
+			model.time_advance();
+
+			cadmium::make_message_bags<Model::input_ports>::type aircraft_state;
+			cadmium::get_messages<defs::i_aircraft_state>(aircraft_state).emplace_back(0.0, 45.38331862894929, -75.69759707249413, 30.0f, 100.0f, 45.8f, 0.0f);
+			model.external_transition(TIME(), std::move(aircraft_state));
+			model.time_advance();
+			model.output();
+			model.internal_transition();
+			model.time_advance();
+		}
+	}
+	print_allocations("LP_Manager");
+
+	return 0;
+}
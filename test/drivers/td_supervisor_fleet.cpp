@@ -0,0 +1,148 @@
+//C++ headers
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+//Cadmium Simulator headers
+#include <cadmium/modeling/dynamic_model_translator.hpp>
+#include <cadmium/engine/pdevs_dynamic_runner.hpp>
+#include <cadmium/logger/common_loggers.hpp>
+
+//Time class header
+#include <NDTime.hpp>
+
+//Messages structures
+#include "../../src/message_structures/message_aircraft_state_t.hpp"
+#include "../../src/message_structures/message_landing_point_t.hpp"
+#include "../../src/message_structures/message_fcc_command_t.hpp"
+
+// Project information headers this is created by cmake at generation time!!!!
+#include "../../src/SupervisorConfig.hpp"
+#include "../../src/input_readers.hpp" // Input Reader Definitions.
+
+//Coupled model headers
+#include "../../src/coupled_models/Vehicle.hpp"
+
+//Aircraft state headers
+#include "../../src/aircraft_state_source.hpp"
+
+using namespace cadmium;
+using namespace cadmium::basic_models::pdevs;
+
+using hclock = std::chrono::high_resolution_clock;
+using TIME = NDTime;
+
+/// Largest number of vehicles in the fleet, the fleet size is doubled from one up to this.
+const int MAX_VEHICLES = 64;
+/// Offset between the ports of consecutive vehicles, as given in a fleet configuration.
+const unsigned short PORT_SPACING = 10;
+/// Simulated time each fleet is run for, which covers the inputs of the test set.
+const char * RUN_TIME = "00:01:00:000";
+
+/**
+ * 	\brief 	Function for building a vehicle driven by the input files of a test set of the supervisor test driver.
+ * 	\details	The vehicle is the one run by the fleet runner, with its own aircraft state source and ports. The
+ * 			inputs of the mission manager and perception system are read from the test set and given on the
+ * 			input ports of the vehicle, and the reliable packets it sends to MAVNRC are acknowledged by a
+ * 			Supervisor UDP Input listening on its MAVNRC port, so that no send waits for its retries.
+ * 	\param	name			string name of the vehicle.
+ * 	\param	input_dir		string directory of the input files.
+ * 	\param	port_offset		unsigned short offset added to every port of the vehicle.
+ * 	\param	state_source	std::shared_ptr<Aircraft_State_Source> source of the aircraft state of the vehicle.
+ * 	\return	Coupled model of the vehicle and its inputs.
+ */
+shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> make_vehicle(const string& name, const string& input_dir, unsigned short port_offset, std::shared_ptr<Aircraft_State_Source> state_source) {
+	string input_perception_status = input_dir + string("/perception_status.txt");
+	string input_start_supervisor = input_dir + string("/start_supervisor.txt");
+	string input_waypoint = input_dir + string("/waypoint.txt");
+	string input_LP_recv = input_dir + string("/LP_recv.txt");
+	string input_PLP_ach = input_dir + string("/PLP_ach.txt");
+
+	Vehicle vehicle_instance = Vehicle(port_offset, state_source);
+	shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> vehicle = make_shared<cadmium::dynamic::modeling::coupled<TIME>>("vehicle", vehicle_instance.submodels, vehicle_instance.iports, vehicle_instance.oports, vehicle_instance.eics, vehicle_instance.eocs, vehicle_instance.ics);
+
+	shared_ptr<cadmium::dynamic::modeling::model> mavnrc = cadmium::dynamic::translate::make_dynamic_atomic_model<Supervisor_UDP_Input, TIME, TIME, unsigned short>("mavnrc", TIME("00:00:00:100"), static_cast<unsigned short>(PORT_MAVNRC + port_offset));
+
+	shared_ptr<cadmium::dynamic::modeling::model> ir_perception_status = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Boolean, TIME, const char* >("ir_perception_status", input_perception_status.c_str());
+	shared_ptr<cadmium::dynamic::modeling::model> ir_start_supervisor = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Start_Supervisor, TIME, const char* >("ir_start_supervisor", input_start_supervisor.c_str());
+	shared_ptr<cadmium::dynamic::modeling::model> ir_waypoint = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Fcc_Command, TIME, const char* >("ir_waypoint", input_waypoint.c_str());
+	shared_ptr<cadmium::dynamic::modeling::model> ir_LP_recv = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Mavlink_Mission_Item, TIME, const char* >("ir_LP_recv", input_LP_recv.c_str());
+	shared_ptr<cadmium::dynamic::modeling::model> ir_PLP_ach = cadmium::dynamic::translate::make_dynamic_atomic_model<Input_Reader_Mavlink_Mission_Item, TIME, const char* >("ir_PLP_ach", input_PLP_ach.c_str());
+
+	cadmium::dynamic::modeling::Models submodels_vehicle = {
+			vehicle,
+			mavnrc,
+			ir_perception_status,
+			ir_start_supervisor,
+			ir_waypoint,
+			ir_LP_recv,
+			ir_PLP_ach
+	};
+
+	cadmium::dynamic::modeling::ICs ics_vehicle = {
+		cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<bool>::out, Vehicle::defs::i_perception_status>("ir_perception_status", "vehicle"),
+		cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_start_supervisor_t>::out, Vehicle::defs::i_start_supervisor>("ir_start_supervisor", "vehicle"),
+		cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_fcc_command_t>::out, Vehicle::defs::i_waypoint>("ir_waypoint", "vehicle"),
+		cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_landing_point_t>::out, Vehicle::defs::i_LP_recv>("ir_LP_recv", "vehicle"),
+		cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_landing_point_t>::out, Vehicle::defs::i_PLP_ach>("ir_PLP_ach", "vehicle")
+	};
+
+	return make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+		name, submodels_vehicle, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, ics_vehicle
+	);
+}
+
+/**
+* ==========================================================
+* MAIN METHOD
+* ==========================================================
+*/
+int main() {
+	// Every vehicle flies the first test set of the supervisor test driver.
+	const string input_dir = string(PROJECT_DIRECTORY) + string("/test/input_data/supervisor_test_driver/0");
+
+	if (!boost::filesystem::exists(input_dir)) {
+		printf("The input directory does not exist\n");
+		return 1;
+	}
+
+	// Each aircraft starts from the first aircraft state of the test set, a little further north than the one before it.
+	message_aircraft_state_t initial_state;
+	string first_time;
+	if (!(std::ifstream(input_dir + string("/aircraft_state.txt")) >> first_time >> initial_state)) {
+		printf("The aircraft state could not be read\n");
+		return 1;
+	}
+
+	for (int vehicle_count = 1; vehicle_count <= MAX_VEHICLES; vehicle_count *= 2) {
+		auto build_start = hclock::now();
+		cadmium::dynamic::modeling::Models vehicles;
+		for (int i = 0; i < vehicle_count; i++) {
+			auto state_source = make_shared<Stored_State_Source>();
+			message_aircraft_state_t aircraft_state = initial_state;
+			aircraft_state.lat += i * 1E-3;
+			state_source->set(aircraft_state);
+			vehicles.push_back(make_vehicle("vehicle_" + to_string(i), input_dir, static_cast<unsigned short>(i * PORT_SPACING), state_source));
+		}
+
+		shared_ptr<cadmium::dynamic::modeling::coupled<TIME>> fleet = make_shared<cadmium::dynamic::modeling::coupled<TIME>>(
+			"fleet", vehicles, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::Ports{}, cadmium::dynamic::modeling::EICs{}, cadmium::dynamic::modeling::EOCs{}, cadmium::dynamic::modeling::ICs{}
+		);
+
+		// Logging is left out so that only the simulation of the fleet is timed.
+		// The runner is not real time, so the fleet is run as fast as it can be simulated.
+		cadmium::dynamic::engine::runner<NDTime, cadmium::logger::not_logger> r(fleet, { 0 });
+		auto start = hclock::now();
+		// The input models of the vehicles keep polling, so the fleet never passivates.
+		r.run_until(TIME(RUN_TIME));
+
+		auto build = std::chrono::duration_cast<std::chrono::duration<double, std::ratio<1>>>(start - build_start).count();
+		auto elapsed = std::chrono::duration_cast<std::chrono::duration<double, std::ratio<1>>>(hclock::now() - start).count();
+		cout << "Vehicles: " << vehicle_count << " Building took: " << build << " seconds, Simulation took: " << elapsed
+			 << " seconds (" << elapsed / vehicle_count << " seconds per vehicle)" << endl;
+	}
+
+	return 0;
+}
@@ -11,6 +11,7 @@
 
 //Messages structures
 #include "../../src/message_structures/message_boss_mission_update_t.hpp"
+#include "../../src/message_structures/shared_message_t.hpp"
 
 // Project information headers this is created by cmake at generation time!!!!
 #include "../../src/SupervisorConfig.hpp"
@@ -79,7 +80,7 @@ int main() {
 
 		// This will connect our outputs from our input reader to the file
 		cadmium::dynamic::modeling::ICs ics_TestDriver = {
-			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<message_boss_mission_update_t>::out, Packet_Builder_Boss<TIME>::defs::i_data>("ir_message", "packet_builder"),
+			cadmium::dynamic::translate::make_IC<cadmium::basic_models::pdevs::iestream_input_defs<shared_message_t<message_boss_mission_update_t>>::out, Packet_Builder_Boss<TIME>::defs::i_data>("ir_message", "packet_builder"),
 			cadmium::dynamic::translate::make_IC<Packet_Builder_Boss<TIME>::defs::o_packet, UDP_Output<TIME>::defs::i_message>("packet_builder", "udp_output")
 		};
 